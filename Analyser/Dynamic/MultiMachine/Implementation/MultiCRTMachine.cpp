@@ -8,9 +8,6 @@
 
 #include "MultiCRTMachine.hpp"
 
-#include <condition_variable>
-#include <mutex>
-
 using namespace Analyser::Dynamic;
 
 MultiCRTMachine::MultiCRTMachine(const std::vector<std::unique_ptr<::Machine::DynamicMachine>> &machines, std::recursive_mutex &machines_mutex) :
@@ -20,29 +17,24 @@ MultiCRTMachine::MultiCRTMachine(const std::vector<std::unique_ptr<::Machine::Dy
 
 void MultiCRTMachine::perform_parallel(const std::function<void(::CRTMachine::Machine *)> &function) {
 	// Apply a blunt force parallelisation of the machines; each run_for is dispatched
-	// to a separate queue and this queue will block until all are done.
-	volatile std::size_t outstanding_machines;
-	std::condition_variable condition;
-	std::mutex mutex;
+	// to a separate queue and this queue will block until all are done. Flushing, rather
+	// than waiting upon a signal from each queue, allows any queue that no thread has yet
+	// started upon to be performed on this one.
 	{
 		std::lock_guard<decltype(machines_mutex_)> machines_lock(machines_mutex_);
-		std::lock_guard<std::mutex> lock(mutex);
-		outstanding_machines = machines_.size();
-
 		for(std::size_t index = 0; index < machines_.size(); ++index) {
+			if(halted_machines_.find(machines_[index].get()) != halted_machines_.end()) continue;
+
 			CRTMachine::Machine *crt_machine = machines_[index]->crt_machine();
-			queues_[index].enqueue([&mutex, &condition, crt_machine, function, &outstanding_machines]() {
+			queues_[index].enqueue([crt_machine, function]() {
 				if(crt_machine) function(crt_machine);
-
-				std::lock_guard<std::mutex> lock(mutex);
-				outstanding_machines--;
-				condition.notify_all();
 			});
 		}
 	}
 
-	std::unique_lock<std::mutex> lock(mutex);
-	condition.wait(lock, [&outstanding_machines] { return !outstanding_machines; });
+	for(auto &queue: queues_) {
+		queue.flush();
+	}
 }
 
 void MultiCRTMachine::perform_serial(const std::function<void (::CRTMachine::Machine *)> &function) {
@@ -72,6 +64,15 @@ void MultiCRTMachine::run_for(Time::Seconds duration) {
 	if(delegate_) delegate_->multi_crt_did_run_machines();
 }
 
+void MultiCRTMachine::set_is_running(::Machine::DynamicMachine *machine, bool is_running) {
+	std::lock_guard<decltype(machines_mutex_)> machines_lock(machines_mutex_);
+	if(is_running) {
+		halted_machines_.erase(machine);
+	} else {
+		halted_machines_.insert(machine);
+	}
+}
+
 void MultiCRTMachine::did_change_machine_order() {
 	if(scan_target_) scan_target_->will_change_owner();
 
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <mutex>
+#include <set>
 #include <vector>
 
 namespace Analyser {
@@ -40,6 +41,12 @@ class MultiCRTMachine: public CRTMachine::Machine {
 		*/
 		void did_change_machine_order();
 
+		/*!
+			Sets whether @c machine, which must be one of those supplied at construction,
+			should continue to be run.
+		*/
+		void set_is_running(::Machine::DynamicMachine *machine, bool is_running);
+
 		/*!
 			Provides a mechanism by which a delegate can be informed each time a call to run_for has
 			been received.
@@ -65,9 +72,10 @@ class MultiCRTMachine: public CRTMachine::Machine {
 		MultiSpeaker *speaker_ = nullptr;
 		Delegate *delegate_ = nullptr;
 		Outputs::Display::ScanTarget *scan_target_ = nullptr;
+		std::set<::Machine::DynamicMachine *> halted_machines_;
 
 		/*!
-			Performs a parallel for operation across all machines, performing the supplied
+			Performs a parallel for operation across all running machines, performing the supplied
 			function on each and returning only once all applications have completed.
 
 			No guarantees are extended as to which thread operations will occur on.
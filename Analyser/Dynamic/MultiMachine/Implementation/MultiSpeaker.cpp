@@ -23,9 +23,9 @@ MultiSpeaker *MultiSpeaker::create(const std::vector<std::unique_ptr<::Machine::
 
 MultiSpeaker::MultiSpeaker(const std::vector<Outputs::Speaker::Speaker *> &speakers) :
 	speakers_(speakers), front_speaker_(speakers.front()) {
-	for(const auto &speaker: speakers_) {
-		speaker->set_delegate(this);
-	}
+	// Only the front speaker is given a delegate; the others therefore skip
+	// their filtering and output entirely.
+	front_speaker_->set_delegate(this);
 }
 
 float MultiSpeaker::get_ideal_clock_rate_in_range(float minimum, float maximum) {
@@ -68,7 +68,9 @@ void MultiSpeaker::speaker_did_change_input_clock(Speaker *speaker) {
 void MultiSpeaker::set_new_front_machine(::Machine::DynamicMachine *machine) {
 	{
 		std::lock_guard<std::mutex> lock_guard(front_speaker_mutex_);
+		if(front_speaker_) front_speaker_->set_delegate(nullptr);
 		front_speaker_ = machine->crt_machine()->get_speaker();
+		if(front_speaker_) front_speaker_->set_delegate(this);
 	}
 	if(delegate_) {
 		delegate_->speaker_did_change_input_clock(this);
@@ -24,7 +24,8 @@ namespace Dynamic {
 	transparently to connect a single caller to multiple destinations.
 
 	Makes a static internal copy of the list of machines; expects the owner to keep it
-	abreast of the current frontmost machine.
+	abreast of the current frontmost machine. Only the frontmost machine's speaker
+	is connected, so that the others do no audio work.
 */
 class MultiSpeaker: public Outputs::Speaker::Speaker, Outputs::Speaker::Speaker::Delegate {
 	public:
@@ -88,9 +88,14 @@ void MultiMachine::multi_crt_did_run_machines() {
 	LOGNBR(std::endl);
 #endif
 
+	// Sort by confidence, keeping eliminated machines at the back so that none can return to the front.
 	DynamicMachine *front = machines_.front().get();
 	std::stable_sort(machines_.begin(), machines_.end(),
-		[] (const std::unique_ptr<DynamicMachine> &lhs, const std::unique_ptr<DynamicMachine> &rhs){
+		[this] (const std::unique_ptr<DynamicMachine> &lhs, const std::unique_ptr<DynamicMachine> &rhs){
+			const bool lhs_eliminated = candidates_[lhs.get()].is_eliminated;
+			const bool rhs_eliminated = candidates_[rhs.get()].is_eliminated;
+			if(lhs_eliminated != rhs_eliminated) return rhs_eliminated;
+
 			CRTMachine::Machine *lhs_crt = lhs->crt_machine();
 			CRTMachine::Machine *rhs_crt = rhs->crt_machine();
 			return lhs_crt->get_confidence() > rhs_crt->get_confidence();
@@ -100,11 +105,43 @@ void MultiMachine::multi_crt_did_run_machines() {
 		crt_machine_.did_change_machine_order();
 	}
 
-	if(would_collapse(machines_)) {
+	eliminate_trailing_machines();
+
+	if(would_collapse(machines_) || candidates_[machines_[1].get()].is_eliminated) {
 		pick_first();
 	}
 }
 
+void MultiMachine::set_elimination_policy(const EliminationPolicy &policy) {
+	std::lock_guard<decltype(machines_mutex_)> machines_lock(machines_mutex_);
+	elimination_policy_ = policy;
+}
+
+void MultiMachine::eliminate_trailing_machines() {
+	const float leading_confidence = machines_.front()->crt_machine()->get_confidence();
+
+	for(auto machine = machines_.begin() + 1; machine != machines_.end(); ++machine) {
+		Candidate &candidate = candidates_[machine->get()];
+		if(candidate.is_eliminated) continue;
+
+		const float confidence = (*machine)->crt_machine()->get_confidence();
+		const float gap = leading_confidence - confidence;
+
+		if(confidence < elimination_policy_.trailing_ratio * leading_confidence && gap >= candidate.previous_gap) {
+			++candidate.trailing_runs;
+		} else {
+			candidate.trailing_runs = 0;
+		}
+		candidate.previous_gap = gap;
+
+		if(	confidence < elimination_policy_.minimum_confidence ||
+			candidate.trailing_runs >= elimination_policy_.trailing_runs) {
+			candidate.is_eliminated = true;
+			crt_machine_.set_is_running(machine->get(), false);
+		}
+	}
+}
+
 void MultiMachine::pick_first() {
 	has_picked_ = true;
 //	machines_.erase(machines_.begin() + 1, machines_.end());
@@ -17,6 +17,7 @@
 #include "Implementation/MultiKeyboardMachine.hpp"
 #include "Implementation/MultiMediaTarget.hpp"
 
+#include <map>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -36,7 +37,8 @@ namespace Dynamic {
 	confidence.
 
 	If confidence for any machine becomes disproportionately low compared to
-	the others in the set, that machine stops running.
+	the others in the set, that machine stops running; see EliminationPolicy.
+	Only the frontmost machine is connected to video and audio outputs.
 */
 class MultiMachine: public ::Machine::DynamicMachine, public MultiCRTMachine::Delegate {
 	public:
@@ -50,6 +52,25 @@ class MultiMachine: public ::Machine::DynamicMachine, public MultiCRTMachine::De
 		static bool would_collapse(const std::vector<std::unique_ptr<DynamicMachine>> &machines);
 		MultiMachine(std::vector<std::unique_ptr<DynamicMachine>> &&machines);
 
+		/*!
+			Describes the circumstances under which a machine other than the frontmost
+			will be eliminated, i.e. will no longer be run.
+
+			A machine is considered to be trailing if its confidence is less than
+			@c trailing_ratio times that of the frontmost machine, and it isn't closing
+			that gap. It is eliminated once it has trailed for @c trailing_runs consecutive
+			calls to run_for, or immediately if its confidence drops below @c minimum_confidence.
+
+			Once all other machines have been eliminated, the frontmost is picked.
+		*/
+		struct EliminationPolicy {
+			float trailing_ratio = 0.75f;
+			int trailing_runs = 3;
+			float minimum_confidence = 0.01f;
+		};
+		/// Sets the policy by which candidate machines will be eliminated.
+		void set_elimination_policy(const EliminationPolicy &policy);
+
 		Activity::Source *activity_source() override;
 		Configurable::Device *configurable_device() override;
 		CRTMachine::Machine *crt_machine() override;
@@ -73,6 +94,15 @@ class MultiMachine: public ::Machine::DynamicMachine, public MultiCRTMachine::De
 
 		void pick_first();
 		bool has_picked_ = false;
+
+		void eliminate_trailing_machines();
+		EliminationPolicy elimination_policy_;
+		struct Candidate {
+			int trailing_runs = 0;
+			float previous_gap = 0.0f;
+			bool is_eliminated = false;
+		};
+		std::map<DynamicMachine *, Candidate> candidates_;
 };
 
 }
@@ -12,8 +12,47 @@
 
 #include "../Disassembler/6502.hpp"
 
+#include <atomic>
+
 using namespace Analyser::Static::Atari;
 
+namespace {
+
+/// Provides a disassembly workspace per thread, so that bulk analysis doesn't reallocate it per cartridge.
+Analyser::Static::MOS6502::FlatDisassembly &Workspace() {
+	static thread_local Analyser::Static::MOS6502::FlatDisassembly workspace;
+	return workspace;
+}
+
+/*!
+	@returns @c true if any 4kb bank of @c segment that precedes its final 4kb stores to $3f when disassembled from
+	that bank's own vectors. Tigervision-esque cartridges need not keep their paging code in the final bank.
+*/
+bool EarlierBankStoresTo3F(const Storage::Cartridge::Cartridge::Segment &segment, const std::function<std::size_t(uint16_t address)> &address_mapper) {
+	const std::size_t bank_count = (segment.data.size() - 4096) / 4096;
+
+	std::vector<std::vector<uint8_t>> banks;
+	std::vector<std::vector<uint16_t>> entry_points;
+	for(std::size_t bank = 0; bank < bank_count; ++bank) {
+		const auto start = segment.data.begin() + static_cast<std::ptrdiff_t>(bank * 4096);
+		banks.emplace_back(start, start + 4096);
+
+		const std::vector<uint8_t> &data = banks.back();
+		entry_points.push_back({
+			static_cast<uint16_t>(data[4092] | (data[4093] << 8)),
+			static_cast<uint16_t>(data[4094] | (data[4095] << 8))
+		});
+	}
+
+	std::atomic<bool> stores_to_3f(false);
+	Analyser::Static::MOS6502::DisassembleBanks(banks, address_mapper, entry_points, [&stores_to_3f] (std::size_t, const Analyser::Static::MOS6502::FlatDisassembly &disassembly) {
+		if(disassembly.external_stores.contains(0x3f)) stores_to_3f = true;
+	});
+	return stores_to_3f;
+}
+
+}
+
 static void DeterminePagingFor2kCartridge(Analyser::Static::Atari::Target &target, const Storage::Cartridge::Cartridge::Segment &segment) {
 	// if this is a 2kb cartridge then it's definitely either unpaged or a CommaVid
 	uint16_t entry_address, break_address;
@@ -28,17 +67,18 @@ static void DeterminePagingFor2kCartridge(Analyser::Static::Atari::Target &targe
 		address &= 0x1fff;
 		return static_cast<std::size_t>(address - 0x1800);
 	};
-	Analyser::Static::MOS6502::Disassembly high_location_disassembly =
-		Analyser::Static::MOS6502::Disassemble(segment.data, high_location_mapper, {entry_address, break_address});
+	Analyser::Static::MOS6502::FlatDisassembly &high_location_disassembly = Workspace();
+	Analyser::Static::MOS6502::Disassemble(high_location_disassembly, segment.data, high_location_mapper, {entry_address, break_address});
 
 	// assume that any kind of store that looks likely to be intended for large amounts of memory implies
 	// large amounts of memory
 	bool has_wide_area_store = false;
-	for(std::map<uint16_t, Analyser::Static::MOS6502::Instruction>::value_type &entry : high_location_disassembly.instructions_by_address) {
-		if(entry.second.operation == Analyser::Static::MOS6502::Instruction::STA) {
-			has_wide_area_store |= entry.second.addressing_mode == Analyser::Static::MOS6502::Instruction::Indirect;
-			has_wide_area_store |= entry.second.addressing_mode == Analyser::Static::MOS6502::Instruction::IndexedIndirectX;
-			has_wide_area_store |= entry.second.addressing_mode == Analyser::Static::MOS6502::Instruction::IndirectIndexedY;
+	for(uint16_t address : high_location_disassembly.instruction_addresses) {
+		const Analyser::Static::MOS6502::Instruction &instruction = high_location_disassembly.instructions_by_address[address];
+		if(instruction.operation == Analyser::Static::MOS6502::Instruction::STA) {
+			has_wide_area_store |= instruction.addressing_mode == Analyser::Static::MOS6502::Instruction::Indirect;
+			has_wide_area_store |= instruction.addressing_mode == Analyser::Static::MOS6502::Instruction::IndexedIndirectX;
+			has_wide_area_store |= instruction.addressing_mode == Analyser::Static::MOS6502::Instruction::IndirectIndexedY;
 
 			if(has_wide_area_store) break;
 		}
@@ -51,7 +91,7 @@ static void DeterminePagingFor2kCartridge(Analyser::Static::Atari::Target &targe
 	if(has_wide_area_store) target.paging_model = Analyser::Static::Atari::Target::PagingModel::CommaVid;
 }
 
-static void DeterminePagingFor8kCartridge(Analyser::Static::Atari::Target &target, const Storage::Cartridge::Cartridge::Segment &segment, const Analyser::Static::MOS6502::Disassembly &disassembly) {
+static void DeterminePagingFor8kCartridge(Analyser::Static::Atari::Target &target, const Storage::Cartridge::Cartridge::Segment &segment, const Analyser::Static::MOS6502::FlatDisassembly &disassembly) {
 	// Activision stack titles have their vectors at the top of the low 4k, not the top, and
 	// always list 0xf000 as both vectors; they do not repeat them, and, inexplicably, they all
 	// issue an SEI as their first instruction (maybe some sort of relic of the development environment?)
@@ -67,7 +107,7 @@ static void DeterminePagingFor8kCartridge(Analyser::Static::Atari::Target &targe
 	// make an assumption that this is the Atari paging model
 	target.paging_model = Analyser::Static::Atari::Target::PagingModel::Atari8k;
 
-	std::set<uint16_t> internal_accesses;
+	Analyser::Static::MOS6502::AddressSet internal_accesses;
 	internal_accesses.insert(disassembly.internal_stores.begin(), disassembly.internal_stores.end());
 	internal_accesses.insert(disassembly.internal_modifies.begin(), disassembly.internal_modifies.end());
 	internal_accesses.insert(disassembly.internal_loads.begin(), disassembly.internal_loads.end());
@@ -89,11 +129,11 @@ static void DeterminePagingFor8kCartridge(Analyser::Static::Atari::Target &targe
 	else if(tigervision_access_count > atari_access_count) target.paging_model = Analyser::Static::Atari::Target::PagingModel::Tigervision;
 }
 
-static void DeterminePagingFor16kCartridge(Analyser::Static::Atari::Target &target, const Storage::Cartridge::Cartridge::Segment &segment, const Analyser::Static::MOS6502::Disassembly &disassembly) {
+static void DeterminePagingFor16kCartridge(Analyser::Static::Atari::Target &target, const Storage::Cartridge::Cartridge::Segment &segment, const Analyser::Static::MOS6502::FlatDisassembly &disassembly) {
 	// make an assumption that this is the Atari paging model
 	target.paging_model = Analyser::Static::Atari::Target::PagingModel::Atari16k;
 
-	std::set<uint16_t> internal_accesses;
+	Analyser::Static::MOS6502::AddressSet internal_accesses;
 	internal_accesses.insert(disassembly.internal_stores.begin(), disassembly.internal_stores.end());
 	internal_accesses.insert(disassembly.internal_modifies.begin(), disassembly.internal_modifies.end());
 	internal_accesses.insert(disassembly.internal_loads.begin(), disassembly.internal_loads.end());
@@ -109,10 +149,10 @@ static void DeterminePagingFor16kCartridge(Analyser::Static::Atari::Target &targ
 	if(mnetwork_access_count > atari_access_count) target.paging_model = Analyser::Static::Atari::Target::PagingModel::MNetwork;
 }
 
-static void DeterminePagingFor64kCartridge(Analyser::Static::Atari::Target &target, const Storage::Cartridge::Cartridge::Segment &segment, const Analyser::Static::MOS6502::Disassembly &disassembly) {
+static void DeterminePagingFor64kCartridge(Analyser::Static::Atari::Target &target, const Storage::Cartridge::Cartridge::Segment &segment, const Analyser::Static::MOS6502::FlatDisassembly &disassembly) {
 	// make an assumption that this is a Tigervision if there is a write to 3F
 	target.paging_model =
-		(disassembly.external_stores.find(0x3f) != disassembly.external_stores.end()) ?
+		disassembly.external_stores.contains(0x3f) ?
 			Analyser::Static::Atari::Target::PagingModel::Tigervision : Analyser::Static::Atari::Target::PagingModel::MegaBoy;
 }
 
@@ -133,7 +173,8 @@ static void DeterminePagingForCartridge(Analyser::Static::Atari::Target &target,
 	};
 
 	std::vector<uint8_t> final_4k(segment.data.end() - 4096, segment.data.end());
-	Analyser::Static::MOS6502::Disassembly disassembly = Analyser::Static::MOS6502::Disassemble(final_4k, address_mapper, {entry_address, break_address});
+	Analyser::Static::MOS6502::FlatDisassembly &disassembly = Workspace();
+	Analyser::Static::MOS6502::Disassemble(disassembly, final_4k, address_mapper, {entry_address, break_address});
 
 	switch(segment.data.size()) {
 		case 8192:
@@ -175,7 +216,9 @@ static void DeterminePagingForCartridge(Analyser::Static::Atari::Target &target,
 
 	// check for a Tigervision or Tigervision-esque scheme
 	if(target.paging_model == Analyser::Static::Atari::Target::PagingModel::None && segment.data.size() > 4096) {
-		bool looks_like_tigervision = disassembly.external_stores.find(0x3f) != disassembly.external_stores.end();
+		bool looks_like_tigervision =
+			disassembly.external_stores.contains(0x3f) ||
+			EarlierBankStoresTo3F(segment, address_mapper);
 		if(looks_like_tigervision) target.paging_model = Analyser::Static::Atari::Target::PagingModel::Tigervision;
 	}
 }
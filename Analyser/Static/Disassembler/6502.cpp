@@ -10,14 +10,27 @@
 
 #include "Kernel.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 using namespace Analyser::Static::MOS6502;
 namespace  {
 
-using PartialDisassembly = Analyser::Static::Disassembly::PartialDisassembly<Disassembly, uint16_t>;
+template <typename D> using PartialDisassembly = Analyser::Static::Disassembly::PartialDisassembly<D, uint16_t>;
+
+void RecordInstruction(Disassembly &disassembly, const Instruction &instruction) {
+	disassembly.instructions_by_address[instruction.address] = instruction;
+}
+
+void RecordInstruction(FlatDisassembly &disassembly, const Instruction &instruction) {
+	disassembly.instructions_by_address[instruction.address] = instruction;
+	disassembly.instruction_addresses.insert(instruction.address);
+}
 
 struct MOS6502Disassembler {
 
-static void AddToDisassembly(PartialDisassembly &disassembly, const std::vector<uint8_t> &memory, const std::function<std::size_t(uint16_t)> &address_mapper, uint16_t entry_point) {
+template <typename D> static void AddToDisassembly(PartialDisassembly<D> &disassembly, const std::vector<uint8_t> &memory, const std::function<std::size_t(uint16_t)> &address_mapper, uint16_t entry_point) {
 	disassembly.disassembly.internal_calls.insert(entry_point);
 	uint16_t address = entry_point;
 	while(true) {
@@ -256,7 +269,7 @@ static void AddToDisassembly(PartialDisassembly &disassembly, const std::vector<
 		}
 
 		// store the instruction away
-		disassembly.disassembly.instructions_by_address[instruction.address] = instruction;
+		RecordInstruction(disassembly.disassembly, instruction);
 
 		// TODO: something wider-ranging than this
 		if(instruction.addressing_mode == Instruction::Absolute || instruction.addressing_mode == Instruction::ZeroPage) {
@@ -318,3 +331,53 @@ Disassembly Analyser::Static::MOS6502::Disassemble(
 	std::vector<uint16_t> entry_points) {
 	return Analyser::Static::Disassembly::Disassemble<Disassembly, uint16_t, MOS6502Disassembler>(memory, address_mapper, entry_points);
 }
+
+void FlatDisassembly::clear() {
+	instruction_addresses.clear();
+	outward_calls.clear();
+	internal_calls.clear();
+	external_stores.clear();
+	external_loads.clear();
+	external_modifies.clear();
+	internal_stores.clear();
+	internal_loads.clear();
+	internal_modifies.clear();
+}
+
+void Analyser::Static::MOS6502::Disassemble(
+	FlatDisassembly &disassembly,
+	const std::vector<uint8_t> &memory,
+	const std::function<std::size_t(uint16_t)> &address_mapper,
+	std::vector<uint16_t> entry_points) {
+	disassembly.clear();
+	Analyser::Static::Disassembly::DisassembleInto<FlatDisassembly, uint16_t, MOS6502Disassembler>(disassembly, memory, address_mapper, std::move(entry_points));
+}
+
+void Analyser::Static::MOS6502::DisassembleBanks(
+	const std::vector<std::vector<uint8_t>> &banks,
+	const std::function<std::size_t(uint16_t)> &address_mapper,
+	const std::vector<std::vector<uint16_t>> &entry_points,
+	const std::function<void(std::size_t bank, const FlatDisassembly &disassembly)> &receiver) {
+	// Banks are handed out one at a time to whichever thread next becomes free.
+	std::atomic<std::size_t> next_bank(0);
+	const auto disassemble_banks = [&] {
+		FlatDisassembly disassembly;
+		while(true) {
+			const std::size_t bank = next_bank++;
+			if(bank >= banks.size()) return;
+			Disassemble(disassembly, banks[bank], address_mapper, entry_points[bank]);
+			receiver(bank, disassembly);
+		}
+	};
+
+	// Use the calling thread plus as many others as there are spare processors and banks to occupy them.
+	const std::size_t thread_count = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), banks.size());
+	std::vector<std::thread> threads;
+	for(std::size_t c = 1; c < thread_count; ++c) {
+		threads.emplace_back(disassemble_banks);
+	}
+	disassemble_banks();
+	for(auto &thread: threads) {
+		thread.join();
+	}
+}
@@ -9,6 +9,7 @@
 #ifndef StaticAnalyser_Disassembler_6502_hpp
 #define StaticAnalyser_Disassembler_6502_hpp
 
+#include <bitset>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -85,6 +86,74 @@ struct Disassembly {
 	std::set<uint16_t> internal_stores, internal_loads, internal_modifies;
 };
 
+/*!
+	A set of 16-bit addresses with constant-time insertion and membership tests. Iteration
+	is in order of insertion, and clearing costs time proportional to the number of members
+	rather than to the size of the address space.
+*/
+class AddressSet {
+	public:
+		/*! Adds @c address to the set; returns @c true if it was not already a member. */
+		bool insert(uint16_t address) {
+			if(members_[address]) return false;
+			members_[address] = true;
+			addresses_.push_back(address);
+			return true;
+		}
+
+		template <typename Iterator> void insert(Iterator begin, Iterator end) {
+			while(begin != end) {
+				insert(*begin);
+				++begin;
+			}
+		}
+
+		bool contains(uint16_t address) const {
+			return members_[address];
+		}
+
+		void clear() {
+			for(auto address: addresses_) members_[address] = false;
+			addresses_.clear();
+		}
+
+		std::size_t size() const				{	return addresses_.size();	}
+		bool empty() const						{	return addresses_.empty();	}
+		std::vector<uint16_t>::const_iterator begin() const	{	return addresses_.begin();	}
+		std::vector<uint16_t>::const_iterator end() const	{	return addresses_.end();	}
+
+	private:
+		std::bitset<65536> members_;
+		std::vector<uint16_t> addresses_;
+};
+
+/*!
+	Represents the disassembled form of a program exactly as per Disassembly, but using storage that
+	spans the whole 16-bit address space rather than trees.
+
+	A FlatDisassembly is intended to be used as a workspace: reusing one across successive calls to
+	Disassemble avoids all further allocation once it has grown to fit.
+*/
+struct FlatDisassembly {
+	/*! All instructions found, indexed by address; only those at addresses within @c instruction_addresses are meaningful. */
+	std::vector<Instruction> instructions_by_address = std::vector<Instruction>(65536);
+	/*! The addresses of all instructions found, in the order they were found. */
+	AddressSet instruction_addresses;
+
+	/*! Each of the following is as per its namesake in Disassembly. */
+	AddressSet outward_calls;
+	AddressSet internal_calls;
+	AddressSet external_stores, external_loads, external_modifies;
+	AddressSet internal_stores, internal_loads, internal_modifies;
+
+	/*! Empties this disassembly, in time proportional to the amount of content it had. */
+	void clear();
+};
+
+inline bool HasInstructionAt(const FlatDisassembly &disassembly, uint16_t address) {
+	return disassembly.instruction_addresses.contains(address);
+}
+
 /*!
 	Disassembles the data provided as @c memory, mapping it into the 6502's full address range via the @c address_mapper,
 	starting disassembly from each of the @c entry_points.
@@ -94,6 +163,31 @@ Disassembly Disassemble(
 	const std::function<std::size_t(uint16_t)> &address_mapper,
 	std::vector<uint16_t> entry_points);
 
+/*!
+	Acts as per the version of Disassemble above but clears and reuses @c disassembly rather than returning a newly-built result.
+*/
+void Disassemble(
+	FlatDisassembly &disassembly,
+	const std::vector<uint8_t> &memory,
+	const std::function<std::size_t(uint16_t)> &address_mapper,
+	std::vector<uint16_t> entry_points);
+
+/*!
+	Disassembles each of @c banks independently, spreading the work across the available processors.
+
+	Each bank is mapped via @c address_mapper and disassembled from the entry points at the same index within
+	@c entry_points. The disassembly of each is passed to @c receiver along with the bank's index; it is valid only
+	for the duration of that call, as each thread reuses a single workspace for all the banks it disassembles.
+
+	@c address_mapper and @c receiver will be called from multiple threads simultaneously, and banks may be
+	received in any order.
+*/
+void DisassembleBanks(
+	const std::vector<std::vector<uint8_t>> &banks,
+	const std::function<std::size_t(uint16_t)> &address_mapper,
+	const std::vector<std::vector<uint16_t>> &entry_points,
+	const std::function<void(std::size_t bank, const FlatDisassembly &disassembly)> &receiver);
+
 }
 }
 }
@@ -9,21 +9,37 @@
 #ifndef Kernel_hpp
 #define Kernel_hpp
 
+#include <cstdint>
+#include <functional>
+#include <vector>
+
 namespace Analyser {
 namespace Static {
 namespace Disassembly {
 
 template <typename D, typename S> struct PartialDisassembly {
-	D disassembly;
+	D &disassembly;
 	std::vector<S> remaining_entry_points;
 };
 
-template <typename D, typename S, typename Disassembler> D Disassemble(
+/*!
+	Indicates whether @c disassembly already has an instruction at @c address. Disassembly types that
+	don't keep a map named instructions_by_address may supply an overload of this alongside themselves.
+*/
+template <typename D, typename S> bool HasInstructionAt(const D &disassembly, S address) {
+	return disassembly.instructions_by_address.find(address) != disassembly.instructions_by_address.end();
+}
+
+/*!
+	Disassembles from each of @c entry_points, adding the results to @c disassembly, which
+	is not otherwise cleared.
+*/
+template <typename D, typename S, typename Disassembler> void DisassembleInto(
+	D &disassembly,
 	const std::vector<uint8_t> &memory,
 	const std::function<std::size_t(S)> &address_mapper,
 	std::vector<S> entry_points) {
-	PartialDisassembly<D, S> partial_disassembly;
-	partial_disassembly.remaining_entry_points = entry_points;
+	PartialDisassembly<D, S> partial_disassembly{disassembly, std::move(entry_points)};
 
 	while(!partial_disassembly.remaining_entry_points.empty()) {
 		// pull the next entry point from the back of the vector
@@ -31,8 +47,7 @@ template <typename D, typename S, typename Disassembler> D Disassemble(
 		partial_disassembly.remaining_entry_points.pop_back();
 
 		// if that address has already been visited, forget about it
-		if(	partial_disassembly.disassembly.instructions_by_address.find(next_entry_point)
-			!= partial_disassembly.disassembly.instructions_by_address.end()) continue;
+		if(HasInstructionAt(partial_disassembly.disassembly, next_entry_point)) continue;
 
 		// if it's outgoing, log it as such and forget about it; otherwise disassemble
 		std::size_t mapped_entry_point = address_mapper(next_entry_point);
@@ -41,8 +56,15 @@ template <typename D, typename S, typename Disassembler> D Disassemble(
 		else
 			Disassembler::AddToDisassembly(partial_disassembly, memory, address_mapper, next_entry_point);
 	}
+}
 
-	return partial_disassembly.disassembly;
+template <typename D, typename S, typename Disassembler> D Disassemble(
+	const std::vector<uint8_t> &memory,
+	const std::function<std::size_t(S)> &address_mapper,
+	std::vector<S> entry_points) {
+	D disassembly;
+	DisassembleInto<D, S, Disassembler>(disassembly, memory, address_mapper, std::move(entry_points));
+	return disassembly;
 }
 
 }
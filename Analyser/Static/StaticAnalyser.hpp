@@ -14,6 +14,7 @@
 #include "../../Storage/Tape/Tape.hpp"
 #include "../../Storage/Disk/Disk.hpp"
 #include "../../Storage/Cartridge/Cartridge.hpp"
+#include "../../Storage/MassStorage/MassStorageDevice.hpp"
 
 #include <memory>
 #include <string>
@@ -23,15 +24,16 @@ namespace Analyser {
 namespace Static {
 
 /*!
-	A list of disks, tapes and cartridges.
+	A list of disks, tapes, cartridges and mass storage devices.
 */
 struct Media {
 	std::vector<std::shared_ptr<Storage::Disk::Disk>> disks;
 	std::vector<std::shared_ptr<Storage::Tape::Tape>> tapes;
 	std::vector<std::shared_ptr<Storage::Cartridge::Cartridge>> cartridges;
+	std::vector<std::shared_ptr<Storage::MassStorage::MassStorageDevice>> mass_storage_devices;
 
 	bool empty() const {
-		return disks.empty() && tapes.empty() && cartridges.empty();
+		return disks.empty() && tapes.empty() && cartridges.empty() && mass_storage_devices.empty();
 	}
 };
 
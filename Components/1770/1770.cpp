@@ -108,6 +108,7 @@ void WD1770::run_for(const Cycles cycles) {
 		unsigned int number_of_cycles = static_cast<unsigned int>(cycles.as_int());
 		if(delay_time_ <= number_of_cycles) {
 			delay_time_ = 0;
+			update_clocking_observer();
 			posit_event(static_cast<int>(Event1770::Timer));
 		} else {
 			delay_time_ -= number_of_cycles;
@@ -115,8 +116,13 @@ void WD1770::run_for(const Cycles cycles) {
 	}
 }
 
+ClockingHint::Preference WD1770::preferred_clocking() {
+	if(delay_time_) return ClockingHint::Preference::RealTime;
+	return Storage::Disk::MFMController::preferred_clocking();
+}
+
 #define WAIT_FOR_EVENT(mask)	resume_point_ = __LINE__; interesting_event_mask_ = static_cast<int>(mask); return; case __LINE__:
-#define WAIT_FOR_TIME(ms)		resume_point_ = __LINE__; delay_time_ = ms * 8000; WAIT_FOR_EVENT(Event1770::Timer);
+#define WAIT_FOR_TIME(ms)		resume_point_ = __LINE__; delay_time_ = ms * 8000; update_clocking_observer(); WAIT_FOR_EVENT(Event1770::Timer);
 #define WAIT_FOR_BYTES(count)	resume_point_ = __LINE__; distance_into_section_ = 0; WAIT_FOR_EVENT(Event::Token); if(get_latest_token().type == Token::Byte) distance_into_section_++; if(distance_into_section_ < count) { interesting_event_mask_ = static_cast<int>(Event::Token); return; }
 #define BEGIN_SECTION()	switch(resume_point_) { default:
 #define END_SECTION()	(void)0; }
@@ -44,6 +44,9 @@ class WD1770: public Storage::Disk::MFMController {
 		/// Runs the controller for @c number_of_cycles cycles.
 		void run_for(const Cycles cycles);
 
+		/// As per ClockingHint::Source; the controller also requires clocking while any internal timer is running.
+		ClockingHint::Preference preferred_clocking() override;
+
 		enum Flag: uint8_t {
 			NotReady		= 0x80,
 			MotorOn			= 0x80,
@@ -0,0 +1,196 @@
+//
+//  ncr5380.cpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#include "ncr5380.hpp"
+
+using namespace NCR::NCR5380;
+using SCSI::Line;
+
+namespace {
+
+// Initiator command register bits.
+enum ICR: uint8_t {
+	AssertDataBus = 0x01,
+	AssertAttention = 0x02,
+	AssertSelect = 0x04,
+	AssertBusy = 0x08,
+	AssertAcknowledge = 0x10,
+	LostArbitration = 0x20,
+	ArbitrationInProgress = 0x40,
+	AssertReset = 0x80,
+};
+
+// Mode register bits.
+enum Mode: uint8_t {
+	Arbitrate = 0x01,
+	DMAMode = 0x02,
+	TargetMode = 0x40,
+};
+
+}
+
+NCR5380::NCR5380(SCSI::Bus &bus) : bus_(bus), device_id_(bus.add_device()) {}
+
+void NCR5380::write(int address, uint8_t value, bool dma_acknowledge) {
+	switch(address & 7) {
+		case 0:		// Output data register.
+			data_bus_ = value;
+			update_bus();
+		break;
+
+		case 1:		// Initiator command register.
+			initiator_command_ = value & ~(LostArbitration | ArbitrationInProgress);
+			update_bus();
+		break;
+
+		case 2:		// Mode register.
+			mode_ = value;
+			if(!(mode_ & DMAMode)) dma_send_ = false;
+			update_arbitration();
+			update_bus();
+		break;
+
+		case 3:		// Target command register.
+			target_command_ = value & 0x0f;
+			update_bus();
+		break;
+
+		case 4:		// Select enable register; reselection isn't supported.
+		break;
+
+		case 5:		// Start DMA send.
+			dma_send_ = true;
+		break;
+
+		case 6:		// Start DMA target receive.
+		case 7:		// Start DMA initiator receive.
+			dma_send_ = false;
+		break;
+	}
+
+	// A write with DACK asserted places the value on the bus and completes a
+	// REQ/ACK handshake with the target.
+	if(dma_acknowledge && (bus_.get_state() & Line::Request)) {
+		data_bus_ = value;
+		assert_acknowledge_ = true;
+		update_bus();
+		assert_acknowledge_ = false;
+		update_bus();
+	}
+}
+
+uint8_t NCR5380::read(int address, bool dma_acknowledge) {
+	// A read with DACK asserted returns whatever the target is currently offering and
+	// then completes a REQ/ACK handshake, prompting the target to offer the next byte.
+	if(dma_acknowledge) {
+		const auto state = bus_.get_state();
+		if(state & Line::Request) {
+			assert_acknowledge_ = true;
+			update_bus();
+			assert_acknowledge_ = false;
+			update_bus();
+		}
+		return uint8_t(state);
+	}
+
+	switch(address & 7) {
+		case 0:		// Current SCSI data.
+		case 6:		// Input data register.
+		return uint8_t(bus_.get_state());
+
+		case 1:		// Initiator command register.
+			update_arbitration();
+		return uint8_t(
+			initiator_command_ |
+			(arbitration_in_progress_ ? ArbitrationInProgress : 0)
+		);
+
+		case 2:		return mode_;
+		case 3:		return target_command_;
+
+		case 4: {	// Current SCSI bus status.
+			const auto state = bus_.get_state();
+			return uint8_t(
+				((state & Line::Reset) ? 0x80 : 0x00) |
+				((state & Line::Busy) ? 0x40 : 0x00) |
+				((state & Line::Request) ? 0x20 : 0x00) |
+				((state & Line::Message) ? 0x10 : 0x00) |
+				((state & Line::Control) ? 0x08 : 0x00) |
+				((state & Line::Input) ? 0x04 : 0x00) |
+				((state & Line::SelectTarget) ? 0x02 : 0x00) |
+				((state & Line::Parity) ? 0x01 : 0x00)
+			);
+		}
+
+		case 5: {	// Bus and status.
+			const auto state = bus_.get_state();
+			const bool phase_match = phase_matches();
+			const bool dma_request = (mode_ & DMAMode) && phase_match && (state & Line::Request);
+			return uint8_t(
+				(dma_request ? 0x40 : 0x00) |
+				(phase_match ? 0x08 : 0x00) |
+				((state & Line::Attention) ? 0x02 : 0x00) |
+				((state & Line::Acknowledge) ? 0x01 : 0x00)
+			);
+		}
+
+		default:	// Reset parity/interrupt; neither is generated here.
+		return 0xff;
+	}
+}
+
+bool NCR5380::phase_matches() const {
+	const auto state = bus_.get_state();
+	return
+		!!(state & Line::Message) == !!(target_command_ & 0x04) &&
+		!!(state & Line::Control) == !!(target_command_ & 0x02) &&
+		!!(state & Line::Input) == !!(target_command_ & 0x01);
+}
+
+void NCR5380::update_arbitration() {
+	if(!(mode_ & Arbitrate)) {
+		arbitration_in_progress_ = false;
+		return;
+	}
+
+	// Arbitration begins as soon as the bus is free of every other device;
+	// this is the only initiator so it is then immediately won.
+	if(!arbitration_in_progress_ && !(bus_.get_state() & (Line::Busy | Line::SelectTarget))) {
+		arbitration_in_progress_ = true;
+		update_bus();
+	}
+}
+
+void NCR5380::update_bus() {
+	SCSI::BusState output = SCSI::DefaultBusState;
+
+	if(initiator_command_ & AssertReset)			output |= Line::Reset;
+	if(initiator_command_ & AssertAcknowledge)		output |= Line::Acknowledge;
+	if(initiator_command_ & AssertBusy)				output |= Line::Busy;
+	if(initiator_command_ & AssertSelect)			output |= Line::SelectTarget;
+	if(initiator_command_ & AssertAttention)		output |= Line::Attention;
+	if(assert_acknowledge_)							output |= Line::Acknowledge;
+	if(arbitration_in_progress_)					output |= Line::Busy | data_bus_;
+
+	// Data is driven if explicitly requested, or implicitly during a DMA send
+	// in a data out phase.
+	if(
+		(initiator_command_ & AssertDataBus) ||
+		(dma_send_ && !(bus_.get_state() & Line::Input))
+	) {
+		output |= data_bus_;
+	}
+
+	if(mode_ & TargetMode) {
+		if(target_command_ & 0x01)	output |= Line::Input;
+		if(target_command_ & 0x02)	output |= Line::Control;
+		if(target_command_ & 0x04)	output |= Line::Message;
+		if(target_command_ & 0x08)	output |= Line::Request;
+	}
+
+	bus_.set_device_output(device_id_, output);
+}
@@ -0,0 +1,57 @@
+//
+//  ncr5380.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef ncr5380_hpp
+#define ncr5380_hpp
+
+#include <cstdint>
+
+#include "../../Storage/MassStorage/SCSI/SCSI.hpp"
+
+namespace NCR {
+namespace NCR5380 {
+
+/*!
+	Models the NCR 5380, a SCSI interface chip, as an initiator.
+
+	Bus activity is instantaneous: arbitration is won as soon as it's requested
+	if the bus is free, and each access with DMA acknowledge asserted performs a
+	complete REQ/ACK handshake. So pseudo-DMA transfers — in which the host simply
+	reads or writes with DACK asserted — proceed as quickly as the host can loop.
+*/
+class NCR5380 {
+	public:
+		NCR5380(SCSI::Bus &bus);
+
+		/*! Writes @c value to @c address; if @c dma_acknowledge is set then this is a pseudo-DMA write of @c value. */
+		void write(int address, uint8_t value, bool dma_acknowledge = false);
+
+		/*! Reads from @c address; if @c dma_acknowledge is set then this is a pseudo-DMA read. */
+		uint8_t read(int address, bool dma_acknowledge = false);
+
+	private:
+		void update_bus();
+		void update_arbitration();
+		bool phase_matches() const;
+
+		SCSI::Bus &bus_;
+		const size_t device_id_;
+
+		uint8_t data_bus_ = 0xff;
+		uint8_t initiator_command_ = 0;
+		uint8_t mode_ = 0;
+		uint8_t target_command_ = 0;
+
+		bool arbitration_in_progress_ = false;
+		bool assert_acknowledge_ = false;
+		bool dma_send_ = false;
+};
+
+}
+}
+
+#endif /* ncr5380_hpp */
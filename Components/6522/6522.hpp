@@ -114,6 +114,16 @@ template <class T> class MOS6522: public MOS6522Storage {
 		/// @returns @c true if the IRQ line is currently active; @c false otherwise.
 		bool get_interrupt_line();
 
+		/*!
+			Returns a lower bound on the amount of time until get_interrupt_line would next return true
+			due to either timer or the shift register, if there are no interceding calls to set_register,
+			get_register or set_control_line_input.
+
+			If get_interrupt_line is true now, or the shift register is enabled to cause an interrupt,
+			returns zero. If neither timer nor the shift register could cause an interrupt, returns -1.
+		*/
+		HalfCycles get_time_until_interrupt();
+
 		/// Updates the port handler to the current time and then requests that it flush.
 		void flush();
 
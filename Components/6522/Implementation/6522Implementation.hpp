@@ -388,6 +388,29 @@ template <typename T> bool MOS6522<T>::get_interrupt_line() {
 	return !!interrupt_status;
 }
 
+template <typename T> HalfCycles MOS6522<T>::get_time_until_interrupt() {
+	if(get_interrupt_line()) return HalfCycles(0);
+	if(shift_mode() != ShiftMode::Disabled && (registers_.interrupt_enable & InterruptFlag::ShiftRegister)) return HalfCycles(0);
+
+	int time_until_interrupt = -1;
+	for(int timer = 0; timer < 2; ++timer) {
+		if(!timer_is_running_[timer] || !(registers_.interrupt_enable & (timer ? InterruptFlag::Timer2 : InterruptFlag::Timer1))) continue;
+
+		// A timer that has just reached 0xffff will signal at the next phase 1, unless that has already occurred.
+		if(registers_.timer[timer] == 0xffff && !registers_.last_timer[timer] && !is_phase2_) return HalfCycles(0);
+
+		// Otherwise it'll be value + 1 phase 2s until the timer next reaches 0xffff, and the interrupt is
+		// signalled only upon the following phase 1. A pending reload or write replaces the value at the next phase 2.
+		int value = registers_.timer[timer];
+		if(!timer && registers_.timer_needs_reload) value = registers_.timer_latch[0] + 1;
+		if(registers_.next_timer[timer] >= 0) value = registers_.next_timer[timer] + 1;
+
+		const int time_until_timer = (value + 1) * 2;
+		if(time_until_interrupt < 0 || time_until_timer < time_until_interrupt) time_until_interrupt = time_until_timer;
+	}
+	return HalfCycles(time_until_interrupt);
+}
+
 template <typename T> void MOS6522<T>::evaluate_cb2_output() {
 	// CB2 is a special case, being both the line the shift register can output to,
 	// and one that can be used as an input or handshaking output according to the
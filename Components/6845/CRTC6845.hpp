@@ -11,6 +11,7 @@
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 
@@ -41,6 +42,18 @@ class BusHandler {
 			having to wait until the next cycle has begun.
 		*/
 		void perform_bus_cycle_phase2(const BusState &) {}
+
+		/*!
+			Offers the bus handler the opportunity to perform @c length consecutive bus cycles at once. Throughout
+			such a span hsync is inactive and nothing other than the refresh address changes; it begins
+			at @c state.refresh_address and increments by one per cycle, modulo 0x4000. No phase 2 calls
+			are made for cycles within a span as there is no sync change for them to report.
+
+			@returns @c true if the span was performed; @c false to have the CRTC perform each cycle individually.
+		*/
+		bool perform_bus_cycle_span(const BusState &, int length) {
+			return false;
+		}
 };
 
 enum Personality {
@@ -112,7 +125,22 @@ template <class T> class CRTC6845 {
 
 		void run_for(Cycles cycles) {
 			int cyles_remaining = cycles.as_int();
-			while(cyles_remaining--) {
+			while(cyles_remaining) {
+				// If the next few cycles will change nothing other than the refresh address, offer them to the
+				// bus handler as a single span.
+				const int span = std::min(steady_span_length(), cyles_remaining);
+				if(span > 1) {
+					bus_state_.display_enable = character_is_visible_ && line_is_visible_;
+					if(bus_handler_.perform_bus_cycle_span(bus_state_, span)) {
+						// The display skew shifter is already saturated with the current visibility, so is unaffected.
+						bus_state_.refresh_address = (bus_state_.refresh_address + span) & 0x3fff;
+						character_counter_ = static_cast<uint8_t>(character_counter_ + span);
+						cyles_remaining -= span;
+						continue;
+					}
+				}
+				--cyles_remaining;
+
 				// check for end of visible characters
 				if(character_counter_ == registers_[1]) {
 					// TODO: consider skew in character_is_visible_. Or maybe defer until perform_bus_cycle?
@@ -164,7 +192,34 @@ template <class T> class CRTC6845 {
 			return bus_state_;
 		}
 
+		/*!
+			@returns The number of cycles that can be run before, and including, the next in which hsync or vsync
+			might change. Owners that defer clocking can use this to be sure of observing sync changes promptly.
+		*/
+		int get_cycles_until_sync_change() const {
+			// Sync may change during hsync, or upon the end of the line, or upon reaching the start of hsync.
+			if(bus_state_.hsync) return 1;
+			return 1 + std::min(
+				static_cast<uint8_t>(registers_[0] - character_counter_),
+				static_cast<uint8_t>(registers_[2] - 1 - character_counter_));
+		}
+
 	private:
+		/*!
+			@returns The number of cycles from now in which only the refresh address will change:
+			i.e. before the end of visible characters, the end of the line or the start of hsync,
+			while hsync is inactive and the display skew shifter is stable.
+		*/
+		inline int steady_span_length() const {
+			if(bus_state_.hsync) return 0;
+			if((character_is_visible_shifter_ & 7) != (character_is_visible_ ? 7u : 0u)) return 0;
+			return std::min(
+				static_cast<uint8_t>(registers_[1] - character_counter_),
+				std::min(
+					static_cast<uint8_t>(registers_[0] - character_counter_),
+					static_cast<uint8_t>(registers_[2] - 1 - character_counter_)));
+		}
+
 		inline void perform_bus_cycle_phase1() {
 			// Skew theory of operation: keep a history of the last three states, and apply whichever is selected.
 			character_is_visible_shifter_ = (character_is_visible_shifter_ << 1) | static_cast<unsigned int>(character_is_visible_);
@@ -47,6 +47,37 @@ struct ReverseTable {
 	}
 } reverse_table;
 
+/*!
+	Maps a byte from one bit plane of a Master System tile or sprite row to
+	eight 4-bit pixels, the leftmost in the lowest nibble, with that plane's
+	bit set as appropriate. So ORing together the expansions of four planes,
+	each shifted by its plane number, gives all eight pixels of a row at once.
+
+	Table 1 is the same but for horizontally-flipped tiles.
+*/
+struct PlanarExpansionTable {
+	std::uint32_t map[2][256];
+
+	PlanarExpansionTable() {
+		for(int c = 0; c < 256; ++c) {
+			map[0][c] = map[1][c] = 0;
+			for(int b = 0; b < 8; ++b) {
+				if(c & (0x80 >> b)) map[0][c] |= 1 << (b << 2);
+				if(c & (0x01 << b)) map[1][c] |= 1 << (b << 2);
+			}
+		}
+	}
+
+	std::uint32_t expand(const std::uint8_t *planes, int flipped) const {
+		const std::uint32_t *const table = map[flipped];
+		return
+			table[planes[0]] |
+			(table[planes[1]] << 1) |
+			(table[planes[2]] << 2) |
+			(table[planes[3]] << 3);
+	}
+} planar_expansion_table;
+
 }
 
 Base::Base(Personality p) :
@@ -98,6 +129,8 @@ TMS9918::TMS9918(Personality p):
 }
 
 void TMS9918::set_tv_standard(TVStandard standard) {
+	perform_deferred_work();
+
 	tv_standard_ = standard;
 	switch(standard) {
 		case TVStandard::PAL:
@@ -219,28 +252,21 @@ void TMS9918::run_for(const HalfCycles cycles) {
 			// ------------------------
 			// Perform memory accesses.
 			// ------------------------
-#define fetch(function)	\
-	if(final_window != 171) {	\
-		function<true>(first_window, final_window);\
-	} else {\
-		function<false>(first_window, final_window);\
-	}
 
 			// column_ and end_column are in 342-per-line cycles;
 			// adjust them to a count of windows.
 			const int first_window = write_pointer_.column >> 1;
 			const int final_window = end_column >> 1;
 			if(first_window != final_window) {
-				switch(line_buffer.line_mode) {
-					case LineMode::Text:		fetch(fetch_tms_text);		break;
-					case LineMode::Character:	fetch(fetch_tms_character);	break;
-					case LineMode::SMS:			fetch(fetch_sms);			break;
-					case LineMode::Refresh:		fetch(fetch_tms_refresh);	break;
+				if(deferred_fetch_start_ < 0) deferred_fetch_start_ = first_window;
+
+				// Fetch now only if the line is complete or an external access needs to be
+				// slotted in; otherwise carry on accumulating.
+				if(final_window == 171 || queued_access_ != MemoryAccess::None) {
+					perform_deferred_fetch(final_window);
 				}
 			}
 
-#undef fetch
-
 
 
 			// -------------------------------
@@ -283,6 +309,10 @@ void TMS9918::run_for(const HalfCycles cycles) {
 			write_cycles_pool -= write_cycles;
 
 			if(write_pointer_.column == 342) {
+				// Drawing may depend on the current screen mode, which is about to
+				// be updated; so catch up on any that is outstanding.
+				perform_deferred_work();
+
 				write_pointer_.column = 0;
 				write_pointer_.row = (write_pointer_.row + 1) % mode_timing_.total_lines;
 				LineBuffer &next_line_buffer = line_buffers_[write_pointer_.row];
@@ -417,12 +447,20 @@ void TMS9918::run_for(const HalfCycles cycles) {
 						if(pixel_target_) {
 							const int relative_start = start - line_buffer.first_pixel_output_column;
 							const int relative_end = end - line_buffer.first_pixel_output_column;
-							switch(line_buffer.line_mode) {
-								case LineMode::SMS:			draw_sms(relative_start, relative_end, cram_value);		break;
-								case LineMode::Character:	draw_tms_character(relative_start, relative_end);		break;
-								case LineMode::Text:		draw_tms_text(relative_start, relative_end);			break;
 
-								case LineMode::Refresh:		break;	/* Dealt with elsewhere. */
+							if(cram_value) {
+								// A CRAM dot applies only to the first pixel of a draw,
+								// so catch up on everything before it.
+								perform_deferred_fetch(write_pointer_.column >> 1);
+								perform_deferred_draw(relative_start);
+								draw(relative_start, relative_end, cram_value);
+							} else {
+								// As with fetching: draw now only if the line is complete or an
+								// external access is pending; otherwise carry on accumulating.
+								if(deferred_draw_start_ < 0) deferred_draw_start_ = relative_start;
+								if(end == line_buffer.next_border_column || queued_access_ != MemoryAccess::None) {
+									perform_deferred_draw(relative_end);
+								}
 							}
 						}
 
@@ -462,6 +500,53 @@ void TMS9918::run_for(const HalfCycles cycles) {
 	}
 }
 
+void Base::perform_deferred_fetch(int end_window) {
+	const int start_window = deferred_fetch_start_;
+	deferred_fetch_start_ = -1;
+	if(start_window < 0 || end_window <= start_window) return;
+
+#define fetch(function)	\
+	if(end_window != 171) {	\
+		function<true>(start_window, end_window);\
+	} else {\
+		function<false>(start_window, end_window);\
+	}
+
+	switch(line_buffers_[write_pointer_.row].line_mode) {
+		case LineMode::Text:		fetch(fetch_tms_text);		break;
+		case LineMode::Character:	fetch(fetch_tms_character);	break;
+		case LineMode::SMS:			fetch(fetch_sms);			break;
+		case LineMode::Refresh:		fetch(fetch_tms_refresh);	break;
+	}
+
+#undef fetch
+}
+
+void Base::perform_deferred_draw(int end) {
+	const int start = deferred_draw_start_;
+	deferred_draw_start_ = -1;
+	if(start < 0 || end <= start) return;
+
+	draw(start, end, 0);
+}
+
+void Base::perform_deferred_work() {
+	perform_deferred_fetch(write_pointer_.column >> 1);
+
+	const LineBuffer &line_buffer = line_buffers_[read_pointer_.row];
+	perform_deferred_draw(std::min(read_pointer_.column, line_buffer.next_border_column) - line_buffer.first_pixel_output_column);
+}
+
+void Base::draw(int start, int end, uint32_t cram_dot) {
+	switch(line_buffers_[read_pointer_.row].line_mode) {
+		case LineMode::SMS:			draw_sms(start, end, cram_dot);		break;
+		case LineMode::Character:	draw_tms_character(start, end);		break;
+		case LineMode::Text:		draw_tms_text(start, end);			break;
+
+		case LineMode::Refresh:		break;	/* Dealt with elsewhere. */
+	}
+}
+
 void Base::output_border(int cycles, uint32_t cram_dot) {
 	cycles *= 4;
 	uint32_t border_colour =
@@ -494,6 +579,8 @@ void Base::output_border(int cycles, uint32_t cram_dot) {
 }
 
 void TMS9918::set_register(int address, uint8_t value) {
+	perform_deferred_work();
+
 	// Writes to address 0 are writes to the video RAM. Store
 	// the value and return.
 	if(!(address & 1)) {
@@ -672,6 +759,8 @@ void TMS9918::latch_horizontal_counter() {
 }
 
 uint8_t TMS9918::get_register(int address) {
+	perform_deferred_work();
+
 	write_phase_ = false;
 
 	// Reads from address 0 read video RAM, via the read-ahead buffer.
@@ -907,9 +996,6 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 	}
 
 
-	uint32_t pattern;
-	uint8_t *const pattern_index = reinterpret_cast<uint8_t *>(&pattern);
-
 	/*
 		Add background tiles; these will fill the colour_buffer with values in which
 		the low five bits are a palette index, and bit six is set if this tile has
@@ -921,36 +1007,16 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 		int pixels_left = tile_end - tile_start;
 		int length = std::min(pixels_left, 8 - shift);
 
-		pattern = *reinterpret_cast<const uint32_t *>(line_buffer.patterns[byte_column]);
-		if(line_buffer.names[byte_column].flags&2)
-			pattern >>= shift;
-		else
-			pattern <<= shift;
+		uint32_t pixels = planar_expansion_table.expand(
+			line_buffer.patterns[byte_column],
+			(line_buffer.names[byte_column].flags >> 1) & 1) >> (shift << 2);
 
 		while(true) {
 			const int palette_offset = (line_buffer.names[byte_column].flags&0x18) << 1;
-			if(line_buffer.names[byte_column].flags&2) {
-				for(int c = 0; c < length; ++c) {
-					colour_buffer[tile_offset] =
-						((pattern_index[3] & 0x01) << 3) |
-						((pattern_index[2] & 0x01) << 2) |
-						((pattern_index[1] & 0x01) << 1) |
-						((pattern_index[0] & 0x01) << 0) |
-						palette_offset;
-					++tile_offset;
-					pattern >>= 1;
-				}
-			} else {
-				for(int c = 0; c < length; ++c) {
-					colour_buffer[tile_offset] =
-						((pattern_index[3] & 0x80) >> 4) |
-						((pattern_index[2] & 0x80) >> 5) |
-						((pattern_index[1] & 0x80) >> 6) |
-						((pattern_index[0] & 0x80) >> 7) |
-						palette_offset;
-					++tile_offset;
-					pattern <<= 1;
-				}
+			for(int c = 0; c < length; ++c) {
+				colour_buffer[tile_offset] = int(pixels & 15) | palette_offset;
+				++tile_offset;
+				pixels >>= 4;
 			}
 
 			pixels_left -= length;
@@ -958,7 +1024,9 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 
 			length = std::min(8, pixels_left);
 			byte_column++;
-			pattern = *reinterpret_cast<const uint32_t *>(line_buffer.patterns[byte_column]);
+			pixels = planar_expansion_table.expand(
+				line_buffer.patterns[byte_column],
+				(line_buffer.names[byte_column].flags >> 1) & 1);
 		}
 	}
 
@@ -985,16 +1053,10 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 			LineBuffer::ActiveSprite &sprite = line_buffer.active_sprites[index];
 			if(sprite.shift_position < 16) {
 				const int pixel_start = std::max(start, sprite.x);
+				const uint32_t sprite_pixels = planar_expansion_table.expand(sprite.image, 0);
 
-				// TODO: it feels like the work below should be simplifiable;
-				// the double shift in particular, and hopefully the variable shift.
 				for(int c = pixel_start; c < end && sprite.shift_position < 16; ++c) {
-					const int shift = (sprite.shift_position >> 1);
-					const int sprite_colour =
-						(((sprite.image[3] << shift) & 0x80) >> 4) |
-						(((sprite.image[2] << shift) & 0x80) >> 5) |
-						(((sprite.image[1] << shift) & 0x80) >> 6) |
-						(((sprite.image[0] << shift) & 0x80) >> 7);
+					const int sprite_colour = int(sprite_pixels >> ((sprite.shift_position >> 1) << 2)) & 15;
 
 					if(sprite_colour) {
 						sprite_collision |= sprite_buffer[c];
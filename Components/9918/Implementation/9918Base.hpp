@@ -848,6 +848,18 @@ class Base {
 
 		uint32_t *pixel_target_ = nullptr, *pixel_origin_ = nullptr;
 		bool asked_for_write_area_ = false;
+
+		// Fetching and drawing are deferred for as long as nothing can observe or affect them,
+		// i.e. until a line ends or the outside world accesses the VDP. So lines during which
+		// no access occurs are fetched and drawn in a single pass; lines with accesses are
+		// divided exactly at the points of access.
+		int deferred_fetch_start_ = -1;		// The first access window of the current write line yet to be fetched, or -1 if none.
+		int deferred_draw_start_ = -1;		// The first pixel of the current read line yet to be drawn, or -1 if none.
+		void perform_deferred_fetch(int end_window);
+		void perform_deferred_draw(int end);
+		void perform_deferred_work();
+
+		void draw(int start, int end, uint32_t cram_dot);
 		void draw_tms_character(int start, int end);
 		void draw_tms_text(int start, int end);
 		void draw_sms(int start, int end, uint32_t cram_dot);
@@ -8,7 +8,9 @@
 
 #include "AY38910.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 using namespace GI::AY38910;
 
@@ -70,15 +72,28 @@ void AY38910::set_sample_volume_range(std::int16_t range) {
 	evaluate_output_volume();
 }
 
-void AY38910::get_samples(std::size_t number_of_samples, int16_t *target) {
-	std::size_t c = 0;
-	while((master_divider_&7) && c < number_of_samples) {
-		target[c] = output_volume_;
-		master_divider_++;
-		c++;
+namespace {
+
+/*!
+	Advances by @c steps a counter that counts down to zero and is then reloaded from @c period upon the following step,
+	as are all of the AY's dividers.
+
+	@returns The number of reloads that occurred.
+*/
+inline int advance_counter(int &counter, int period, int steps) {
+	if(steps <= counter) {
+		counter -= steps;
+		return 0;
 	}
 
-	while(c < number_of_samples) {
+	steps -= counter + 1;
+	counter = period - (steps % (period + 1));
+	return 1 + (steps / (period + 1));
+}
+
+}
+
+void AY38910::step_generators() {
 #define step_channel(c) \
 	if(tone_counters_[c]) tone_counters_[c]--;\
 	else {\
@@ -86,32 +101,131 @@ void AY38910::get_samples(std::size_t number_of_samples, int16_t *target) {
 		tone_counters_[c] = tone_periods_[c];\
 	}
 
-		// update the tone channels
-		step_channel(0);
-		step_channel(1);
-		step_channel(2);
+	// update the tone channels
+	step_channel(0);
+	step_channel(1);
+	step_channel(2);
 
 #undef step_channel
 
-		// ... the noise generator. This recomputes the new bit repeatedly but harmlessly, only shifting
-		// it into the official 17 upon divider underflow.
-		if(noise_counter_) noise_counter_--;
-		else {
-			noise_counter_ = noise_period_;
-			noise_output_ ^= noise_shift_register_&1;
-			noise_shift_register_ |= ((noise_shift_register_ ^ (noise_shift_register_ >> 3))&1) << 17;
-			noise_shift_register_ >>= 1;
+	// ... the noise generator. This recomputes the new bit repeatedly but harmlessly, only shifting
+	// it into the official 17 upon divider underflow.
+	if(noise_counter_) noise_counter_--;
+	else {
+		noise_counter_ = noise_period_;
+		step_noise();
+	}
+
+	// ... and the envelope generator. Table based for pattern lookup, with a 'refill' step: a way of
+	// implementing non-repeating patterns by locking them to table position 0x1f.
+	if(envelope_divider_) envelope_divider_--;
+	else {
+		envelope_divider_ = envelope_period_;
+		envelope_position_ ++;
+		if(envelope_position_ == 32) envelope_position_ = envelope_overflow_masks_[output_registers_[13]];
+	}
+}
+
+void AY38910::step_noise() {
+	noise_output_ ^= noise_shift_register_&1;
+	noise_shift_register_ |= ((noise_shift_register_ ^ (noise_shift_register_ >> 3))&1) << 17;
+	noise_shift_register_ >>= 1;
+}
+
+int AY38910::steps_until_transition() {
+	// Output can change only when a generator that currently contributes to it changes state. A channel
+	// contributes only if it is using the envelope or has a fixed volume that doesn't map to zero; its tone
+	// and noise outputs matter only if enabled.
+	int steps = std::numeric_limits<int>::max();
+	bool envelope_is_audible = false;
+	bool noise_is_audible = false;
+	for(int c = 0; c < 3; c++) {
+		const bool uses_envelope = output_registers_[8 + c] & 0x10;
+		if(!uses_envelope && !volumes_[output_registers_[8 + c] & 0xf]) continue;
+
+		envelope_is_audible |= uses_envelope;
+		noise_is_audible |= !(output_registers_[7] & (8 << c));
+		if(!(output_registers_[7] & (1 << c))) steps = std::min(steps, tone_counters_[c]);
+	}
+
+	if(noise_is_audible) steps = std::min(steps, noise_counter_);
+
+	// An envelope that has reached the end of a non-repeating shape is held at position 0x1f.
+	const bool envelope_is_held = envelope_position_ == 0x1f && envelope_overflow_masks_[output_registers_[13]] == 0x1f;
+	if(envelope_is_audible && !envelope_is_held) steps = std::min(steps, envelope_divider_);
+
+	return steps;
+}
+
+void AY38910::skip_steps(int steps) {
+	// Tone channels need only their phase.
+	for(int c = 0; c < 3; c++) {
+		tone_outputs_[c] ^= advance_counter(tone_counters_[c], tone_periods_[c], steps) & 1;
+	}
+
+	// The noise shift register has to be advanced properly, since the sequence matters.
+	int noise_steps = advance_counter(noise_counter_, noise_period_, steps);
+	while(noise_steps--) step_noise();
+
+	// Envelope positions either wrap or stick at 0x1f.
+	const int envelope_steps = advance_counter(envelope_divider_, envelope_period_, steps);
+	if(envelope_steps) {
+		if(envelope_overflow_masks_[output_registers_[13]]) {
+			envelope_position_ = std::min(0x1f, envelope_position_ + envelope_steps);
+		} else {
+			envelope_position_ = (envelope_position_ + envelope_steps) & 0x1f;
 		}
+	}
+}
 
-		// ... and the envelope generator. Table based for pattern lookup, with a 'refill' step: a way of
-		// implementing non-repeating patterns by locking them to table position 0x1f.
-		if(envelope_divider_) envelope_divider_--;
-		else {
-			envelope_divider_ = envelope_period_;
-			envelope_position_ ++;
-			if(envelope_position_ == 32) envelope_position_ = envelope_overflow_masks_[output_registers_[13]];
+void AY38910::get_samples(std::size_t number_of_samples, int16_t *target) {
+	std::size_t c = 0;
+	while((master_divider_&7) && c < number_of_samples) {
+		target[c] = output_volume_;
+		master_divider_++;
+		c++;
+	}
+
+	while(c < number_of_samples) {
+		// Each step lasts for eight samples; find out how many steps can be skipped without any
+		// change to the output, limited to the number needed to complete this request.
+		const std::size_t steps_requested = (number_of_samples - c + 7) >> 3;
+		const int steps = static_cast<int>(std::min(static_cast<std::size_t>(steps_until_transition()), steps_requested));
+
+		if(steps) {
+			skip_steps(steps);
+
+			const std::size_t samples = std::min(static_cast<std::size_t>(steps) << 3, number_of_samples - c);
+			std::fill(&target[c], &target[c + samples], output_volume_);
+			c += samples;
+			master_divider_ += static_cast<int>(samples);
+			continue;
+		}
+
+		// A transition is due; perform a normal step.
+		step_generators();
+		evaluate_output_volume();
+
+		for(int ic = 0; ic < 8 && c < number_of_samples; ic++) {
+			target[c] = output_volume_;
+			c++;
+			master_divider_++;
 		}
+	}
 
+	master_divider_ &= 7;
+}
+
+void AY38910::get_samples_stepwise(std::size_t number_of_samples, int16_t *target) {
+	std::size_t c = 0;
+	while((master_divider_&7) && c < number_of_samples) {
+		target[c] = output_volume_;
+		master_divider_++;
+		c++;
+	}
+
+	while(c < number_of_samples) {
+		step_generators();
 		evaluate_output_volume();
 
 		for(int ic = 0; ic < 8 && c < number_of_samples; ic++) {
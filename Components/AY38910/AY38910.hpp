@@ -88,6 +88,13 @@ class AY38910: public ::Outputs::Speaker::SampleSource {
 		bool is_zero_level();
 		void set_sample_volume_range(std::int16_t range);
 
+		/*!
+			Produces exactly the same output as get_samples but by stepping every generator individually,
+			rather than skipping directly between output transitions. Provided as a reference
+			implementation for testing.
+		*/
+		void get_samples_stepwise(std::size_t number_of_samples, int16_t *target);
+
 	private:
 		Concurrency::DeferringAsyncTaskQueue &task_queue_;
 
@@ -130,6 +137,11 @@ class AY38910: public ::Outputs::Speaker::SampleSource {
 		int16_t output_volume_;
 		void evaluate_output_volume();
 
+		void step_generators();
+		void step_noise();
+		int steps_until_transition();
+		void skip_steps(int steps);
+
 		void update_bus();
 		PortHandler *port_handler_ = nullptr;
 		void set_port_output(bool port_b);
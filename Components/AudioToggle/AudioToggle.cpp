@@ -25,6 +25,10 @@ void Toggle::set_sample_volume_range(std::int16_t range) {
 
 void Toggle::skip_samples(const std::size_t number_of_samples) {}
 
+void Toggle::get_transitions(std::size_t number_of_samples, Receiver &receiver) {
+	receiver.set_level(0, level_);
+}
+
 void Toggle::set_output(bool enabled) {
 	if(is_enabled_ == enabled) return;
 	is_enabled_ = enabled;
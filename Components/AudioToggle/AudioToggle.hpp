@@ -9,7 +9,7 @@
 #ifndef AudioToggle_hpp
 #define AudioToggle_hpp
 
-#include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
+#include "../../Outputs/Speaker/Implementation/TransitionSource.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
 
 namespace Audio {
@@ -17,13 +17,14 @@ namespace Audio {
 /*!
 	Provides a sample source that can programmatically be set to one of two values.
 */
-class Toggle: public Outputs::Speaker::SampleSource {
+class Toggle: public Outputs::Speaker::TransitionSource {
 	public:
 		Toggle(Concurrency::DeferringAsyncTaskQueue &audio_queue);
 
 		void get_samples(std::size_t number_of_samples, std::int16_t *target);
 		void set_sample_volume_range(std::int16_t range);
 		void skip_samples(const std::size_t number_of_samples);
+		void get_transitions(std::size_t number_of_samples, Receiver &receiver);
 
 		void set_output(bool enabled);
 		bool get_output();
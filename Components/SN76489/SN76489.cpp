@@ -8,6 +8,7 @@
 
 #include "SN76489.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -108,53 +109,96 @@ void SN76489::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 
 	while(c < number_of_samples) {
-		bool did_flip = false;
+		step();
+		evaluate_output_volume();
 
-#define step_channel(x, s) \
-		if(channels_[x].counter) channels_[x].counter--;\
-		else {\
-			channels_[x].level ^= 1;\
-			channels_[x].counter = channels_[x].divider;\
-			s;\
+		for(int ic = 0; ic < master_divider_period_ && c < number_of_samples; ++ic) {
+			target[c] = output_volume_;
+			c++;
+			master_divider_++;
 		}
+	}
 
-		step_channel(0, /**/);
-		step_channel(1, /**/);
-		step_channel(2, did_flip = true);
+	master_divider_ &= (master_divider_period_ - 1);
+}
+
+void SN76489::step() {
+	bool did_flip = false;
+
+#define step_channel(x, s) \
+	if(channels_[x].counter) channels_[x].counter--;\
+	else {\
+		channels_[x].level ^= 1;\
+		channels_[x].counter = channels_[x].divider;\
+		s;\
+	}
+
+	step_channel(0, /**/);
+	step_channel(1, /**/);
+	step_channel(2, did_flip = true);
 
 #undef step_channel
 
-		if(channels_[3].divider != 0xffff) {
-			if(channels_[3].counter) channels_[3].counter--;
-			else {
-				did_flip = true;
-				channels_[3].counter = channels_[3].divider;
-			}
+	if(channels_[3].divider != 0xffff) {
+		if(channels_[3].counter) channels_[3].counter--;
+		else {
+			did_flip = true;
+			channels_[3].counter = channels_[3].divider;
 		}
+	}
 
-		if(did_flip) {
-			channels_[3].level = noise_shifter_ & 1;
-			int new_bit = channels_[3].level;
-			switch(noise_mode_) {
-				default: break;
-				case Noise15:
-					new_bit ^= (noise_shifter_ >> 1);
-				break;
-				case Noise16:
-					new_bit ^= (noise_shifter_ >> 3);
-				break;
-			}
-			noise_shifter_ >>= 1;
-			noise_shifter_ |= (new_bit & 1) << (shifter_is_16bit_ ? 15 : 14);
+	if(did_flip) {
+		channels_[3].level = noise_shifter_ & 1;
+		int new_bit = channels_[3].level;
+		switch(noise_mode_) {
+			default: break;
+			case Noise15:
+				new_bit ^= (noise_shifter_ >> 1);
+			break;
+			case Noise16:
+				new_bit ^= (noise_shifter_ >> 3);
+			break;
 		}
+		noise_shifter_ >>= 1;
+		noise_shifter_ |= (new_bit & 1) << (shifter_is_16bit_ ? 15 : 14);
+	}
+}
 
-		evaluate_output_volume();
+void SN76489::get_transitions(std::size_t number_of_samples, Receiver &receiver) {
+	const std::size_t period = std::size_t(master_divider_period_);
+	receiver.set_level(0, output_volume_);
 
-		for(int ic = 0; ic < master_divider_period_ && c < number_of_samples; ++ic) {
-			target[c] = output_volume_;
-			c++;
-			master_divider_++;
+	// Complete any partial period left over from last time.
+	std::size_t c = std::min(number_of_samples, (period - std::size_t(master_divider_)) & (period - 1));
+	master_divider_ += int(c);
+
+	while(c < number_of_samples) {
+		// Determine how many steps will pass before any channel next flips, i.e. before any
+		// counter reaches zero; the noise channel counts only if it isn't tracking channel 2.
+		uint16_t steps_until_flip = std::min(channels_[0].counter, std::min(channels_[1].counter, channels_[2].counter));
+		if(channels_[3].divider != 0xffff) steps_until_flip = std::min(steps_until_flip, channels_[3].counter);
+
+		// Skip straight over those steps, as they can't change output.
+		const std::size_t steps_remaining = (number_of_samples - c + period - 1) / period;
+		if(steps_until_flip) {
+			const uint16_t steps = uint16_t(std::min(std::size_t(steps_until_flip), steps_remaining));
+			for(int channel = 0; channel < 3; ++channel) channels_[channel].counter -= steps;
+			if(channels_[3].divider != 0xffff) channels_[3].counter -= steps;
+
+			const std::size_t cycles = std::min(steps * period, number_of_samples - c);
+			c += cycles;
+			master_divider_ += int(cycles);
+			continue;
 		}
+
+		// Otherwise perform a single step, and announce the result.
+		step();
+		evaluate_output_volume();
+		receiver.set_level(c, output_volume_);
+
+		const std::size_t cycles = std::min(period, number_of_samples - c);
+		c += cycles;
+		master_divider_ += int(cycles);
 	}
 
 	master_divider_ &= (master_divider_period_ - 1);
@@ -9,12 +9,12 @@
 #ifndef SN76489_hpp
 #define SN76489_hpp
 
-#include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
+#include "../../Outputs/Speaker/Implementation/TransitionSource.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
 
 namespace TI {
 
-class SN76489: public Outputs::Speaker::SampleSource {
+class SN76489: public Outputs::Speaker::TransitionSource {
 	public:
 		enum class Personality {
 			SN76489,
@@ -33,11 +33,15 @@ class SN76489: public Outputs::Speaker::SampleSource {
 		bool is_zero_level();
 		void set_sample_volume_range(std::int16_t range);
 
+		// As per TransitionSource.
+		void get_transitions(std::size_t number_of_samples, Receiver &receiver);
+
 	private:
 		int master_divider_ = 0;
 		int master_divider_period_ = 16;
 		int16_t output_volume_ = 0;
 		void evaluate_output_volume();
+		void step();
 		int volumes_[16];
 
 		Concurrency::DeferringAsyncTaskQueue &task_queue_;
@@ -12,47 +12,40 @@ using namespace Concurrency;
 
 AsyncTaskQueue::AsyncTaskQueue()
 #ifndef __APPLE__
-	: should_destruct_(false)
+	: AsyncTaskQueue(WorkerPool::shared())
 #endif
 {
 #ifdef __APPLE__
 	serial_dispatch_queue_ = dispatch_queue_create("com.thomasharte.clocksignal.asyntaskqueue", DISPATCH_QUEUE_SERIAL);
-#else
-	thread_.reset(new std::thread([this]() {
-		while(!should_destruct_) {
-			std::function<void(void)> next_function;
-
-			// Take lock, check for a new task
-			std::unique_lock<std::mutex> lock(queue_mutex_);
-			if(!pending_tasks_.empty()) {
-				next_function = pending_tasks_.front();
-				pending_tasks_.pop_front();
-			}
-
-			if(next_function) {
-				// If there is a task, release lock and perform it
-				lock.unlock();
-				next_function();
-			} else {
-				// If there isn't a task, atomically block on the processing condition and release the lock
-				// until there's something pending (and then release it again via scope)
-				processing_condition_.wait(lock);
-			}
-		}
-	}));
 #endif
 }
 
+#ifndef __APPLE__
+AsyncTaskQueue::AsyncTaskQueue(WorkerPool &pool) : state_(std::make_shared<State>(pool)) {}
+
+void AsyncTaskQueue::State::perform(std::unique_lock<std::mutex> &lock) {
+	if(is_performing) return;
+	is_performing = true;
+
+	while(!pending_tasks.empty()) {
+		const auto next_function = std::move(pending_tasks.front());
+		pending_tasks.pop_front();
+
+		lock.unlock();
+		next_function();
+		lock.lock();
+	}
+
+	is_performing = false;
+	completion_condition.notify_all();
+}
+#endif
+
 AsyncTaskQueue::~AsyncTaskQueue() {
-#ifdef __APPLE__
 	flush();
+#ifdef __APPLE__
 	dispatch_release(serial_dispatch_queue_);
 	serial_dispatch_queue_ = nullptr;
-#else
-	should_destruct_ = true;
-	enqueue([](){});
-	thread_->join();
-	thread_.reset();
 #endif
 }
 
@@ -60,9 +53,21 @@ void AsyncTaskQueue::enqueue(std::function<void(void)> function) {
 #ifdef __APPLE__
 	dispatch_async(serial_dispatch_queue_, ^{function();});
 #else
-	std::lock_guard<std::mutex> lock(queue_mutex_);
-	pending_tasks_.push_back(function);
-	processing_condition_.notify_all();
+	std::lock_guard<std::mutex> lock(state_->mutex);
+	state_->pending_tasks.push_back(function);
+
+	// Post a request to perform tasks unless one is already outstanding, or tasks are
+	// already being performed and this one will therefore be picked up.
+	if(!state_->is_posted && !state_->is_performing) {
+		state_->is_posted = true;
+
+		const std::shared_ptr<State> state = state_;
+		state_->pool.enqueue([state] {
+			std::unique_lock<std::mutex> lock(state->mutex);
+			state->is_posted = false;
+			state->perform(lock);
+		});
+	}
 #endif
 }
 
@@ -70,14 +75,12 @@ void AsyncTaskQueue::flush() {
 #ifdef __APPLE__
 	dispatch_sync(serial_dispatch_queue_, ^{});
 #else
-	std::shared_ptr<std::mutex> flush_mutex(new std::mutex);
-	std::shared_ptr<std::condition_variable> flush_condition(new std::condition_variable);
-	std::unique_lock<std::mutex> lock(*flush_mutex);
-	enqueue([=] () {
-		std::unique_lock<std::mutex> inner_lock(*flush_mutex);
-		flush_condition->notify_all();
-	});
-	flush_condition->wait(lock);
+	// Wait for any thread that is already performing tasks to finish, then perform any that
+	// have been enqueued since. So the caller never waits for a worker that hasn't yet started,
+	// which would otherwise deadlock if the caller is itself one of the pool's threads.
+	std::unique_lock<std::mutex> lock(state_->mutex);
+	state_->completion_condition.wait(lock, [this] { return !state_->is_performing; });
+	state_->perform(lock);
 #endif
 }
 
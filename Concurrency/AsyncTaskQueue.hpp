@@ -9,15 +9,16 @@
 #ifndef AsyncTaskQueue_hpp
 #define AsyncTaskQueue_hpp
 
-#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <list>
 #include <memory>
-#include <thread>
+#include <mutex>
 
 #ifdef __APPLE__
 #include <dispatch/dispatch.h>
+#else
+#include "WorkerPool.hpp"
 #endif
 
 namespace Concurrency {
@@ -26,10 +27,22 @@ namespace Concurrency {
 	An async task queue allows a caller to enqueue void(void) functions. Those functions are guaranteed
 	to be performed serially and asynchronously from the caller. A caller may also request to flush,
 	causing it to block until all previously-enqueued functions are complete.
+
+	Queues do not own threads; functions are performed by a shared pool of workers —
+	either that of libdispatch or a @c WorkerPool — so any number of queues may exist.
 */
 class AsyncTaskQueue {
 	public:
 		AsyncTaskQueue();
+#ifndef __APPLE__
+		/// Creates a queue that is serviced by @c pool rather than by the shared worker pool.
+		AsyncTaskQueue(WorkerPool &pool);
+#endif
+
+		/*!
+			Performs all previously-enqueued functions, as per @c flush, then destroys the queue; so its owner
+			may safely destroy anything those functions use once the queue has gone.
+		*/
 		virtual ~AsyncTaskQueue();
 
 		/*!
@@ -43,6 +56,9 @@ class AsyncTaskQueue {
 
 		/*!
 			Blocks the caller until all previously-enqueud functions have completed.
+
+			@discussion Any of those functions that no thread has yet begun to perform may be
+			performed by the caller.
 		*/
 		void flush();
 
@@ -50,12 +66,22 @@ class AsyncTaskQueue {
 #ifdef __APPLE__
 		dispatch_queue_t serial_dispatch_queue_;
 #else
-		std::unique_ptr<std::thread> thread_;
-
-		std::mutex queue_mutex_;
-		std::list<std::function<void(void)>> pending_tasks_;
-		std::condition_variable processing_condition_;
-		std::atomic_bool should_destruct_;
+		// Queue state is shared with any function that has been posted to the worker pool
+		// in order to perform tasks, as that may outlive the queue itself.
+		struct State {
+			WorkerPool &pool;
+			std::mutex mutex;
+			std::list<std::function<void(void)>> pending_tasks;
+			std::condition_variable completion_condition;
+			bool is_performing = false;
+			bool is_posted = false;
+
+			State(WorkerPool &pool) : pool(pool) {}
+
+			/// Performs pending tasks until there are none, unless some other thread is already doing so.
+			void perform(std::unique_lock<std::mutex> &lock);
+		};
+		std::shared_ptr<State> state_;
 #endif
 };
 
@@ -0,0 +1,87 @@
+//
+//  WorkerPool.cpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+using namespace Concurrency;
+
+namespace {
+
+/// The minimum number of threads in a pool that is sized automatically.
+const unsigned int MinimumDefaultThreadCount = 2;
+
+}
+
+WorkerPool::WorkerPool(unsigned int thread_count) :
+	busy_nanoseconds_(0),
+	previous_utilisation_time_(std::chrono::steady_clock::now()) {
+	if(!thread_count) thread_count = std::max(std::thread::hardware_concurrency(), MinimumDefaultThreadCount);
+
+	for(unsigned int c = 0; c < thread_count; ++c) {
+		threads_.emplace_back([this]() {
+			std::unique_lock<std::mutex> lock(queue_mutex_);
+			while(true) {
+				if(pending_tasks_.empty()) {
+					if(should_destruct_) return;
+					processing_condition_.wait(lock);
+					continue;
+				}
+
+				// Take the next task, perform it without the lock and account for the time taken.
+				const auto next_function = std::move(pending_tasks_.front());
+				pending_tasks_.pop_front();
+				lock.unlock();
+
+				const auto start_time = std::chrono::steady_clock::now();
+				next_function();
+				busy_nanoseconds_ += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count();
+
+				lock.lock();
+			}
+		});
+	}
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(queue_mutex_);
+		should_destruct_ = true;
+		processing_condition_.notify_all();
+	}
+	for(auto &thread: threads_) {
+		thread.join();
+	}
+}
+
+WorkerPool &WorkerPool::shared() {
+	static WorkerPool pool;
+	return pool;
+}
+
+void WorkerPool::enqueue(const std::function<void(void)> &function) {
+	std::lock_guard<std::mutex> lock(queue_mutex_);
+	pending_tasks_.push_back(function);
+	processing_condition_.notify_one();
+}
+
+std::size_t WorkerPool::thread_count() const {
+	return threads_.size();
+}
+
+float WorkerPool::get_utilisation() {
+	std::lock_guard<std::mutex> lock(queue_mutex_);
+
+	const auto now = std::chrono::steady_clock::now();
+	const int64_t elapsed_nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(now - previous_utilisation_time_).count();
+	previous_utilisation_time_ = now;
+
+	const int64_t busy_nanoseconds = busy_nanoseconds_.exchange(0);
+	if(elapsed_nanoseconds <= 0) return 0.0f;
+	return std::min(1.0f, float(double(busy_nanoseconds) / (double(elapsed_nanoseconds) * double(threads_.size()))));
+}
@@ -0,0 +1,73 @@
+//
+//  WorkerPool.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef WorkerPool_hpp
+#define WorkerPool_hpp
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Concurrency {
+
+/*!
+	A worker pool owns a fixed number of threads, which perform enqueued void(void) functions
+	in the order they were enqueued but with no guarantee of serialisation.
+
+	Its purpose is to allow arbitrarily many queues and machines to be serviced without a thread apiece.
+*/
+class WorkerPool {
+	public:
+		/*!
+			Creates a pool of @c thread_count threads. If @c thread_count is zero then one thread per core is used,
+			but never fewer than two, so that a SessionHost on the pool can leave a thread free for queues.
+		*/
+		WorkerPool(unsigned int thread_count = 0);
+
+		/// Performs all outstanding functions, then stops all threads.
+		~WorkerPool();
+
+		/// @returns A pool shared by the whole process.
+		static WorkerPool &shared();
+
+		/*!
+			Adds @c function to the pool. This method is safe to call from multiple threads, including
+			those of the pool.
+		*/
+		void enqueue(const std::function<void(void)> &function);
+
+		/// @returns The number of threads in this pool.
+		std::size_t thread_count() const;
+
+		/*!
+			@returns The proportion of available thread time, in the range [0, 1], that was spent performing
+				functions since the previous call to this method or, for the first call, since construction.
+				Functions are accounted for only once they complete.
+		*/
+		float get_utilisation();
+
+	private:
+		std::vector<std::thread> threads_;
+
+		std::mutex queue_mutex_;
+		std::list<std::function<void(void)>> pending_tasks_;
+		std::condition_variable processing_condition_;
+		bool should_destruct_ = false;
+
+		std::atomic<int64_t> busy_nanoseconds_;
+		std::chrono::time_point<std::chrono::steady_clock> previous_utilisation_time_;
+};
+
+}
+
+#endif /* WorkerPool_hpp */
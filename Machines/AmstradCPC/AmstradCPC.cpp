@@ -216,84 +216,38 @@ class CRTCBusHandler {
 				output_mode = OutputMode::Border;
 			}
 
-			// If a transition between sync/border/pixels just occurred, flush whatever was
-			// in progress to the CRT and reset counting.
-			if(output_mode != previous_output_mode_) {
-				if(cycles_) {
-					switch(previous_output_mode_) {
-						default:
-						case OutputMode::Blank:			crt_.output_blank(cycles_ * 16);					break;
-						case OutputMode::Sync:			crt_.output_sync(cycles_ * 16);					break;
-						case OutputMode::Border:		output_border(cycles_);								break;
-						case OutputMode::ColourBurst:	crt_.output_default_colour_burst(cycles_ * 16);	break;
-						case OutputMode::Pixels:
-							crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
-							pixel_pointer_ = pixel_data_ = nullptr;
-						break;
-					}
-				}
-
-				cycles_ = 0;
-				previous_output_mode_ = output_mode;
-			}
-
-			// increment cycles since state changed
-			cycles_++;
+			set_output_mode(output_mode);
 
-			// collect some more pixels if output is ongoing
+			// Collect some more pixels if output is ongoing.
 			if(previous_output_mode_ == OutputMode::Pixels) {
-				if(!pixel_data_) {
-					pixel_pointer_ = pixel_data_ = crt_.begin_data(320, 8);
-				}
-				if(pixel_pointer_) {
-					// the CPC shuffles output lines as:
-					//	MA13 MA12	RA2 RA1 RA0		MA9 MA8 MA7 MA6 MA5 MA4 MA3 MA2 MA1 MA0		CCLK
-					// ... so form the real access address.
-					uint16_t address =
-						static_cast<uint16_t>(
-							((state.refresh_address & 0x3ff) << 1) |
-							((state.row_address & 0x7) << 11) |
-							((state.refresh_address & 0x3000) << 2)
-						);
-
-					// fetch two bytes and translate into pixels
-					switch(mode_) {
-						case 0:
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[0] = mode0_output_[ram_[address]];
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[1] = mode0_output_[ram_[address+1]];
-							pixel_pointer_ += 4;
-						break;
-
-						case 1:
-							reinterpret_cast<uint32_t *>(pixel_pointer_)[0] = mode1_output_[ram_[address]];
-							reinterpret_cast<uint32_t *>(pixel_pointer_)[1] = mode1_output_[ram_[address+1]];
-							pixel_pointer_ += 8;
-						break;
-
-						case 2:
-							reinterpret_cast<uint64_t *>(pixel_pointer_)[0] = mode2_output_[ram_[address]];
-							reinterpret_cast<uint64_t *>(pixel_pointer_)[1] = mode2_output_[ram_[address+1]];
-							pixel_pointer_ += 16;
-						break;
+				output_pixels(state.refresh_address, state.row_address, 1);
+			} else {
+				++cycles_;
+			}
+		}
 
-						case 3:
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[0] = mode3_output_[ram_[address]];
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[1] = mode3_output_[ram_[address+1]];
-							pixel_pointer_ += 4;
-						break;
+		/*!
+			The CRTC entry function for a span of cycles during which only the refresh address changes;
+			output is therefore sync, border or pixels throughout and pixels can be produced in bulk.
+		*/
+		forceinline bool perform_bus_cycle_span(const Motorola::CRTC::BusState &state, int length) {
+			// The CRTC guarantees that hsync is inactive, so this is a span outside of horizontal sync.
+			cycles_into_hsync_ = 0;
 
-					}
+			if(state.vsync) {
+				set_output_mode(OutputMode::Sync);
+			} else if(state.display_enable) {
+				set_output_mode(OutputMode::Pixels);
+			} else {
+				set_output_mode(OutputMode::Border);
+			}
 
-					// flush the current buffer pixel if full; the CRTC allows many different display
-					// widths so it's not necessarily possible to predict the correct number in advance
-					// and using the upper bound could lead to inefficient behaviour
-					if(pixel_pointer_ == pixel_data_ + 320) {
-						crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
-						pixel_pointer_ = pixel_data_ = nullptr;
-						cycles_ = 0;
-					}
-				}
+			if(previous_output_mode_ == OutputMode::Pixels) {
+				output_pixels(state.refresh_address, state.row_address, length);
+			} else {
+				cycles_ += length;
 			}
+			return true;
 		}
 
 		/*!
@@ -368,6 +322,117 @@ class CRTCBusHandler {
 		}
 
 	private:
+		enum class OutputMode {
+			Sync,
+			Blank,
+			ColourBurst,
+			Border,
+			Pixels
+		};
+
+		/// If @c output_mode differs from the current output mode, flushes whatever was in progress to the CRT and resets counting.
+		forceinline void set_output_mode(OutputMode output_mode) {
+			if(output_mode == previous_output_mode_) return;
+
+			if(cycles_) {
+				switch(previous_output_mode_) {
+					default:
+					case OutputMode::Blank:			crt_.output_blank(cycles_ * 16);					break;
+					case OutputMode::Sync:			crt_.output_sync(cycles_ * 16);					break;
+					case OutputMode::Border:		output_border(cycles_);								break;
+					case OutputMode::ColourBurst:	crt_.output_default_colour_burst(cycles_ * 16);	break;
+					case OutputMode::Pixels:
+						crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
+						pixel_pointer_ = pixel_data_ = nullptr;
+					break;
+				}
+			}
+
+			cycles_ = 0;
+			previous_output_mode_ = output_mode;
+		}
+
+		/// @returns The address in RAM of the two bytes fetched for @c refresh_address and @c row_address.
+		static forceinline uint16_t ram_address(uint16_t refresh_address, uint16_t row_address) {
+			// the CPC shuffles output lines as:
+			//	MA13 MA12	RA2 RA1 RA0		MA9 MA8 MA7 MA6 MA5 MA4 MA3 MA2 MA1 MA0		CCLK
+			// ... so form the real access address.
+			return
+				static_cast<uint16_t>(
+					((refresh_address & 0x3ff) << 1) |
+					((row_address & 0x7) << 11) |
+					((refresh_address & 0x3000) << 2)
+				);
+		}
+
+		/*!
+			Outputs @c length characters of pixels, starting from @c refresh_address and @c row_address,
+			adding to the count of cycles in the current output mode.
+		*/
+		forceinline void output_pixels(uint16_t refresh_address, uint16_t row_address, int length) {
+			const int bytes_per_character = 16 / pixel_divider_;
+			while(length) {
+				if(!pixel_data_) {
+					pixel_pointer_ = pixel_data_ = crt_.begin_data(320, 8);
+				}
+				if(!pixel_pointer_) {
+					cycles_ += length;
+					return;
+				}
+
+				// Fill as much of the current buffer as possible, with the mode selection outside of the loop.
+				const int characters = std::min(length, int(pixel_data_ + 320 - pixel_pointer_) / bytes_per_character);
+				switch(mode_) {
+					case 0:
+						for(int c = 0; c < characters; ++c) {
+							const uint16_t address = ram_address(refresh_address++, row_address);
+							reinterpret_cast<uint16_t *>(pixel_pointer_)[0] = mode0_output_[ram_[address]];
+							reinterpret_cast<uint16_t *>(pixel_pointer_)[1] = mode0_output_[ram_[address+1]];
+							pixel_pointer_ += 4;
+						}
+					break;
+
+					case 1:
+						for(int c = 0; c < characters; ++c) {
+							const uint16_t address = ram_address(refresh_address++, row_address);
+							reinterpret_cast<uint32_t *>(pixel_pointer_)[0] = mode1_output_[ram_[address]];
+							reinterpret_cast<uint32_t *>(pixel_pointer_)[1] = mode1_output_[ram_[address+1]];
+							pixel_pointer_ += 8;
+						}
+					break;
+
+					case 2:
+						for(int c = 0; c < characters; ++c) {
+							const uint16_t address = ram_address(refresh_address++, row_address);
+							reinterpret_cast<uint64_t *>(pixel_pointer_)[0] = mode2_output_[ram_[address]];
+							reinterpret_cast<uint64_t *>(pixel_pointer_)[1] = mode2_output_[ram_[address+1]];
+							pixel_pointer_ += 16;
+						}
+					break;
+
+					case 3:
+						for(int c = 0; c < characters; ++c) {
+							const uint16_t address = ram_address(refresh_address++, row_address);
+							reinterpret_cast<uint16_t *>(pixel_pointer_)[0] = mode3_output_[ram_[address]];
+							reinterpret_cast<uint16_t *>(pixel_pointer_)[1] = mode3_output_[ram_[address+1]];
+							pixel_pointer_ += 4;
+						}
+					break;
+				}
+				cycles_ += characters;
+				length -= characters;
+
+				// flush the current buffer pixel if full; the CRTC allows many different display
+				// widths so it's not necessarily possible to predict the correct number in advance
+				// and using the upper bound could lead to inefficient behaviour
+				if(!characters || pixel_pointer_ == pixel_data_ + 320) {
+					crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
+					pixel_pointer_ = pixel_data_ = nullptr;
+					cycles_ = 0;
+				}
+			}
+		}
+
 		void output_border(int length) {
 			uint8_t *colour_pointer = static_cast<uint8_t *>(crt_.begin_data(1));
 			if(colour_pointer) *colour_pointer = border_;
@@ -513,13 +578,7 @@ class CRTCBusHandler {
 			return mapping[colour];
 		}
 
-		enum class OutputMode {
-			Sync,
-			Blank,
-			ColourBurst,
-			Border,
-			Pixels
-		} previous_output_mode_ = OutputMode::Sync;
+		OutputMode previous_output_mode_ = OutputMode::Sync;
 		int cycles_ = 0;
 
 		bool was_hsync_ = false, was_vsync_ = false;
@@ -851,10 +910,14 @@ template <bool has_fdc> class ConcreteMachine:
 			// Update the CRTC once every eight half cycles; aiming for half-cycle 4 as
 			// per the initial seed to the crtc_counter_, but any time in the final four
 			// will do as it's safe to conclude that nobody else has touched video RAM
-			// during that whole window
+			// during that whole window.
+			//
+			// CRTC cycles are accumulated rather than run immediately, up until the next
+			// in which sync might change, so that the CRTC can produce output in spans.
+			// Anything that might affect or observe video flushes the CRTC first.
 			crtc_counter_ += cycle.length;
-			Cycles crtc_cycles = crtc_counter_.divide_cycles(Cycles(4));
-			if(crtc_cycles > Cycles(0)) crtc_.run_for(crtc_cycles);
+			crtc_cycles_pending_ += crtc_counter_.divide_cycles(Cycles(4)).as_int();
+			if(crtc_cycles_pending_ >= crtc_cycles_until_sync_change_) flush_crtc();
 
 			// Check whether that prompted a change in the interrupt line. If so then date
 			// it to whenever the cycle was triggered.
@@ -884,10 +947,13 @@ template <bool has_fdc> class ConcreteMachine:
 				break;
 
 				case CPU::Z80::PartialMachineCycle::Write:
+					flush_crtc();
 					write_pointers_[address >> 14][address & 16383] = *cycle.value;
 				break;
 
 				case CPU::Z80::PartialMachineCycle::Output:
+					flush_crtc();
+
 					// Check for a gate array access.
 					if((address & 0xc000) == 0x4000) {
 						write_to_gate_array(*cycle.value);
@@ -924,8 +990,13 @@ template <bool has_fdc> class ConcreteMachine:
 						flush_fdc();
 						fdc_.set_motor_on(!!(*cycle.value));
 					}
+
+					// CRTC register writes may have moved the next sync change.
+					crtc_cycles_until_sync_change_ = crtc_.get_cycles_until_sync_change();
 				break;
 				case CPU::Z80::PartialMachineCycle::Input:
+					flush_crtc();
+
 					// Default to nothing answering
 					*cycle.value = 0xff;
 
@@ -956,12 +1027,15 @@ template <bool has_fdc> class ConcreteMachine:
 					if((address & 0xc000) == 0x4000) {
 						write_to_gate_array(*cycle.value);
 					}
+
+					crtc_cycles_until_sync_change_ = crtc_.get_cycles_until_sync_change();
 				break;
 
 				case CPU::Z80::PartialMachineCycle::Interrupt:
 					// Nothing is loaded onto the bus during an interrupt acknowledge, but
 					// the fact of the acknowledge needs to be posted on to the interrupt timer.
 					*cycle.value = 0xff;
+					flush_crtc();
 					interrupt_timer_.signal_interrupt_acknowledge();
 				break;
 
@@ -977,10 +1051,11 @@ template <bool has_fdc> class ConcreteMachine:
 
 		/// Another Z80 entry point; indicates that a partcular run request has concluded.
 		void flush() {
-			// Just flush the AY.
+			// Just flush the AY, and any lagging devices.
 			ay_.update();
 			ay_.flush();
 			flush_fdc();
+			flush_crtc();
 		}
 
 		/// A CRTMachine function; sets the destination for video.
@@ -1157,6 +1232,15 @@ template <bool has_fdc> class ConcreteMachine:
 
 		HalfCycles clock_offset_;
 		HalfCycles crtc_counter_;
+		int crtc_cycles_pending_ = 0;
+		int crtc_cycles_until_sync_change_ = 1;
+		void flush_crtc() {
+			if(crtc_cycles_pending_) {
+				crtc_.run_for(Cycles(crtc_cycles_pending_));
+				crtc_cycles_pending_ = 0;
+			}
+			crtc_cycles_until_sync_change_ = crtc_.get_cycles_until_sync_change();
+		}
 		HalfCycles half_cycles_since_ay_update_;
 
 		uint8_t ram_[128 * 1024];
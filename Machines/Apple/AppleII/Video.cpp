@@ -8,8 +8,73 @@
 
 #include "Video.hpp"
 
+#include <cstring>
+
 using namespace Apple::II::Video;
 
+namespace {
+
+/*!
+	Provides the output sample runs for each possible source value in each graphics mode,
+	so that output can proceed a whole column at a time. Each value is the relevant bit
+	of the source value in isolation, exactly as if the bit had been masked off directly.
+
+	Rows are padded to 8 or 16 bytes; padding is never output.
+*/
+struct ExpansionTables {
+	/// 40-column text: seven pixels, MSB first, each doubled.
+	uint8_t text[128][16];
+
+	/// 80-column text: seven pixels, MSB first.
+	uint8_t double_text[128][8];
+
+	/// High resolution: seven pixels, LSB first, each doubled.
+	uint8_t high_resolution[128][16];
+
+	/// Double high resolution: seven pixels, LSB first.
+	uint8_t double_high_resolution[128][8];
+
+	/// Low resolution: indexed by column parity and then colour; the colour rotates
+	/// through its four bits, starting from bit 0 in even columns and bit 2 in odd.
+	uint8_t low_resolution[2][16][16];
+
+	/// Fat low resolution: the colour's four bits, each doubled, rotated through.
+	uint8_t fat_low_resolution[16][16];
+
+	/// Double low resolution: indexed by column parity and then colour; seven samples,
+	/// starting from bit 3 in even columns and bit 1 in odd.
+	uint8_t double_low_resolution[2][16][8];
+
+	ExpansionTables() {
+		for(int value = 0; value < 128; ++value) {
+			for(int c = 0; c < 14; ++c) {
+				text[value][c] = uint8_t(value & (0x40 >> (c >> 1)));
+				high_resolution[value][c] = uint8_t(value & (0x01 << (c >> 1)));
+			}
+			for(int c = 0; c < 7; ++c) {
+				double_text[value][c] = uint8_t(value & (0x40 >> c));
+				double_high_resolution[value][c] = uint8_t(value & (0x01 << c));
+			}
+		}
+
+		for(int value = 0; value < 16; ++value) {
+			for(int c = 0; c < 14; ++c) {
+				low_resolution[0][value][c] = uint8_t(value & (1 << (c & 3)));
+				low_resolution[1][value][c] = uint8_t(value & (1 << ((c + 2) & 3)));
+				fat_low_resolution[value][c] = uint8_t(value & (1 << ((c >> 1) & 3)));
+			}
+			for(int c = 0; c < 7; ++c) {
+				double_low_resolution[0][value][c] = uint8_t(value & (1 << ((c + 3) & 3)));
+				double_low_resolution[1][value][c] = uint8_t(value & (1 << ((c + 1) & 3)));
+			}
+		}
+	}
+};
+
+const ExpansionTables expansion_tables;
+
+}
+
 VideoBase::VideoBase(bool is_iie, std::function<void(Cycles)> &&target) :
 	crt_(910, 1, Outputs::Display::Type::NTSC60, Outputs::Display::InputDataType::Luminance1),
 	is_iie_(is_iie),
@@ -169,14 +234,7 @@ void VideoBase::output_text(uint8_t *target, const uint8_t *const source, size_t
 		const std::size_t character_address = static_cast<std::size_t>(character << 3) + pixel_row;
 		const uint8_t character_pattern = character_rom_[character_address] ^ xor_mask;
 
-		// The character ROM is output MSB to LSB rather than LSB to MSB.
-		target[0] = target[1] = character_pattern & 0x40;
-		target[2] = target[3] = character_pattern & 0x20;
-		target[4] = target[5] = character_pattern & 0x10;
-		target[6] = target[7] = character_pattern & 0x08;
-		target[8] = target[9] = character_pattern & 0x04;
-		target[10] = target[11] = character_pattern & 0x02;
-		target[12] = target[13] = character_pattern & 0x01;
+		memcpy(target, expansion_tables.text[character_pattern & 0x7f], 14);
 		graphics_carry_ = character_pattern & 0x01;
 		target += 14;
 	}
@@ -202,21 +260,8 @@ void VideoBase::output_double_text(uint8_t *target, const uint8_t *const source,
 			)
 		};
 
-		// The character ROM is output MSB to LSB rather than LSB to MSB.
-		target[0] = character_patterns[0] & 0x40;
-		target[1] = character_patterns[0] & 0x20;
-		target[2] = character_patterns[0] & 0x10;
-		target[3] = character_patterns[0] & 0x08;
-		target[4] = character_patterns[0] & 0x04;
-		target[5] = character_patterns[0] & 0x02;
-		target[6] = character_patterns[0] & 0x01;
-		target[7] = character_patterns[1] & 0x40;
-		target[8] = character_patterns[1] & 0x20;
-		target[9] = character_patterns[1] & 0x10;
-		target[10] = character_patterns[1] & 0x08;
-		target[11] = character_patterns[1] & 0x04;
-		target[12] = character_patterns[1] & 0x02;
-		target[13] = character_patterns[1] & 0x01;
+		memcpy(&target[0], expansion_tables.double_text[character_patterns[0] & 0x7f], 7);
+		memcpy(&target[7], expansion_tables.double_text[character_patterns[1] & 0x7f], 7);
 		graphics_carry_ = character_patterns[1] & 0x01;
 		target += 14;
 	}
@@ -227,19 +272,10 @@ void VideoBase::output_low_resolution(uint8_t *target, const uint8_t *const sour
 	for(size_t c = 0; c < length; ++c) {
 		// Low-resolution graphics mode shifts the colour code on a loop, but has to account for whether this
 		// 14-sample output window is starting at the beginning of a colour cycle or halfway through.
-		if((column + static_cast<int>(c))&1) {
-			target[0] = target[4] = target[8] = target[12] = (source[c] >> row_shift) & 4;
-			target[1] = target[5] = target[9] = target[13] = (source[c] >> row_shift) & 8;
-			target[2] = target[6] = target[10] = (source[c] >> row_shift) & 1;
-			target[3] = target[7] = target[11] = (source[c] >> row_shift) & 2;
-			graphics_carry_ = (source[c] >> row_shift) & 8;
-		} else {
-			target[0] = target[4] = target[8] = target[12] = (source[c] >> row_shift) & 1;
-			target[1] = target[5] = target[9] = target[13] = (source[c] >> row_shift) & 2;
-			target[2] = target[6] = target[10] = (source[c] >> row_shift) & 4;
-			target[3] = target[7] = target[11] = (source[c] >> row_shift) & 8;
-			graphics_carry_ = (source[c] >> row_shift) & 2;
-		}
+		const uint8_t *const pixels =
+			expansion_tables.low_resolution[(column + static_cast<int>(c))&1][(source[c] >> row_shift) & 0xf];
+		memcpy(target, pixels, 14);
+		graphics_carry_ = pixels[13];
 		target += 14;
 	}
 }
@@ -249,11 +285,9 @@ void VideoBase::output_fat_low_resolution(uint8_t *target, const uint8_t *const
 	for(size_t c = 0; c < length; ++c) {
 		// Fat low-resolution mode appears not to do anything to try to make odd and
 		// even columns compatible.
-		target[0] = target[1] = target[8] = target[9] = (source[c] >> row_shift) & 1;
-		target[2] = target[3] = target[10] = target[11] = (source[c] >> row_shift) & 2;
-		target[4] = target[5] = target[12] = target[13] = (source[c] >> row_shift) & 4;
-		target[6] = target[7] = (source[c] >> row_shift) & 8;
-		graphics_carry_ = (source[c] >> row_shift) & 4;
+		const uint8_t *const pixels = expansion_tables.fat_low_resolution[(source[c] >> row_shift) & 0xf];
+		memcpy(target, pixels, 14);
+		graphics_carry_ = pixels[13];
 		target += 14;
 	}
 }
@@ -261,29 +295,11 @@ void VideoBase::output_fat_low_resolution(uint8_t *target, const uint8_t *const
 void VideoBase::output_double_low_resolution(uint8_t *target, const uint8_t *const source, const uint8_t *const auxiliary_source, size_t length, int column, int row) const {
 	const int row_shift = row&4;
 	for(size_t c = 0; c < length; ++c) {
-		if((column + static_cast<int>(c))&1) {
-			target[0] = target[4] = (auxiliary_source[c] >> row_shift) & 2;
-			target[1] = target[5] = (auxiliary_source[c] >> row_shift) & 4;
-			target[2] = target[6] = (auxiliary_source[c] >> row_shift) & 8;
-			target[3] = (auxiliary_source[c] >> row_shift) & 1;
-
-			target[8] = target[12] = (source[c] >> row_shift) & 4;
-			target[9] = target[13] = (source[c] >> row_shift) & 8;
-			target[10] = (source[c] >> row_shift) & 1;
-			target[7] = target[11] = (source[c] >> row_shift) & 2;
-			graphics_carry_ = (source[c] >> row_shift) & 8;
-		} else {
-			target[0] = target[4] = (auxiliary_source[c] >> row_shift) & 8;
-			target[1] = target[5] = (auxiliary_source[c] >> row_shift) & 1;
-			target[2] = target[6] = (auxiliary_source[c] >> row_shift) & 2;
-			target[3] = (auxiliary_source[c] >> row_shift) & 4;
-
-			target[8] = target[12] = (source[c] >> row_shift) & 1;
-			target[9] = target[13] = (source[c] >> row_shift) & 2;
-			target[10] = (source[c] >> row_shift) & 4;
-			target[7] = target[11] = (source[c] >> row_shift) & 8;
-			graphics_carry_ = (source[c] >> row_shift) & 2;
-		}
+		const int parity = (column + static_cast<int>(c))&1;
+		const uint8_t *const pixels = expansion_tables.double_low_resolution[parity][(source[c] >> row_shift) & 0xf];
+		memcpy(&target[0], expansion_tables.double_low_resolution[parity][(auxiliary_source[c] >> row_shift) & 0xf], 7);
+		memcpy(&target[7], pixels, 7);
+		graphics_carry_ = pixels[6];
 		target += 14;
 	}
 }
@@ -294,46 +310,22 @@ void VideoBase::output_high_resolution(uint8_t *target, const uint8_t *const sou
 		// If there is a delay, the previous output level is held to bridge the gap.
 		// Delays may be ignored on a IIe if Annunciator 3 is set; that's the state that
 		// high_resolution_mask_ models.
+		const uint8_t *const pixels = expansion_tables.high_resolution[source[c] & 0x7f];
 		if(source[c] & high_resolution_mask_ & 0x80) {
 			target[0] = graphics_carry_;
-			target[1] = target[2] = source[c] & 0x01;
-			target[3] = target[4] = source[c] & 0x02;
-			target[5] = target[6] = source[c] & 0x04;
-			target[7] = target[8] = source[c] & 0x08;
-			target[9] = target[10] = source[c] & 0x10;
-			target[11] = target[12] = source[c] & 0x20;
-			target[13] = source[c] & 0x40;
+			memcpy(&target[1], pixels, 13);
 		} else {
-			target[0] = target[1] = source[c] & 0x01;
-			target[2] = target[3] = source[c] & 0x02;
-			target[4] = target[5] = source[c] & 0x04;
-			target[6] = target[7] = source[c] & 0x08;
-			target[8] = target[9] = source[c] & 0x10;
-			target[10] = target[11] = source[c] & 0x20;
-			target[12] = target[13] = source[c] & 0x40;
+			memcpy(target, pixels, 14);
 		}
-		graphics_carry_ = source[c] & 0x40;
+		graphics_carry_ = pixels[13];
 		target += 14;
 	}
 }
 
 void VideoBase::output_double_high_resolution(uint8_t *target, const uint8_t *const source, const uint8_t *const auxiliary_source, size_t length) const {
 	for(size_t c = 0; c < length; ++c) {
-		target[0] = auxiliary_source[c] & 0x01;
-		target[1] = auxiliary_source[c] & 0x02;
-		target[2] = auxiliary_source[c] & 0x04;
-		target[3] = auxiliary_source[c] & 0x08;
-		target[4] = auxiliary_source[c] & 0x10;
-		target[5] = auxiliary_source[c] & 0x20;
-		target[6] = auxiliary_source[c] & 0x40;
-		target[7] = source[c] & 0x01;
-		target[8] = source[c] & 0x02;
-		target[9] = source[c] & 0x04;
-		target[10] = source[c] & 0x08;
-		target[11] = source[c] & 0x10;
-		target[12] = source[c] & 0x20;
-		target[13] = source[c] & 0x40;
-
+		memcpy(&target[0], expansion_tables.double_high_resolution[auxiliary_source[c] & 0x7f], 7);
+		memcpy(&target[7], expansion_tables.double_high_resolution[source[c] & 0x7f], 7);
 		graphics_carry_ = auxiliary_source[c] & 0x40;
 		target += 14;
 	}
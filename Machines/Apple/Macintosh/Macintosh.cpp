@@ -13,6 +13,7 @@
 #include "DeferredAudio.hpp"
 #include "DriveSpeedAccumulator.hpp"
 #include "Keyboard.hpp"
+#include "MemoryMap.hpp"
 #include "RealTimeClock.hpp"
 #include "Video.hpp"
 
@@ -29,15 +30,20 @@
 
 //#define LOG_TRACE
 
+#include "../../../Components/5380/ncr5380.hpp"
 #include "../../../Components/6522/6522.hpp"
 #include "../../../Components/8530/z8530.hpp"
 #include "../../../Components/DiskII/IWM.hpp"
 #include "../../../Components/DiskII/MacintoshDoubleDensityDrive.hpp"
 #include "../../../Processors/68000/68000.hpp"
 
+#include "../../../Storage/MassStorage/SCSI/SCSI.hpp"
+#include "../../../Storage/MassStorage/SCSI/DirectAccessDevice.hpp"
+
 #include "../../../Analyser/Static/Macintosh/Target.hpp"
 
 #include "../../Utility/MemoryPacker.hpp"
+#include "../../Utility/ROMCache.hpp"
 #include "../../Utility/MemoryFuzzer.hpp"
 
 namespace {
@@ -68,6 +74,8 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 		 	video_(ram_, audio_, drive_speed_accumulator_),
 		 	via_(via_port_handler_),
 		 	via_port_handler_(*this, clock_, keyboard_, video_, audio_, iwm_, mouse_),
+		 	scsi_(scsi_bus_),
+		 	hard_drive_(scsi_bus_, 6),
 		 	drives_{
 		 		{CLOCK_RATE, model >= Analyser::Static::Macintosh::Target::Model::Mac512ke},
 		 		{CLOCK_RATE, model >= Analyser::Static::Macintosh::Target::Model::Mac512ke}
@@ -104,13 +112,21 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			rom_mask_ = (rom_size >> 1) - 1;
 			video_.set_ram_mask(ram_mask_);
 
-			// Grab a copy of the ROM and convert it into big-endian data.
-			const auto roms = rom_fetcher(rom_descriptions);
+			// Obtain the ROM as big-endian data; it's never written to, so the converted
+			// image is shared with any other Macintosh of the same model.
+			auto &rom_cache = ROMMachine::ROMCache::shared();
+			const auto roms = rom_cache.fetch(rom_fetcher, rom_descriptions);
 			if(!roms[0]) {
 				throw ROMMachine::Error::MissingROMs;
 			}
-			roms[0]->resize(rom_size);
-			Memory::PackBigEndian16(*roms[0], rom_);
+			rom_ = rom_cache.transformed<std::vector<uint16_t>>(roms[0], "big-endian-16/" + std::to_string(rom_size), [rom_size] (const std::vector<uint8_t> &source) {
+				std::vector<uint8_t> resized_source(source);
+				resized_source.resize(rom_size);
+
+				std::vector<uint16_t> rom(rom_size >> 1);
+				Memory::PackBigEndian16(resized_source, rom.data());
+				return rom;
+			});
 
 			// Randomise memory contents.
 			Memory::Fuzz(ram_, sizeof(ram_) / sizeof(*ram_));
@@ -179,10 +195,59 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			// lowest explicit address lines.
 			if(!cycle.data_select_active() || (cycle.operation & Microcycle::InterruptAcknowledge)) return HalfCycles(0);
 
-			// Grab the word-precision address being accessed.
-			uint16_t *memory_base = nullptr;
+			// Ordinary RAM and ROM accesses are resolved directly via the page table;
+			// anything without a pointer for this direction of access is left to the
+			// device switch below.
+			const MemoryPage &page = memory_map_->pages[word_address >> 18];
+			const uint16_t *const read_base = page.read;
+			uint16_t *const write_base = page.write;
 			HalfCycles delay;
-			switch(memory_map_[word_address >> 18]) {
+			if((cycle.operation & Microcycle::Read) ? read_base : write_base) {
+				if(page.is_ram) {
+					// This is coupled with the Macintosh implementation of video; the magic
+					// constant should probably be factored into the Video class.
+					// It embodies knowledge of the fact that video (and audio) will always
+					// be fetched from the final $d900 bytes (i.e. $6c80 words) of memory.
+					// (And that ram_mask_ = ram size - 1).
+					if(word_address > ram_mask_ - 0x6c80)
+						update_video();
+
+					// Apply a delay due to video contention if applicable; technically this is
+					// incorrectly placed — strictly speaking here I'm extending the part of the
+					// bus cycle after DTACK rather than delaying DTACK. But it adds up to the
+					// same thing.
+					if(ram_subcycle_ < 4) {
+						delay = HalfCycles(4 - ram_subcycle_);
+						advance_time(delay);
+					}
+				}
+				word_address &= page.mask;
+
+				switch(cycle.operation & (Microcycle::SelectWord | Microcycle::SelectByte | Microcycle::Read)) {
+					default:
+					break;
+
+					case Microcycle::SelectWord | Microcycle::Read:
+						cycle.value->full = read_base[word_address];
+					break;
+					case Microcycle::SelectByte | Microcycle::Read:
+						cycle.value->halves.low = uint8_t(read_base[word_address] >> cycle.byte_shift());
+					break;
+					case Microcycle::SelectWord:
+						write_base[word_address] = cycle.value->full;
+					break;
+					case Microcycle::SelectByte:
+						write_base[word_address] = uint16_t(
+							(cycle.value->halves.low << cycle.byte_shift()) |
+							(write_base[word_address] & cycle.untouched_byte_mask())
+						);
+					break;
+				}
+
+				return delay;
+			}
+
+			switch(memory_map_->devices[word_address >> 18]) {
 				default: assert(false);
 
 				case BusDevice::Unassigned:
@@ -271,58 +336,35 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 					}
 				} return delay;
 
-				case BusDevice::RAM: {
-					// This is coupled with the Macintosh implementation of video; the magic
-					// constant should probably be factored into the Video class.
-					// It embodies knowledge of the fact that video (and audio) will always
-					// be fetched from the final $d900 bytes (i.e. $6c80 words) of memory.
-					// (And that ram_mask_ = ram size - 1).
-					if(word_address > ram_mask_ - 0x6c80)
-						update_video();
+				case BusDevice::SCSI: {
+					// The 5380's registers are spaced out by 16 bytes; address bit 9
+					// indicates DMA acknowledge. Reads take data from the upper byte of
+					// the data bus, writes provide it on the lower.
+					const int register_address = word_address >> 3;
+					const bool dma_acknowledge = word_address & 0x100;
 
-					memory_base = ram_;
-					word_address &= ram_mask_;
-
-					// Apply a delay due to video contention if applicable; technically this is
-					// incorrectly placed — strictly speaking here I'm extending the part of the
-					// bus cycle after DTACK rather than delaying DTACK. But it adds up to the
-					// same thing.
-					if(ram_subcycle_ < 4) {
-						delay = HalfCycles(4 - ram_subcycle_);
-						advance_time(delay);
+					if(cycle.operation & Microcycle::Read) {
+						const uint8_t result = scsi_.read(register_address, dma_acknowledge);
+						if(cycle.operation & Microcycle::SelectWord) {
+							cycle.value->halves.high = result;
+							cycle.value->halves.low = 0xff;
+						} else {
+							cycle.value->halves.low = result;
+						}
+					} else {
+						scsi_.write(register_address, cycle.value->halves.low, dma_acknowledge);
 					}
-				} break;
-
-				case BusDevice::ROM: {
-					if(!(cycle.operation & Microcycle::Read)) return delay;
-					memory_base = rom_;
-					word_address &= rom_mask_;
-				} break;
-			}
+				} return delay;
 
-			// If control has fallen through to here, the access is either a read from ROM, or a read or write to RAM.
-			switch(cycle.operation & (Microcycle::SelectWord | Microcycle::SelectByte | Microcycle::Read)) {
-				default:
-				break;
+				case BusDevice::ROM:
+					// Writes to ROM are ignored; reads are always handled by the page table.
+				return delay;
 
-				case Microcycle::SelectWord | Microcycle::Read:
-					cycle.value->full = memory_base[word_address];
-				break;
-				case Microcycle::SelectByte | Microcycle::Read:
-					cycle.value->halves.low = uint8_t(memory_base[word_address] >> cycle.byte_shift());
-				break;
-				case Microcycle::SelectWord:
-					memory_base[word_address] = cycle.value->full;
-				break;
-				case Microcycle::SelectByte:
-					memory_base[word_address] = uint16_t(
-						(cycle.value->halves.low << cycle.byte_shift()) |
-						(memory_base[word_address] & cycle.untouched_byte_mask())
-					);
-				break;
+				case BusDevice::RAM:
+					// RAM is always handled by the page table.
+					assert(false);
+				return delay;
 			}
-
-			return delay;
 		}
 
 		void flush() {
@@ -342,48 +384,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 
 		void set_rom_is_overlay(bool rom_is_overlay) {
 			ROM_is_overlay_ = rom_is_overlay;
-
-			using Model = Analyser::Static::Macintosh::Target::Model;
-			switch(model) {
-				case Model::Mac128k:
-				case Model::Mac512k:
-				case Model::Mac512ke:
-					populate_memory_map([rom_is_overlay] (std::function<void(int target, BusDevice device)> map_to) {
-						// Addresses up to $80 0000 aren't affected by this bit.
-						if(rom_is_overlay) {
-							// Up to $60 0000 mirrors of the ROM alternate with unassigned areas every $10 0000 byes.
-							for(int c = 0; c <= 0x600000; c += 0x100000) {
-								map_to(c, ((c >> 20)&1) ? BusDevice::ROM : BusDevice::Unassigned);
-							}
-							map_to(0x800000, BusDevice::RAM);
-						} else {
-							map_to(0x400000, BusDevice::RAM);
-							map_to(0x500000, BusDevice::ROM);
-							map_to(0x800000, BusDevice::Unassigned);
-						}
-					});
-				break;
-
-				case Model::MacPlus:
-					populate_memory_map([rom_is_overlay] (std::function<void(int target, BusDevice device)> map_to) {
-						// Addresses up to $80 0000 aren't affected by this bit.
-						if(rom_is_overlay) {
-							map_to(0x100000, BusDevice::ROM);
-							map_to(0x400000, BusDevice::Unassigned);
-							map_to(0x500000, BusDevice::ROM);
-							map_to(0x580000, BusDevice::Unassigned);
-							map_to(0x600000, BusDevice::SCSI);
-							map_to(0x800000, BusDevice::RAM);
-						} else {
-							map_to(0x400000, BusDevice::RAM);
-							map_to(0x500000, BusDevice::ROM);
-							map_to(0x580000, BusDevice::Unassigned);
-							map_to(0x600000, BusDevice::SCSI);
-							map_to(0x800000, BusDevice::Unassigned);
-						}
-					});
-				break;
-			}
+			memory_map_ = &memory_maps_[rom_is_overlay ? 1 : 0];
 		}
 
 		bool video_is_outputting() {
@@ -396,16 +397,23 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 		}
 
 		bool insert_media(const Analyser::Static::Media &media) override {
-			if(media.disks.empty())
+			if(media.disks.empty() && media.mass_storage_devices.empty())
 				return false;
 
 			// TODO: shouldn't allow disks to be replaced like this, as the Mac
 			// uses software eject. Will need to expand messaging ability of
 			// insert_media.
-			if(drives_[0].has_disk())
-				drives_[1].set_disk(media.disks[0]);
-			else
-				drives_[0].set_disk(media.disks[0]);
+			if(!media.disks.empty()) {
+				if(drives_[0].has_disk())
+					drives_[1].set_disk(media.disks[0]);
+				else
+					drives_[0].set_disk(media.disks[0]);
+			}
+
+			// Attach the hard drive if there is one; only the Plus has SCSI.
+			if(!media.mass_storage_devices.empty() && model == Analyser::Static::Macintosh::Target::Model::MacPlus) {
+				hard_drive_.set_storage(media.mass_storage_devices.front());
+			}
 
 			return true;
 		}
@@ -447,7 +455,14 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 
 	private:
 		void drive_speed_accumulator_set_drive_speed(DriveSpeedAccumulator *, float speed) override {
-			iwm_.flush();
+			// The IWM needs to be brought up to date only if a drive is spinning; a stationary drive
+			// isn't clocked by the IWM, so a change in its speed can't affect anything already elapsed.
+			if(
+				drives_[0].preferred_clocking() != ClockingHint::Preference::None ||
+				drives_[1].preferred_clocking() != ClockingHint::Preference::None
+			) {
+				iwm_.flush();
+			}
 			drives_[0].set_rotation_speed(speed);
 			drives_[1].set_rotation_speed(speed);
 		}
@@ -673,6 +688,10 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 
  		Zilog::SCC::z8530 scc_;
 
+		SCSI::Bus scsi_bus_;
+		NCR::NCR5380::NCR5380 scsi_;
+		SCSI::DirectAccessDevice hard_drive_;
+
  		HalfCycles via_clock_;
  		HalfCycles real_time_clock_;
  		HalfCycles keyboard_clock_;
@@ -689,86 +708,23 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 
 		Apple::Macintosh::KeyboardMapper keyboard_mapper_;
 
-		enum class BusDevice {
-			RAM, ROM, VIA, IWM, SCCWrite, SCCReadResetPhase, SCSI, PhaseRead, Unassigned
-		};
-
-		/// Divides the 24-bit address space up into $80000 (i.e. 512kb) segments, recording
-		/// which device is current mapped in each area. Keeping it in a table is a bit faster
-		/// than the multi-level address inspection that is otherwise required, as well as
-		/// simplifying slightly the handling of different models.
-		///
-		/// So: index with the top 5 bits of the 24-bit address.
-		BusDevice memory_map_[32];
+		/// Both possible memory maps: [0] is the ordinary map, [1] is that with the ROM overlay enabled.
+		MemoryMap memory_maps_[2];
+		const MemoryMap *memory_map_ = &memory_maps_[1];
 
 		void setup_memory_map() {
-			// Apply the power-up memory map, i.e. assume that ROM_is_overlay_ = true.
-
-			using Model = Analyser::Static::Macintosh::Target::Model;
-			switch(model) {
-				default: assert(false);
-
-				case Model::Mac128k:
-				case Model::Mac512k:
-				case Model::Mac512ke:
-					populate_memory_map([] (std::function<void(int target, BusDevice device)> map_to) {
-						// Up to $60 0000 mirrors of the ROM alternate with unassigned areas every $10 0000 byes.
-						for(int c = 0; c <= 0x600000; c += 0x100000) {
-							map_to(c, ((c >> 20)&1) ? BusDevice::ROM : BusDevice::Unassigned);
-						}
-						map_to(0x800000, BusDevice::RAM);
-						map_to(0x900000, BusDevice::Unassigned);
-						map_to(0xa00000, BusDevice::SCCReadResetPhase);
-						map_to(0xb00000, BusDevice::Unassigned);
-						map_to(0xc00000, BusDevice::SCCWrite);
-						map_to(0xd00000, BusDevice::Unassigned);
-						map_to(0xe00000, BusDevice::IWM);
-						map_to(0xe80000, BusDevice::Unassigned);
-						map_to(0xf00000, BusDevice::VIA);
-						map_to(0xf80000, BusDevice::PhaseRead);
-						map_to(0x1000000, BusDevice::Unassigned);
-					});
-				break;
-
-				case Model::MacPlus:
-					populate_memory_map([] (std::function<void(int target, BusDevice device)> map_to) {
-						map_to(0x100000, BusDevice::ROM);
-						map_to(0x400000, BusDevice::Unassigned);
-						map_to(0x500000, BusDevice::ROM);
-						map_to(0x580000, BusDevice::Unassigned);
-						map_to(0x600000, BusDevice::SCSI);
-						map_to(0x800000, BusDevice::RAM);
-						map_to(0x900000, BusDevice::Unassigned);
-						map_to(0xa00000, BusDevice::SCCReadResetPhase);
-						map_to(0xb00000, BusDevice::Unassigned);
-						map_to(0xc00000, BusDevice::SCCWrite);
-						map_to(0xd00000, BusDevice::Unassigned);
-						map_to(0xe00000, BusDevice::IWM);
-						map_to(0xe80000, BusDevice::Unassigned);
-						map_to(0xf00000, BusDevice::VIA);
-						map_to(0xf80000, BusDevice::PhaseRead);
-						map_to(0x1000000, BusDevice::Unassigned);
-					});
-				break;
-			}
-		}
+			// Build both the ordinary and the overlay memory maps now, so that changes
+			// in ROM_is_overlay_ are just a matter of picking a different map.
+			memory_maps_[0].populate(model, false, ram_, ram_mask_, rom_->data(), rom_mask_);
+			memory_maps_[1].populate(model, true, ram_, ram_mask_, rom_->data(), rom_mask_);
 
-		void populate_memory_map(std::function<void(std::function<void(int, BusDevice)>)> populator) {
-			// Define semantics for below; map_to will write from the current cursor position
-			// to the supplied 24-bit address, setting a particular mapped device.
-			int segment = 0;
-			auto map_to = [&segment, this](int address, BusDevice device) {
-				for(; segment < address >> 19; ++segment) {
-					this->memory_map_[segment] = device;
-				}
-			};
-
-			populator(map_to);
+			// Apply the power-up memory map, i.e. assume that ROM_is_overlay_ = true.
+			set_rom_is_overlay(true);
 		}
 
 		uint32_t ram_mask_ = 0;
 		uint32_t rom_mask_ = 0;
-		uint16_t rom_[64*1024];
+		std::shared_ptr<const std::vector<uint16_t>> rom_;
 		uint16_t ram_[256*1024];
 };
 
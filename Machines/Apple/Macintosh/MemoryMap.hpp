@@ -0,0 +1,133 @@
+//
+//  MemoryMap.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef Apple_Macintosh_MemoryMap_hpp
+#define Apple_Macintosh_MemoryMap_hpp
+
+#include <cassert>
+#include <cstdint>
+
+#include "../../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../../Analyser/Static/Macintosh/Target.hpp"
+
+namespace Apple {
+namespace Macintosh {
+
+/// Enumerates the devices that may be mapped into a Macintosh's address space.
+enum class BusDevice {
+	RAM, ROM, VIA, IWM, SCCWrite, SCCReadResetPhase, SCSI, PhaseRead, Unassigned
+};
+
+/// Describes direct access to a single $80000-byte segment of the address space:
+/// the bases to use for reads and writes, or nullptr if this type of access isn't
+/// a plain memory access, and the mask to apply to a word address.
+struct MemoryPage {
+	const uint16_t *read = nullptr;
+	uint16_t *write = nullptr;
+	uint32_t mask = 0;
+	bool is_ram = false;
+};
+
+/// Divides the 24-bit address space up into $80000 (i.e. 512kb) segments, recording
+/// which device is current mapped in each area and, for RAM and ROM, a MemoryPage that
+/// allows accesses to be performed without further inspection. Keeping it in a table is
+/// a bit faster than the multi-level address inspection that is otherwise required, as
+/// well as simplifying slightly the handling of different models.
+///
+/// So: index with the top 5 bits of the 24-bit address.
+struct MemoryMap {
+	BusDevice devices[32];
+	MemoryPage pages[32];
+
+	/*!
+		Fills in this map as appropriate to @c model with the ROM overlay either enabled or disabled,
+		for RAM at @c ram and ROM at @c rom. Word addresses within those are masked with @c ram_mask and
+		@c rom_mask respectively.
+
+		Writes to ROM are left to the device decode.
+	*/
+	void populate(Analyser::Static::Macintosh::Target::Model model, bool rom_is_overlay, uint16_t *ram, uint32_t ram_mask, const uint16_t *rom, uint32_t rom_mask) {
+		// Define semantics for below; map_to will write from the current cursor position
+		// to the supplied 24-bit address, setting a particular mapped device.
+		int segment = 0;
+		auto map_to = [&segment, ram, ram_mask, rom, rom_mask, this](int address, BusDevice device) {
+			for(; segment < address >> 19; ++segment) {
+				devices[segment] = device;
+
+				MemoryPage &page = pages[segment];
+				page = MemoryPage();
+				switch(device) {
+					default: break;
+					case BusDevice::RAM:
+						page.read = page.write = ram;
+						page.mask = ram_mask;
+						page.is_ram = true;
+					break;
+					case BusDevice::ROM:
+						page.read = rom;
+						page.mask = rom_mask;
+					break;
+				}
+			}
+		};
+
+		using Model = Analyser::Static::Macintosh::Target::Model;
+		switch(model) {
+			default: assert(false);
+
+			case Model::Mac128k:
+			case Model::Mac512k:
+			case Model::Mac512ke:
+				if(rom_is_overlay) {
+					// Up to $60 0000 mirrors of the ROM alternate with unassigned areas every $10 0000 byes.
+					for(int c = 0; c <= 0x600000; c += 0x100000) {
+						map_to(c, ((c >> 20)&1) ? BusDevice::ROM : BusDevice::Unassigned);
+					}
+					map_to(0x800000, BusDevice::RAM);
+				} else {
+					map_to(0x400000, BusDevice::RAM);
+					map_to(0x500000, BusDevice::ROM);
+					map_to(0x800000, BusDevice::Unassigned);
+				}
+			break;
+
+			case Model::MacPlus:
+				if(rom_is_overlay) {
+					map_to(0x100000, BusDevice::ROM);
+					map_to(0x400000, BusDevice::Unassigned);
+					map_to(0x500000, BusDevice::ROM);
+					map_to(0x580000, BusDevice::Unassigned);
+					map_to(0x600000, BusDevice::SCSI);
+					map_to(0x800000, BusDevice::RAM);
+				} else {
+					map_to(0x400000, BusDevice::RAM);
+					map_to(0x500000, BusDevice::ROM);
+					map_to(0x580000, BusDevice::Unassigned);
+					map_to(0x600000, BusDevice::SCSI);
+					map_to(0x800000, BusDevice::Unassigned);
+				}
+			break;
+		}
+
+		// Addresses from $80 0000 upward aren't affected by the overlay, and are the same for all models.
+		map_to(0x900000, BusDevice::Unassigned);
+		map_to(0xa00000, BusDevice::SCCReadResetPhase);
+		map_to(0xb00000, BusDevice::Unassigned);
+		map_to(0xc00000, BusDevice::SCCWrite);
+		map_to(0xd00000, BusDevice::Unassigned);
+		map_to(0xe00000, BusDevice::IWM);
+		map_to(0xe80000, BusDevice::Unassigned);
+		map_to(0xf00000, BusDevice::VIA);
+		map_to(0xf80000, BusDevice::PhaseRead);
+		map_to(0x1000000, BusDevice::Unassigned);
+	}
+};
+
+}
+}
+
+#endif /* Apple_Macintosh_MemoryMap_hpp */
@@ -36,7 +36,7 @@ const int sync_end = 38;
 Video::Video(uint16_t *ram, DeferredAudio &audio, DriveSpeedAccumulator &drive_speed_accumulator) :
 	audio_(audio),
 	drive_speed_accumulator_(drive_speed_accumulator),
- 	crt_(704, 1, 370, Outputs::Display::ColourSpace::YIQ, 1, 1, 6, false, Outputs::Display::InputDataType::Luminance1),
+ 	crt_(704, 1, 370, Outputs::Display::ColourSpace::YIQ, 1, 1, 6, false, Outputs::Display::InputDataType::PackedLuminance1),
  	ram_(ram) {
 
  	crt_.set_display_type(Outputs::Display::DisplayType::RGB);
@@ -88,29 +88,14 @@ void Video::run_for(HalfCycles duration) {
 
 					if(pixel_buffer_) {
 						for(int c = first_word; c < final_pixel_word; ++c) {
-							uint16_t pixels = ram_[video_base + video_address_] ^ 0xffff;
+							// Pixels are packed MSB first, as required; the Mac just treats
+							// a set bit as black rather than white.
+							const uint16_t pixels = ram_[video_base + video_address_] ^ 0xffff;
 							++video_address_;
 
-							pixel_buffer_[15] = pixels & 0x01;
-							pixel_buffer_[14] = pixels & 0x02;
-							pixel_buffer_[13] = pixels & 0x04;
-							pixel_buffer_[12] = pixels & 0x08;
-							pixel_buffer_[11] = pixels & 0x10;
-							pixel_buffer_[10] = pixels & 0x20;
-							pixel_buffer_[9] = pixels & 0x40;
-							pixel_buffer_[8] = pixels & 0x80;
-
-							pixels >>= 8;
-							pixel_buffer_[7] = pixels & 0x01;
-							pixel_buffer_[6] = pixels & 0x02;
-							pixel_buffer_[5] = pixels & 0x04;
-							pixel_buffer_[4] = pixels & 0x08;
-							pixel_buffer_[3] = pixels & 0x10;
-							pixel_buffer_[2] = pixels & 0x20;
-							pixel_buffer_[1] = pixels & 0x40;
-							pixel_buffer_[0] = pixels & 0x80;
-
-							pixel_buffer_ += 16;
+							pixel_buffer_[0] = uint8_t(pixels >> 8);
+							pixel_buffer_[1] = uint8_t(pixels);
+							pixel_buffer_ += 2;
 						}
 					}
 
@@ -81,6 +81,7 @@ namespace Serial {
 			*/
 			void set_output(Line line, LineLevel level) {
 				if(line_levels_[line] != level) {
+					will_change_output(line);
 					line_levels_[line] = level;
 					std::shared_ptr<Bus> bus = serial_bus_.lock();
 					if(bus) bus->set_line_output_did_change(line);
@@ -106,6 +107,14 @@ namespace Serial {
 				serial_bus_ = serial_bus;
 			}
 
+		protected:
+			/*!
+				Called immediately before a change to the output level of @c line is recorded and propagated to
+				the bus. Subclasses whose bus partners run on other threads may use this as an opportunity to
+				bring them up to date before the change becomes visible. The default implementation does nothing.
+			*/
+			virtual void will_change_output(Line line) {}
+
 		private:
 			std::weak_ptr<Bus> serial_bus_;
 			LineLevel line_levels_[5];
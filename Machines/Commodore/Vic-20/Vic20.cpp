@@ -33,6 +33,8 @@
 
 #include "../../../Configurable/StandardOptions.hpp"
 
+#include "../../../Concurrency/AsyncTaskQueue.hpp"
+
 #include "../../../Analyser/Static/Commodore/Target.hpp"
 
 #include <algorithm>
@@ -50,9 +52,11 @@ enum ROMSlot {
 };
 
 std::vector<std::unique_ptr<Configurable::Option>> get_options() {
-	return Configurable::standard_options(
+	auto options = Configurable::standard_options(
 		static_cast<Configurable::StandardOptions>(Configurable::DisplaySVideo | Configurable::DisplayCompositeColour | Configurable::QuickLoadTape)
 	);
+	options.emplace_back(new Configurable::BooleanOption("Run Disk Drive on Separate Thread", "threadeddrive"));
+	return options;
 }
 
 enum JoystickInput {
@@ -70,7 +74,7 @@ enum JoystickInput {
 */
 class UserPortVIA: public MOS::MOS6522::IRQDelegatePortHandler {
 	public:
-		UserPortVIA() : port_a_(0xbf) {}
+		UserPortVIA() : port_a_(0xbc) {}
 
 		/// Reports the current input to the 6522 port @c port.
 		uint8_t get_port_input(MOS::MOS6522::Port port) {
@@ -78,7 +82,7 @@ class UserPortVIA: public MOS::MOS6522::IRQDelegatePortHandler {
 			// the joystick and serial port state, both of which have been statefully collected
 			// into port_a_.
 			if(!port) {
-				return port_a_ | (tape_->has_tape() ? 0x00 : 0x40);
+				return port_a_ | serial_port_a_ | (tape_->has_tape() ? 0x00 : 0x40);
 			}
 			return 0xff;
 		}
@@ -92,11 +96,12 @@ class UserPortVIA: public MOS::MOS6522::IRQDelegatePortHandler {
 		}
 
 		/// Receives announcements of changes in the serial bus connected to the serial port and propagates them into Port A.
+		/// This state is kept apart from port_a_ as it may be set from the disk drive's thread.
 		void set_serial_line_state(::Commodore::Serial::Line line, bool value) {
 			switch(line) {
 				default: break;
-				case ::Commodore::Serial::Line::Data: port_a_ = (port_a_ & ~0x02) | (value ? 0x02 : 0x00);	break;
-				case ::Commodore::Serial::Line::Clock: port_a_ = (port_a_ & ~0x01) | (value ? 0x01 : 0x00);	break;
+				case ::Commodore::Serial::Line::Data: serial_port_a_ = (serial_port_a_ & ~0x02) | (value ? 0x02 : 0x00);	break;
+				case ::Commodore::Serial::Line::Clock: serial_port_a_ = (serial_port_a_ & ~0x01) | (value ? 0x01 : 0x00);	break;
 			}
 		}
 
@@ -128,6 +133,7 @@ class UserPortVIA: public MOS::MOS6522::IRQDelegatePortHandler {
 
 	private:
 		uint8_t port_a_;
+		uint8_t serial_port_a_ = 0x03;
 		std::weak_ptr<::Commodore::Serial::Port> serial_port_;
 		std::shared_ptr<Storage::Tape::BinaryTapePlayer> tape_;
 };
@@ -212,6 +218,17 @@ class KeyboardVIA: public MOS::MOS6522::IRQDelegatePortHandler {
 */
 class SerialPort : public ::Commodore::Serial::Port {
 	public:
+		class Delegate {
+			public:
+				/// Announces that the Vic is about to change an output line on the serial bus.
+				virtual void serial_port_will_change_output(SerialPort *port) = 0;
+		};
+
+		/// Sets the delegate that will be notified of impending output changes.
+		void set_delegate(Delegate *delegate) {
+			delegate_ = delegate;
+		}
+
 		/// Receives an input change from the base serial port class, and communicates it to the user-port VIA.
 		void set_input(::Commodore::Serial::Line line, ::Commodore::Serial::LineLevel level) {
 			std::shared_ptr<UserPortVIA> userPortVIA = user_port_via_.lock();
@@ -223,8 +240,14 @@ class SerialPort : public ::Commodore::Serial::Port {
 			user_port_via_ = userPortVIA;
 		}
 
+	protected:
+		void will_change_output(::Commodore::Serial::Line line) override {
+			if(delegate_) delegate_->serial_port_will_change_output(this);
+		}
+
 	private:
 		std::weak_ptr<UserPortVIA> user_port_via_;
+		Delegate *delegate_ = nullptr;
 };
 
 /*!
@@ -289,6 +312,7 @@ class ConcreteMachine:
 	public MOS::MOS6522::IRQDelegatePortHandler::Delegate,
 	public Utility::TypeRecipient,
 	public Storage::Tape::BinaryTapePlayer::Delegate,
+	public SerialPort::Delegate,
 	public Machine,
 	public ClockingHint::Observer,
 	public Activity::Source {
@@ -376,6 +400,9 @@ class ConcreteMachine:
 
 				// give it a little warm up
 				c1540_->run_for(Cycles(2000000));
+
+				// listen for serial output changes, in case the drive is later moved to its own thread
+				serial_port_->set_delegate(this);
 			}
 
 			// Determine PAL/NTSC
@@ -465,6 +492,7 @@ class ConcreteMachine:
 			}
 
 			if(!media.disks.empty() && c1540_) {
+				synchronise_c1540();
 				c1540_->set_disk(media.disks.front());
 			}
 
@@ -511,7 +539,12 @@ class ConcreteMachine:
 						update_video();
 						result &= mos6560_.get_register(address);
 					}
-					if(address & 0x10) result &= user_port_via_.get_register(address);
+					if(address & 0x10) {
+						// Port A of the user-port VIA senses the serial bus, so if the drive is running
+						// separately then it needs to be brought up to date before that can be read.
+						if((address & 0xf) == 0x1 || (address & 0xf) == 0xf) synchronise_c1540();
+						result &= user_port_via_.get_register(address);
+					}
 					if(address & 0x20) result &= keyboard_via_.get_register(address);
 				}
 				*value = result;
@@ -614,7 +647,14 @@ class ConcreteMachine:
 				}
 			}
 			if(!tape_is_sleeping_ && !hold_tape_) tape_->run_for(Cycles(1));
-			if(c1540_) c1540_->run_for(Cycles(1));
+			if(c1540_) {
+				if(c1540_queue_) {
+					++cycles_since_c1540_update_;
+					if(cycles_since_c1540_update_.as_int() >= c1540_lookahead) post_c1540_cycles();
+				} else {
+					c1540_->run_for(Cycles(1));
+				}
+			}
 
 			return Cycles(1);
 		}
@@ -626,6 +666,7 @@ class ConcreteMachine:
 
 		void run_for(const Cycles cycles) override final {
 			m6502_.run_for(cycles);
+			synchronise_c1540();
 		}
 
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) override final {
@@ -674,12 +715,18 @@ class ConcreteMachine:
 			if(Configurable::get_display(selections_by_option, display)) {
 				set_video_signal_configurable(display);
 			}
+
+			auto threaded_drive = Configurable::selection<Configurable::BooleanSelection>(selections_by_option, "threadeddrive");
+			if(threaded_drive) {
+				set_use_threaded_drive(threaded_drive->value);
+			}
 		}
 
 		Configurable::SelectionSet get_accurate_selections() override {
 			Configurable::SelectionSet selection_set;
 			Configurable::append_quick_load_tape_selection(selection_set, false);
 			Configurable::append_display_selection(selection_set, Configurable::Display::CompositeColour);
+			selection_set["threadeddrive"] = std::unique_ptr<Configurable::Selection>(new Configurable::BooleanSelection(false));
 			return selection_set;
 		}
 
@@ -687,6 +734,7 @@ class ConcreteMachine:
 			Configurable::SelectionSet selection_set;
 			Configurable::append_quick_load_tape_selection(selection_set, true);
 			Configurable::append_display_selection(selection_set, Configurable::Display::SVideo);
+			selection_set["threadeddrive"] = std::unique_ptr<Configurable::Selection>(new Configurable::BooleanSelection(false));
 			return selection_set;
 		}
 
@@ -697,9 +745,29 @@ class ConcreteMachine:
 
 		// MARK: - Activity Source
 		void set_activity_observer(Activity::Observer *observer) override {
+			synchronise_c1540();
 			if(c1540_) c1540_->set_activity_observer(observer);
 		}
 
+		// MARK: - Debugging and testing
+		void attach_serial_port(const std::shared_ptr<::Commodore::Serial::Port> &port) override {
+			synchronise_c1540();
+			::Commodore::Serial::AttachPortAndBus(port, serial_bus_);
+		}
+
+		uint16_t get_value_of_register(CPU::MOS6502::Register reg) override {
+			return m6502_.get_value_of_register(reg);
+		}
+
+		uint8_t get_memory_value(uint16_t address) override {
+			return processor_read_memory_map_[address >> 10] ? processor_read_memory_map_[address >> 10][address & 0x3ff] : 0xff;
+		}
+
+		// MARK: - Serial port delegate
+		void serial_port_will_change_output(SerialPort *) override final {
+			synchronise_c1540();
+		}
+
 	private:
 		void update_video() {
 			mos6560_.run_for(cycles_since_mos6560_update_.flush<Cycles>());
@@ -753,6 +821,51 @@ class ConcreteMachine:
 
 		// Disk
 		std::shared_ptr<::Commodore::C1540::Machine> c1540_;
+
+		/*
+			The C1540 can optionally be run on a separate thread. If so then it trails the Vic: the Vic accumulates
+			cycles_since_c1540_update_ and posts them to c1540_queue_ in batches, and the two are synchronised
+			exactly whenever the Vic changes a serial output or reads the user-port VIA's port A — the only
+			points at which either side can observe the other. Drive output changes propagate into the user-port
+			VIA from the drive's thread, but that state is observed only after synchronisation.
+
+			So the lookahead can't affect IEC handshake timing: the drive never runs ahead of the Vic, only ever
+			runs cycles that the Vic has already completed, and is brought fully up to date before the Vic samples
+			or changes a line. Each batch is also run a cycle at a time, exactly as in lockstep, since the drive's
+			run_for otherwise clocks its CPU and its disk separately for the whole period. At any point at which
+			the two can observe each other, each is therefore in exactly the state it would have reached in
+			lockstep; c1540_lookahead just bounds how far the drive may lag, and how much work each task carries.
+		*/
+		static const int c1540_lookahead = 512;
+		Cycles cycles_since_c1540_update_;
+		std::unique_ptr<Concurrency::AsyncTaskQueue> c1540_queue_;
+
+		void post_c1540_cycles() {
+			if(!cycles_since_c1540_update_) return;
+			const Cycles cycles = cycles_since_c1540_update_.flush<Cycles>();
+			::Commodore::C1540::Machine *const c1540 = c1540_.get();
+			c1540_queue_->enqueue([c1540, cycles] {
+				for(int c = 0; c < cycles.as_int(); ++c) {
+					c1540->run_for(Cycles(1));
+				}
+			});
+		}
+
+		void synchronise_c1540() {
+			if(!c1540_queue_) return;
+			post_c1540_cycles();
+			c1540_queue_->flush();
+		}
+
+		void set_use_threaded_drive(bool use_threaded_drive) {
+			if(!c1540_ || use_threaded_drive == !!c1540_queue_) return;
+			if(use_threaded_drive) {
+				c1540_queue_.reset(new Concurrency::AsyncTaskQueue);
+			} else {
+				synchronise_c1540();
+				c1540_queue_.reset();
+			}
+		}
 };
 
 }
@@ -12,6 +12,8 @@
 #include "../../../Configurable/Configurable.hpp"
 #include "../../../Analyser/Static/StaticAnalyser.hpp"
 #include "../../ROMMachine.hpp"
+#include "../SerialBus.hpp"
+#include "../../../Processors/6502/6502.hpp"
 
 #include <memory>
 #include <vector>
@@ -28,6 +30,15 @@ class Machine {
 
 		/// Creates and returns a Vic-20.
 		static Machine *Vic20(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher);
+
+		/// Attaches @c port to the serial bus shared by the Vic and any disk drive, e.g. in order to monitor bus activity.
+		virtual void attach_serial_port(const std::shared_ptr<::Commodore::Serial::Port> &port) = 0;
+
+		/// @returns The current value of @c reg within the Vic's 6502.
+		virtual uint16_t get_value_of_register(CPU::MOS6502::Register reg) = 0;
+
+		/// @returns The RAM or ROM value the Vic's 6502 would see at @c address, or 0xff if there is none; I/O isn't inspected.
+		virtual uint8_t get_memory_value(uint16_t address) = 0;
 };
 
 }
@@ -47,7 +47,8 @@ class ConcreteMachine:
 	public CPU::MOS6502::BusHandler,
 	public Tape::Delegate,
 	public Utility::TypeRecipient,
-	public Activity::Source {
+	public Activity::Source,
+	public ClockingHint::Observer {
 	public:
 		ConcreteMachine(const Analyser::Static::Acorn::Target &target, const ROMMachine::ROMFetcher &rom_fetcher) :
 				m6502_(*this),
@@ -59,6 +60,7 @@ class ConcreteMachine:
 				memset(roms_[c], 0xff, 16384);
 
 			tape_.set_delegate(this);
+			tape_.set_clocking_hint_observer(this);
 			set_clock_rate(2000000);
 
 			speaker_.set_input_rate(2000000 / SoundGenerator::clock_rate_divider);
@@ -89,6 +91,7 @@ class ConcreteMachine:
 
 			if(target.has_dfs || target.has_adfs) {
 				plus3_.reset(new Plus3);
+				plus3_->set_clocking_hint_observer(this);
 
 				if(target.has_dfs) {
 					set_rom(ROM::Slot0, *roms[dfs_rom_position], true);
@@ -349,7 +352,7 @@ class ConcreteMachine:
 			cycles_since_display_update_ += Cycles(static_cast<int>(cycles));
 			cycles_since_audio_update_ += Cycles(static_cast<int>(cycles));
 			if(cycles_since_audio_update_ > Cycles(16384)) update_audio();
-			tape_.run_for(Cycles(static_cast<int>(cycles)));
+			if(!tape_is_sleeping_) tape_.run_for(Cycles(static_cast<int>(cycles)));
 
 			cycles_until_display_interrupt_ -= cycles;
 			if(cycles_until_display_interrupt_ < 0) {
@@ -359,7 +362,7 @@ class ConcreteMachine:
 			}
 
 			if(typer_) typer_->run_for(Cycles(static_cast<int>(cycles)));
-			if(plus3_) plus3_->run_for(Cycles(4*static_cast<int>(cycles)));
+			if(plus3_ && !plus3_is_sleeping_) plus3_->run_for(Cycles(4*static_cast<int>(cycles)));
 			if(shift_restart_counter_) {
 				shift_restart_counter_ -= cycles;
 				if(shift_restart_counter_ <= 0) {
@@ -462,6 +465,12 @@ class ConcreteMachine:
 			}
 		}
 
+		// MARK: - ClockingHint::Observer
+		void set_component_prefers_clocking(ClockingHint::Source *component, ClockingHint::Preference clocking) override final {
+			tape_is_sleeping_ = tape_.preferred_clocking() == ClockingHint::Preference::None;
+			plus3_is_sleeping_ = !plus3_ || plus3_->preferred_clocking() == ClockingHint::Preference::None;
+		}
+
 	private:
 		enum class ROM {
 			Slot0 = 0,
@@ -572,6 +581,7 @@ class ConcreteMachine:
 
 		// Tape
 		Tape tape_;
+		bool tape_is_sleeping_ = true;
 		bool use_fast_tape_hack_ = false;
 		bool allow_fast_tape_hack_ = false;
 		void set_use_fast_tape_hack() {
@@ -581,6 +591,7 @@ class ConcreteMachine:
 
 		// Disk
 		std::unique_ptr<Plus3> plus3_;
+		bool plus3_is_sleeping_ = true;
 		bool is_holding_shift_ = false;
 		int shift_restart_counter_ = 0;
 
@@ -35,6 +35,10 @@ void SoundGenerator::skip_samples(std::size_t number_of_samples) {
 	counter_ = (counter_ + number_of_samples) % ((divider_+1) * 2);
 }
 
+bool SoundGenerator::is_zero_level() {
+	return !is_enabled_;
+}
+
 void SoundGenerator::set_divider(uint8_t divider) {
 	audio_queue_.defer([=]() {
 		divider_ = divider * 32 / clock_rate_divider;
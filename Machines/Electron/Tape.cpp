@@ -48,7 +48,27 @@ void Tape::clear_interrupts(uint8_t interrupts) {
 }
 
 void Tape::set_is_in_input_mode(bool is_in_input_mode) {
+	if(is_in_input_mode_ == is_in_input_mode) return;
 	is_in_input_mode_ = is_in_input_mode;
+	update_clocking_observer();
+}
+
+void Tape::set_is_running(bool is_running) {
+	if(is_running_ == is_running) return;
+	is_running_ = is_running;
+	update_clocking_observer();
+}
+
+void Tape::set_is_enabled(bool is_enabled) {
+	if(is_enabled_ == is_enabled) return;
+	is_enabled_ = is_enabled;
+	update_clocking_observer();
+}
+
+ClockingHint::Preference Tape::preferred_clocking() {
+	if(!is_enabled_) return ClockingHint::Preference::None;
+	if(!is_in_input_mode_) return ClockingHint::Preference::JustInTime;
+	return is_running_ ? TapePlayer::preferred_clocking() : ClockingHint::Preference::None;
 }
 
 void Tape::set_counter(uint8_t value) {
@@ -40,10 +40,13 @@ class Tape:
 		};
 		inline void set_delegate(Delegate *delegate) { delegate_ = delegate; }
 
-		inline void set_is_running(bool is_running) { is_running_ = is_running; }
-		inline void set_is_enabled(bool is_enabled) { is_enabled_ = is_enabled; }
+		void set_is_running(bool is_running);
+		void set_is_enabled(bool is_enabled);
 		void set_is_in_input_mode(bool is_in_input_mode);
 
+		/// As per ClockingHint::Source; the tape requires clocking only while enabled and either outputting or reading a running tape.
+		ClockingHint::Preference preferred_clocking() override;
+
 		void acorn_shifter_output_bit(int value);
 
 	private:
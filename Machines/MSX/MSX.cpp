@@ -610,6 +610,40 @@ class ConcreteMachine:
 			return addition;
 		}
 
+		HalfCycles perform_halted_fetches(int &count, HalfCycles time_available) {
+			// Don't race ahead of the fast-tape traps, and perform only those fetches that complete
+			// strictly before the next interrupt so that the Z80 observes it at exactly the usual time.
+			// Each fetch is eight half cycles plus the MSX's extra M1 wait.
+			if(use_fast_tape_) {
+				count = 0;
+				return HalfCycles(0);
+			}
+			count = std::min(count, time_available.as_int() / 10);
+			if(time_until_interrupt_ > 0) {
+				count = std::min(count, (time_until_interrupt_.as_int() - 1) / 10);
+			}
+			if(count <= 0) {
+				count = 0;
+				return HalfCycles(0);
+			}
+
+			const HalfCycles total_length(count * 10);
+			vdp_ += total_length;
+			time_since_ay_update_ += total_length;
+			memory_slots_[0].cycles_since_update += total_length;
+			memory_slots_[1].cycles_since_update += total_length;
+			memory_slots_[2].cycles_since_update += total_length;
+			memory_slots_[3].cycles_since_update += total_length;
+
+			if(!tape_player_is_sleeping_)
+				tape_player_.run_for(count * 8);
+
+			if(time_until_interrupt_ > 0) {
+				time_until_interrupt_ -= total_length;
+			}
+			return HalfCycles(count * 2);
+		}
+
 		void flush() {
 			vdp_.flush();
 			update_audio();
@@ -20,12 +20,13 @@
 #include "../../ClockReceiver/ForceInline.hpp"
 #include "../../ClockReceiver/JustInTime.hpp"
 
-#include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../Outputs/Speaker/Implementation/BLEPSpeaker.hpp"
 #include "../../Outputs/Log.hpp"
 
 #include "../../Analyser/Static/Sega/Target.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 
 namespace {
@@ -418,7 +419,7 @@ class ConcreteMachine:
 
 		Concurrency::DeferringAsyncTaskQueue audio_queue_;
 		TI::SN76489 sn76489_;
-		Outputs::Speaker::LowpassSpeaker<TI::SN76489> speaker_;
+		Outputs::Speaker::BLEPSpeaker<TI::SN76489> speaker_;
 
 		std::vector<std::unique_ptr<Inputs::Joystick>> joysticks_;
 		Inputs::Keyboard keyboard_;
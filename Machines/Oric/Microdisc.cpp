@@ -106,6 +106,7 @@ void Microdisc::set_head_load_request(bool head_load) {
 		head_load_request_counter_ = head_load_request_counter_target;
 		set_head_loaded(head_load);
 	}
+	update_clocking_observer();
 
 	if(observer_) {
 		observer_->set_led_status("Microdisc", head_load);
@@ -115,11 +116,19 @@ void Microdisc::set_head_load_request(bool head_load) {
 void Microdisc::run_for(const Cycles cycles) {
 	if(head_load_request_counter_ < head_load_request_counter_target) {
 		head_load_request_counter_ += cycles.as_int();
-		if(head_load_request_counter_ >= head_load_request_counter_target) set_head_loaded(true);
+		if(head_load_request_counter_ >= head_load_request_counter_target) {
+			set_head_loaded(true);
+			update_clocking_observer();
+		}
 	}
 	WD::WD1770::run_for(cycles);
 }
 
+ClockingHint::Preference Microdisc::preferred_clocking() {
+	if(head_load_request_counter_ < head_load_request_counter_target) return ClockingHint::Preference::RealTime;
+	return WD::WD1770::preferred_clocking();
+}
+
 bool Microdisc::get_drive_is_ready() {
 	return true;
 }
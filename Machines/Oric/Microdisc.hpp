@@ -28,6 +28,7 @@ class Microdisc: public WD::WD1770 {
 		bool get_interrupt_request_line();
 
 		void run_for(const Cycles cycles);
+		ClockingHint::Preference preferred_clocking() override;
 
 		enum PagingFlags {
 			/// Indicates that the BASIC ROM should be disabled; if this is set then either
@@ -34,6 +34,7 @@
 
 #include "../../Analyser/Static/Oric/Target.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -222,6 +223,8 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface> class Co
 			speaker_.set_input_rate(1000000.0f);
 			via_port_handler_.set_interrupt_delegate(this);
 			tape_player_.set_delegate(this);
+			tape_player_.set_clocking_hint_observer(this);
+			m6502_.set_idle_loop_detection(16);
 			Memory::Fuzz(ram_, sizeof(ram_));
 
 			if(disk_interface == Analyser::Static::Oric::Target::DiskInterface::Pravetz) {
@@ -288,6 +291,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface> class Co
 				case Analyser::Static::Oric::Target::DiskInterface::Microdisc:
 					microdisc_did_change_paging_flags(&microdisc_);
 					microdisc_.set_delegate(this);
+					microdisc_.set_clocking_hint_observer(this);
 				break;
 			}
 
@@ -445,11 +449,11 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface> class Co
 			}
 
 			via_.run_for(Cycles(1));
-			tape_player_.run_for(Cycles(1));
+			if(!tape_player_is_sleeping_) tape_player_.run_for(Cycles(1));
 			switch(disk_interface) {
 				default: break;
 				case Analyser::Static::Oric::Target::DiskInterface::Microdisc:
-					microdisc_.run_for(Cycles(8));
+					if(!microdisc_is_sleeping_) microdisc_.run_for(Cycles(8));
 				break;
 				case Analyser::Static::Oric::Target::DiskInterface::Pravetz:
 					if(diskii_clocking_preference_ == ClockingHint::Preference::RealTime) {
@@ -464,6 +468,33 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface> class Co
 			return Cycles(1);
 		}
 
+		Cycles perform_idle_loop(const CPU::MOS6502::IdleLoop &loop) {
+			// Decline if any other device might need to observe the loop, or if the loop touches
+			// anything other than plain RAM; the 0x0300 page holds the VIA and any disk interface.
+			// A running tape can signal the VIA at any time, so also decline if one is playing.
+			if(disk_interface != Analyser::Static::Oric::Target::DiskInterface::None) return Cycles(0);
+			if(string_serialiser_ || !tape_player_is_sleeping_) return Cycles(0);
+			if(loop.lowest_data_address <= loop.highest_data_address) {
+				if(loop.highest_data_address > ram_top_) return Cycles(0);
+				if(loop.highest_data_address >= 0x0300 && loop.lowest_data_address <= 0x03ff) return Cycles(0);
+			}
+
+			// The VIA is then the only thing that can disturb the loop; advance only by those
+			// iterations that end strictly before it next signals an interrupt, so that the
+			// 6502 observes the interrupt at exactly the usual time.
+			int iterations = loop.maximum_iterations;
+			const HalfCycles time_until_interrupt = via_.get_time_until_interrupt();
+			if(time_until_interrupt >= HalfCycles(0)) {
+				iterations = std::min(iterations, (time_until_interrupt - HalfCycles(1)).cycles().as_int() / loop.iteration_length.as_int());
+			}
+			if(iterations <= 0) return Cycles(0);
+
+			const Cycles duration(loop.iteration_length.as_int() * iterations);
+			via_.run_for(duration);
+			cycles_since_video_update_ += duration;
+			return duration;
+		}
+
 		forceinline void flush() {
 			update_video();
 			via_.flush();
@@ -572,6 +603,8 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface> class Co
 
 		void set_component_prefers_clocking(ClockingHint::Source *component, ClockingHint::Preference preference) override final {
 			diskii_clocking_preference_ = diskii_.preferred_clocking();
+			tape_player_is_sleeping_ = tape_player_.preferred_clocking() == ClockingHint::Preference::None;
+			microdisc_is_sleeping_ = microdisc_.preferred_clocking() == ClockingHint::Preference::None;
 		}
 
 	private:
@@ -622,6 +655,8 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface> class Co
 		std::vector<uint8_t> pravetz_rom_;
 		std::size_t pravetz_rom_base_pointer_ = 0;
 		ClockingHint::Preference diskii_clocking_preference_ = ClockingHint::Preference::RealTime;
+		bool tape_player_is_sleeping_ = false;
+		bool microdisc_is_sleeping_ = false;
 
 		// Overlay RAM
 		uint16_t ram_top_ = basic_visible_ram_top_;
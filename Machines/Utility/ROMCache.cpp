@@ -0,0 +1,99 @@
+//
+//  ROMCache.cpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#include "ROMCache.hpp"
+
+using namespace ROMMachine;
+
+namespace {
+
+std::string key(const ROM &rom) {
+	return rom.machine_name + "/" + rom.file_name;
+}
+
+}
+
+ROMCache &ROMCache::shared() {
+	static ROMCache cache;
+	return cache;
+}
+
+std::vector<SharedROM> ROMCache::fetch(const ROMFetcher &fetcher, const std::vector<ROM> &roms) {
+	std::vector<SharedROM> results(roms.size());
+	std::vector<ROM> missing_roms;
+	std::vector<std::size_t> missing_indices;
+
+	{
+		std::lock_guard<std::mutex> lock_guard(mutex_);
+
+		// Discard any images that are no longer in use.
+		for(auto iterator = images_.begin(); iterator != images_.end();) {
+			if(iterator->second.expired()) {
+				iterator = images_.erase(iterator);
+			} else {
+				++iterator;
+			}
+		}
+
+		for(std::size_t c = 0; c < roms.size(); ++c) {
+			const auto image = images_.find(key(roms[c]));
+			if(image != images_.end()) {
+				results[c] = image->second.lock();
+			}
+			if(!results[c]) {
+				missing_roms.push_back(roms[c]);
+				missing_indices.push_back(c);
+			}
+		}
+	}
+	if(missing_roms.empty()) return results;
+
+	// Fetch anything not currently cached without holding the lock, as the host may be slow to respond.
+	auto fetched_roms = fetcher(missing_roms);
+
+	std::lock_guard<std::mutex> lock_guard(mutex_);
+	for(std::size_t c = 0; c < missing_roms.size() && c < fetched_roms.size(); ++c) {
+		if(!fetched_roms[c]) continue;
+
+		// Another thread may have cached this image in the meantime, in which case prefer that copy.
+		auto &weak_image = images_[key(missing_roms[c])];
+		SharedROM image = weak_image.lock();
+		if(!image) {
+			image = std::move(fetched_roms[c]);
+			weak_image = image;
+		}
+		results[missing_indices[c]] = image;
+	}
+
+	return results;
+}
+
+std::shared_ptr<const void> ROMCache::find_transformed(const SharedROM &source, const std::string &name, const std::function<std::shared_ptr<const void>()> &transform) {
+	std::lock_guard<std::mutex> lock_guard(mutex_);
+
+	// Discard any images that are no longer in use, and look for this one amongst the remainder. A result
+	// holds its source, so its source can't have expired while it hasn't.
+	std::shared_ptr<const void> image;
+	for(auto iterator = transformed_images_.begin(); iterator != transformed_images_.end();) {
+		if(iterator->image.expired()) {
+			iterator = transformed_images_.erase(iterator);
+			continue;
+		}
+		if(
+			!image && iterator->name == name &&
+			!iterator->source.owner_before(source) && !source.owner_before(iterator->source)
+		) {
+			image = iterator->image.lock();
+		}
+		++iterator;
+	}
+	if(image) return image;
+
+	image = transform();
+	transformed_images_.push_back({source, name, image});
+	return image;
+}
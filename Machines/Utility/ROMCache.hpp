@@ -0,0 +1,82 @@
+//
+//  ROMCache.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef ROMCache_hpp
+#define ROMCache_hpp
+
+#include "../ROMMachine.hpp"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ROMMachine {
+
+/// A ROM image that may be shared between machines, and therefore must not be modified.
+typedef std::shared_ptr<const std::vector<uint8_t>> SharedROM;
+
+/*!
+	A process-wide cache of ROM images. Machines opt in by fetching through the cache rather than directly
+	from the ROM fetcher they are supplied with; all machines that are using an image then share a single
+	read-only copy, which is obtained from the host only if no machine is using it already. Machines that
+	need a ROM in some other form, e.g. with a different byte order, can similarly share the result of
+	transforming it. Currently only the Macintosh does so.
+
+	Nothing is retained beyond its use: an image remains cached only while a machine holds it or a
+	transformation of it.
+
+	Machines that modify their ROMs should continue to use the supplied fetcher directly.
+*/
+class ROMCache {
+	public:
+		/// @returns The process-wide cache.
+		static ROMCache &shared();
+
+		/*!
+			Obtains the ROMs described by @c roms, calling @c fetcher only for any that aren't currently cached.
+
+			@returns A vector with an entry for each of @c roms, in the same order, which is @c nullptr if that ROM is unavailable.
+		*/
+		std::vector<SharedROM> fetch(const ROMFetcher &fetcher, const std::vector<ROM> &roms);
+
+		/*!
+			@returns The result of applying @c transform to @c source, which should have been obtained via @c fetch.
+				The result is shared with any other caller that supplies the same @c source and @c name for as long
+				as any of them retains it, so @c name should uniquely identify the transformation. The result keeps
+				@c source cached.
+		*/
+		template <typename T> std::shared_ptr<const T> transformed(const SharedROM &source, const std::string &name, const std::function<T(const std::vector<uint8_t> &)> &transform) {
+			return std::static_pointer_cast<const T>(find_transformed(source, name, [&source, &transform] {
+				const auto holder = std::make_shared<const std::pair<SharedROM, T>>(source, transform(*source));
+				return std::shared_ptr<const void>(holder, &holder->second);
+			}));
+		}
+
+	private:
+		std::mutex mutex_;
+
+		// Images are keyed by description. Transformed images are keyed by the identity of their source,
+		// which can't be reused while an entry refers to it, and the name of their transformation.
+		// Expired entries of both sorts are discarded upon each lookup.
+		std::map<std::string, std::weak_ptr<const std::vector<uint8_t>>> images_;
+		struct TransformedImage {
+			std::weak_ptr<const std::vector<uint8_t>> source;
+			std::string name;
+			std::weak_ptr<const void> image;
+		};
+		std::vector<TransformedImage> transformed_images_;
+
+		std::shared_ptr<const void> find_transformed(const SharedROM &source, const std::string &name, const std::function<std::shared_ptr<const void>()> &transform);
+};
+
+}
+
+#endif /* ROMCache_hpp */
@@ -0,0 +1,196 @@
+//
+//  SessionHost.cpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#include "SessionHost.hpp"
+
+#include <algorithm>
+
+using namespace Machine;
+
+namespace {
+
+/// As per the BestEffortUpdater, cap any one slice at 1/5th of a second to avoid a huge amount of
+/// work after any brief interruption; time owed beyond that is skipped.
+const Time::Seconds maximum_slice_length = 0.2;
+
+Time::Seconds seconds(std::chrono::steady_clock::duration duration) {
+	return std::chrono::duration_cast<std::chrono::duration<Time::Seconds>>(duration).count();
+}
+
+}
+
+SessionHost::SessionHost(Concurrency::WorkerPool &pool, Time::Seconds slice_length) :
+	pool_(pool),
+	slice_length_(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<Time::Seconds>(slice_length))),
+	maximum_running_slices_(std::max(pool.thread_count(), std::size_t(2)) - 1) {
+	scheduler_thread_ = std::thread([this] {
+		std::unique_lock<std::mutex> lock(mutex_);
+		while(!should_stop_) {
+			if(schedule_.empty()) {
+				condition_.wait(lock);
+				continue;
+			}
+
+			// Leave a thread free for queues; a slice will end in due course.
+			if(running_slices_ == maximum_running_slices_) {
+				condition_.wait(lock);
+				continue;
+			}
+
+			const auto next = schedule_.begin();
+			if(next->first > Clock::now()) {
+				condition_.wait_until(lock, next->first);
+				continue;
+			}
+
+			// Dispatch the session with the earliest deadline, unless it has since been removed.
+			const auto session = next->second;
+			schedule_.erase(next);
+			if(session->is_removed) continue;
+
+			session->is_running = true;
+			++running_slices_;
+			pool_.enqueue([this, session] {
+				run_slice(session);
+			});
+		}
+	});
+}
+
+SessionHost::~SessionHost() {
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		should_stop_ = true;
+		condition_.notify_all();
+	}
+	scheduler_thread_.join();
+
+	// Wait for any slices that are still in progress.
+	std::unique_lock<std::mutex> lock(mutex_);
+	for(const auto &session: sessions_) {
+		condition_.wait(lock, [&session] { return !session.second->is_running; });
+	}
+}
+
+SessionHost::SessionID SessionHost::add_session(std::unique_ptr<DynamicMachine> machine) {
+	const auto session = std::make_shared<Session>();
+	session->machine = std::move(machine);
+	session->start_time = session->deadline = Clock::now();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	const SessionID id = next_session_id_;
+	++next_session_id_;
+
+	sessions_[id] = session;
+	schedule_.emplace(session->deadline, session);
+	condition_.notify_all();
+	return id;
+}
+
+std::unique_ptr<DynamicMachine> SessionHost::remove_session(SessionID id) {
+	std::unique_lock<std::mutex> lock(mutex_);
+	const auto iterator = sessions_.find(id);
+	if(iterator == sessions_.end()) return nullptr;
+
+	// Any entry in the schedule will be discarded by the scheduler; wait for any slice that is underway.
+	const auto session = iterator->second;
+	sessions_.erase(iterator);
+	session->is_removed = true;
+	condition_.wait(lock, [&session] { return !session->is_running; });
+
+	// The session is no longer reachable by any other thread, so its actions can be performed here.
+	perform_actions(session, lock);
+	return std::move(session->machine);
+}
+
+bool SessionHost::perform(SessionID id, const std::function<void(DynamicMachine &)> &action) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	const auto iterator = sessions_.find(id);
+	if(iterator == sessions_.end()) return false;
+
+	iterator->second->pending_actions.push_back(action);
+	return true;
+}
+
+void SessionHost::perform_actions(const std::shared_ptr<Session> &session, std::unique_lock<std::mutex> &lock) {
+	// Actions are performed without the lock, as they may take some time; the caller guarantees exclusive
+	// access to the machine. Check again afterwards in case any further actions were supplied meanwhile.
+	while(!session->pending_actions.empty()) {
+		std::vector<std::function<void(DynamicMachine &)>> actions;
+		actions.swap(session->pending_actions);
+
+		lock.unlock();
+		for(const auto &action: actions) {
+			action(*session->machine);
+		}
+		lock.lock();
+	}
+}
+
+void SessionHost::run_slice(const std::shared_ptr<Session> &session) {
+	// Perform any actions that have been supplied since the previous slice.
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		perform_actions(session, lock);
+	}
+
+	// Determine how much time is owed; no other thread modifies the session's timing while
+	// it is running so there's no need to lock yet.
+	Time::Seconds duration = seconds(Clock::now() - session->start_time) - session->run_time - session->skipped_time;
+	Time::Seconds skipped_time = 0.0;
+	if(duration > maximum_slice_length) {
+		skipped_time = duration - maximum_slice_length;
+		duration = maximum_slice_length;
+	}
+
+	if(duration > 0.0) {
+		CRTMachine::Machine *const crt_machine = session->machine->crt_machine();
+		if(crt_machine) crt_machine->run_for(duration);
+	} else {
+		duration = 0.0;
+	}
+	const auto end_time = Clock::now();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	session->run_time += duration;
+	session->skipped_time += skipped_time;
+	session->lag = seconds(end_time - session->start_time) - session->run_time - session->skipped_time;
+
+	// Schedule the next slice; if its deadline has already passed, run it as soon as possible.
+	session->deadline += slice_length_;
+	if(session->deadline < end_time) {
+		++session->missed_deadlines;
+		session->deadline = end_time;
+	}
+
+	session->is_running = false;
+	--running_slices_;
+	if(!session->is_removed && !should_stop_) {
+		schedule_.emplace(session->deadline, session);
+	}
+	condition_.notify_all();
+}
+
+std::vector<SessionHost::SessionReport> SessionHost::get_session_reports() {
+	std::vector<SessionReport> reports;
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	for(const auto &session: sessions_) {
+		reports.push_back({
+			session.first,
+			session.second->lag,
+			session.second->run_time,
+			session.second->skipped_time,
+			session.second->missed_deadlines
+		});
+	}
+	return reports;
+}
+
+float SessionHost::get_utilisation() {
+	return pool_.get_utilisation();
+}
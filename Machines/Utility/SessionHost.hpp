@@ -0,0 +1,129 @@
+//
+//  SessionHost.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef SessionHost_hpp
+#define SessionHost_hpp
+
+#include "../DynamicMachine.hpp"
+
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Concurrency/WorkerPool.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	A session host runs any number of machines in real time, sharing a fixed pool of worker threads
+	between them rather than requiring a thread, or a BestEffortUpdater, per machine.
+
+	Each session is run in slices: whenever its deadline arrives, the session is run for however much
+	time has elapsed since its previous slice, and its next deadline is set one slice length later.
+	Sessions are dispatched in deadline order, and no session is ever run on more than one thread at once.
+
+	Audio and disk tasks are performed by the pool that services Concurrency::AsyncTaskQueue, so hosting
+	a machine adds no threads beyond those of the pool. If the pool has more than one thread then sessions
+	never occupy all of them, so such tasks don't wait for a slice to end before they can be performed.
+*/
+class SessionHost {
+	public:
+		/*!
+			Creates a host that will run sessions on @c pool, aiming to run each one every @c slice_length seconds.
+		*/
+		SessionHost(Concurrency::WorkerPool &pool = Concurrency::WorkerPool::shared(), Time::Seconds slice_length = 1.0 / 100.0);
+
+		/// Stops all sessions, waiting for any that are mid-slice, and destroys their machines.
+		~SessionHost();
+
+		typedef std::size_t SessionID;
+
+		/// Takes ownership of @c machine and begins running it. @returns An identifier for the new session.
+		SessionID add_session(std::unique_ptr<DynamicMachine> machine);
+
+		/*!
+			Stops running the session @c session, waiting if it is currently mid-slice.
+
+			@returns The session's machine, or @c nullptr if there is no such session.
+		*/
+		std::unique_ptr<DynamicMachine> remove_session(SessionID session);
+
+		/*!
+			Arranges for @c action to be applied to the machine of session @c session between slices, so that
+			it has exclusive access to the machine. Actions are performed in the order they were supplied, on
+			a thread of the worker pool, before the session's next slice; any that are still outstanding
+			when the session is removed are performed by @c remove_session.
+
+			@returns @c true if the action was accepted; @c false if there is no such session.
+		*/
+		bool perform(SessionID session, const std::function<void(DynamicMachine &)> &action);
+
+		struct SessionReport {
+			SessionID session;
+
+			/// The amount of time by which the session trailed real time at the end of its most recent slice.
+			Time::Seconds lag;
+
+			/// The total amount of time for which the session's machine has been run.
+			Time::Seconds run_time;
+
+			/// The total amount of real time the session has discarded rather than run, having fallen too far behind.
+			Time::Seconds skipped_time;
+
+			/// The number of slices that were completed only after the session's next deadline had already passed.
+			std::size_t missed_deadlines;
+		};
+
+		/// @returns A report on each current session.
+		std::vector<SessionReport> get_session_reports();
+
+		/// @returns The utilisation of the worker pool, as per Concurrency::WorkerPool::get_utilisation.
+		float get_utilisation();
+
+	private:
+		typedef std::chrono::steady_clock Clock;
+
+		struct Session {
+			std::unique_ptr<DynamicMachine> machine;
+			std::vector<std::function<void(DynamicMachine &)>> pending_actions;
+			Clock::time_point start_time, deadline;
+
+			Time::Seconds run_time = 0.0, skipped_time = 0.0, lag = 0.0;
+			std::size_t missed_deadlines = 0;
+
+			bool is_running = false;
+			bool is_removed = false;
+		};
+
+		Concurrency::WorkerPool &pool_;
+		const Clock::duration slice_length_;
+		const std::size_t maximum_running_slices_;
+		std::size_t running_slices_ = 0;
+
+		std::mutex mutex_;
+		std::condition_variable condition_;
+		bool should_stop_ = false;
+
+		SessionID next_session_id_ = 0;
+		std::map<SessionID, std::shared_ptr<Session>> sessions_;
+		std::multimap<Clock::time_point, std::shared_ptr<Session>> schedule_;
+
+		std::thread scheduler_thread_;
+
+		void run_slice(const std::shared_ptr<Session> &session);
+		void perform_actions(const std::shared_ptr<Session> &session, std::unique_lock<std::mutex> &lock);
+};
+
+}
+
+#endif /* SessionHost_hpp */
@@ -64,6 +64,7 @@ template<bool is_zx81> class ConcreteMachine:
 	public Configurable::Device,
 	public Utility::TypeRecipient,
 	public CPU::Z80::BusHandler,
+	public ClockingHint::Observer,
 	public Machine {
 	public:
 		ConcreteMachine(const Analyser::Static::ZX8081::Target &target, const ROMMachine::ROMFetcher &rom_fetcher) :
@@ -74,6 +75,7 @@ template<bool is_zx81> class ConcreteMachine:
 			set_clock_rate(ZX8081ClockRate);
 			speaker_.set_input_rate(static_cast<float>(ZX8081ClockRate) / 2.0f);
 			clear_all_keys();
+			tape_player_.set_clocking_hint_observer(this);
 
 			const bool use_zx81_rom = target.is_ZX81 || target.ZX80_uses_ZX81_ROM;
 			const auto roms =
@@ -160,7 +162,7 @@ template<bool is_zx81> class ConcreteMachine:
 
 			if(is_zx81) horizontal_counter_ %= HalfCycles(Cycles(207));
 			if(!tape_advance_delay_) {
-				tape_player_.run_for(cycle.length);
+				if(!tape_player_is_sleeping_) tape_player_.run_for(cycle.length);
 			} else {
 				tape_advance_delay_ = std::max(tape_advance_delay_ - cycle.length, HalfCycles(0));
 			}
@@ -369,6 +371,10 @@ template<bool is_zx81> class ConcreteMachine:
 			return tape_player_.get_motor_control();
 		}
 
+		void set_component_prefers_clocking(ClockingHint::Source *component, ClockingHint::Preference clocking) override final {
+			tape_player_is_sleeping_ = tape_player_.preferred_clocking() == ClockingHint::Preference::None;
+		}
+
 		// MARK: - Typer timing
 		HalfCycles get_typer_delay() override final { return Cycles(7000000); }
 		HalfCycles get_typer_frequency() override final { return Cycles(390000); }
@@ -429,6 +435,7 @@ template<bool is_zx81> class ConcreteMachine:
 		ZX8081::KeyboardMapper keyboard_mapper_;
 
 		HalfClockReceiver<Storage::Tape::BinaryTapePlayer> tape_player_;
+		bool tape_player_is_sleeping_ = true;
 		Storage::Tape::ZX8081::Parser parser_;
 
 		bool nmi_is_enabled_ = false;
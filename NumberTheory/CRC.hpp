@@ -9,37 +9,210 @@
 #ifndef CRC_hpp
 #define CRC_hpp
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include <vector>
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CRC_PCLMUL
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#define CRC_ARM
+#include <arm_acle.h>
+#endif
+
 namespace CRC {
 
+/*!
+	Hardware implementations of the standard, reflected CRC32 — i.e. of CRC::CRC32 — which operate upon
+	the reflected form of the CRC register, without any input or output inversion.
+*/
+namespace Hardware {
+
+#ifdef CRC_PCLMUL
+
+/// @returns @c true if this processor supports the instructions used by @c crc32_pclmul; @c false otherwise.
+inline bool has_pclmul() {
+	static const bool has_pclmul = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+	return has_pclmul;
+}
+
+/*!
+	Updates @c crc to include the @c length bytes at @c data by folding 64 bytes at a time with carry-less
+	multiplication, per Intel's 'Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction'.
+	@c length must be at least 64, and a multiple of 16.
+*/
+__attribute__((target("pclmul,sse4.1"))) inline uint32_t crc32_pclmul(const uint8_t *data, std::size_t length, uint32_t crc) {
+	alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+	alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+	alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+	alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+	// Load the first 64 bytes, applying the current CRC.
+	x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x00));
+	x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x10));
+	x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x20));
+	x4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(int(crc)));
+	data += 64;
+	length -= 64;
+
+	// Fold in 64 bytes at a time.
+	x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k1k2));
+	while(length >= 64) {
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x00)));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x10)));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x20)));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x30)));
+
+		data += 64;
+		length -= 64;
+	}
+
+	// Fold the four accumulators into one.
+	x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k3k4));
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	// Fold in any remaining 16-byte blocks.
+	while(length >= 16) {
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i *>(data))), x5);
+
+		data += 16;
+		length -= 16;
+	}
+
+	// Fold 128 bits down to 64.
+	x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+	x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+	x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(k5k0));
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, x3);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	// Apply a Barrett reduction to get down to 32 bits.
+	x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(poly));
+	x2 = _mm_and_si128(x1, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+	x2 = _mm_and_si128(x2, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return uint32_t(_mm_extract_epi32(x1, 1));
+}
+
+#endif
+
+#ifdef CRC_ARM
+
+/// Updates @c crc to include the @c length bytes at @c data using the ARMv8 CRC32 instructions.
+inline uint32_t crc32_arm(const uint8_t *data, std::size_t length, uint32_t crc) {
+	while(length >= 8) {
+		uint64_t word;
+		memcpy(&word, data, sizeof(word));
+		crc = __crc32d(crc, word);
+		data += 8;
+		length -= 8;
+	}
+	while(length--) {
+		crc = __crc32b(crc, *data);
+		++data;
+	}
+	return crc;
+}
+
+#endif
+
+}
+
 /*! Provides a class capable of generating a CRC from source data. */
-template <typename T, T reset_value, T xor_output, bool reflect_input, bool reflect_output> class Generator {
+template <typename T, T polynomial, T reset_value, T xor_output, bool reflect_input, bool reflect_output> class Generator {
 	public:
 		/*!
-			Instantiates a CRC16 that will compute the CRC16 specified by the supplied
-			@c polynomial and @c reset_value.
+			Instantiates a CRC generator that will compute the CRC specified by the template's
+			@c polynomial, @c reset_value, @c xor_output and reflection parameters.
 		*/
-		Generator(T polynomial): value_(reset_value) {
-			const T top_bit = T(~(T(~0) >> 1));
-			for(int c = 0; c < 256; c++) {
-				T shift_value = static_cast<T>(c << multibyte_shift);
-				for(int b = 0; b < 8; b++) {
-					T exclusive_or = (shift_value&top_bit) ? polynomial : 0;
-					shift_value = static_cast<T>(shift_value << 1) ^ exclusive_or;
-				}
-				xor_table[c] = shift_value;
-			}
-		}
+		Generator(): tables_(&tables()), value_(reset_value) {}
 
 		/// Resets the CRC to the reset value.
 		void reset() { value_ = reset_value; }
 
 		/// Updates the CRC to include @c byte.
 		void add(uint8_t byte) {
-			if(reflect_input) byte = reverse_byte(byte);
-			value_ = static_cast<T>((value_ << 8) ^ xor_table[(value_ >> multibyte_shift) ^ byte]);
+			if(reflect_input) byte = tables_->reversed_bytes[byte];
+			value_ = static_cast<T>((value_ << 8) ^ tables_->xor_tables[0][(value_ >> multibyte_shift) ^ byte]);
+		}
+
+		/// Updates the CRC to include the @c length bytes at @c data.
+		void add(const uint8_t *data, std::size_t length) {
+			// Use hardware support for CRC32 where it's available.
+			const bool is_crc32 =
+				std::is_same<T, uint32_t>::value && polynomial == T(0x04c11db7) && reflect_input && reflect_output;
+#ifdef CRC_ARM
+			if(is_crc32) {
+				value_ = T(reverse_word(Hardware::crc32_arm(data, length, reverse_word(uint32_t(value_)))));
+				return;
+			}
+#endif
+#ifdef CRC_PCLMUL
+			if(is_crc32 && length >= 64 && Hardware::has_pclmul()) {
+				const std::size_t bulk_length = length & ~std::size_t(15);
+				value_ = T(reverse_word(Hardware::crc32_pclmul(data, bulk_length, reverse_word(uint32_t(value_)))));
+				data += bulk_length;
+				length -= bulk_length;
+			}
+#endif
+
+			// Otherwise process eight bytes at a time: the CRC of those eight is the exclusive OR of the
+			// effect of each, taking into account the number of bytes that follow it.
+			while(length >= 8) {
+				T result = 0;
+				for(std::size_t c = 0; c < 8; ++c) {
+					uint8_t byte = data[c];
+					if(reflect_input) byte = tables_->reversed_bytes[byte];
+					if(c < sizeof(T)) byte ^= uint8_t(value_ >> (multibyte_shift - 8*c));
+					result ^= tables_->xor_tables[7 - c][byte];
+				}
+				value_ = result;
+				data += 8;
+				length -= 8;
+			}
+
+			while(length--) {
+				add(*data);
+				++data;
+			}
 		}
 
 		/// @returns The current value of the CRC.
@@ -48,7 +221,7 @@ template <typename T, T reset_value, T xor_output, bool reflect_input, bool refl
 			if(reflect_output) {
 				T reflected_output = 0;
 				for(std::size_t c = 0; c < sizeof(T); ++c) {
-					reflected_output = T(reflected_output << 8) | T(reverse_byte(result & 0xff));
+					reflected_output = T(reflected_output << 8) | T(tables_->reversed_bytes[result & 0xff]);
 					result >>= 8;
 				}
 				return reflected_output;
@@ -68,16 +241,47 @@ template <typename T, T reset_value, T xor_output, bool reflect_input, bool refl
 		*/
 		T compute_crc(const std::vector<uint8_t> &data) {
 			reset();
-			for(const auto &byte: data) add(byte);
+			add(data.data(), data.size());
 			return get_value();
 		}
 
 	private:
 		static constexpr int multibyte_shift = (sizeof(T) * 8) - 8;
-		T xor_table[256];
+
+		// Tables are shared by all generators of the same type. xor_tables[n][b] is the effect of
+		// the byte b upon the CRC once it has been followed by n further bytes.
+		struct Tables {
+			T xor_tables[8][256];
+			uint8_t reversed_bytes[256];
+
+			Tables() {
+				const T top_bit = T(~(T(~0) >> 1));
+				for(int c = 0; c < 256; c++) {
+					T shift_value = static_cast<T>(c << multibyte_shift);
+					for(int b = 0; b < 8; b++) {
+						T exclusive_or = (shift_value&top_bit) ? polynomial : 0;
+						shift_value = static_cast<T>(shift_value << 1) ^ exclusive_or;
+					}
+					xor_tables[0][c] = shift_value;
+					reversed_bytes[c] = reverse_byte(uint8_t(c));
+				}
+				for(int n = 1; n < 8; n++) {
+					for(int c = 0; c < 256; c++) {
+						const T previous = xor_tables[n-1][c];
+						xor_tables[n][c] = static_cast<T>((previous << 8) ^ xor_tables[0][previous >> multibyte_shift]);
+					}
+				}
+			}
+		};
+		static const Tables &tables() {
+			static const Tables tables;
+			return tables;
+		}
+
+		const Tables *tables_;
 		T value_;
 
-		constexpr uint8_t reverse_byte(uint8_t byte) const {
+		static constexpr uint8_t reverse_byte(uint8_t byte) {
 			return
 				((byte & 0x80) ? 0x01 : 0x00) |
 				((byte & 0x40) ? 0x02 : 0x00) |
@@ -88,22 +292,26 @@ template <typename T, T reset_value, T xor_output, bool reflect_input, bool refl
 				((byte & 0x02) ? 0x40 : 0x00) |
 				((byte & 0x01) ? 0x80 : 0x00);
 		}
+
+		static uint32_t reverse_word(uint32_t word) {
+			word = ((word >> 1) & 0x55555555) | ((word & 0x55555555) << 1);
+			word = ((word >> 2) & 0x33333333) | ((word & 0x33333333) << 2);
+			word = ((word >> 4) & 0x0f0f0f0f) | ((word & 0x0f0f0f0f) << 4);
+			word = ((word >> 8) & 0x00ff00ff) | ((word & 0x00ff00ff) << 8);
+			return (word >> 16) | (word << 16);
+		}
 };
 
 /*!
 	Provides a generator of 16-bit CCITT CRCs, which amongst other uses are
 	those used by the FM and MFM disk encodings.
 */
-struct CCITT: public Generator<uint16_t, 0xffff, 0x0000, false, false> {
-	CCITT(): Generator(0x1021) {}
-};
+struct CCITT: public Generator<uint16_t, 0x1021, 0xffff, 0x0000, false, false> {};
 
 /*!
 	Provides a generator of "standard 32-bit" CRCs.
 */
-struct CRC32: public Generator<uint32_t, 0xffffffff, 0xffffffff, true, true> {
-	CRC32(): Generator(0x04c11db7) {}
-};
+struct CRC32: public Generator<uint32_t, 0x04c11db7, 0xffffffff, 0xffffffff, true, true> {};
 
 }
 
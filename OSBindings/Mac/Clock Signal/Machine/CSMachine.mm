@@ -29,6 +29,7 @@
 #import <OpenGL/OpenGL.h>
 #include <OpenGL/gl3.h>
 
+#include "../../../../Outputs/OpenGL/Primitives/Shader.hpp"
 #include "../../../../Outputs/OpenGL/ScanTarget.hpp"
 #include "../../../../Outputs/OpenGL/Screenshot.hpp"
 
@@ -321,6 +322,19 @@ struct ActivityObserver: public Activity::Observer {
 }
 
 - (void)setupOutputWithAspectRatio:(float)aspectRatio {
+	// Keep compiled shaders between sessions, in a subdirectory of the user's caches directory.
+	static dispatch_once_t shaderCacheToken;
+	dispatch_once(&shaderCacheToken, ^{
+		NSURL *const cachesURL = [[[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] firstObject];
+		NSString *const bundleIdentifier = [[NSBundle mainBundle] bundleIdentifier];
+		if(!cachesURL || !bundleIdentifier) return;
+
+		NSURL *const shaderCacheURL = [[cachesURL URLByAppendingPathComponent:bundleIdentifier] URLByAppendingPathComponent:@"Shaders"];
+		if([[NSFileManager defaultManager] createDirectoryAtURL:shaderCacheURL withIntermediateDirectories:YES attributes:nil error:nil]) {
+			Outputs::Display::OpenGL::Shader::set_binary_cache_directory(shaderCacheURL.fileSystemRepresentation);
+		}
+	});
+
 	_scanTarget.reset(new Outputs::Display::OpenGL::ScanTarget);
 	_machine->crt_machine()->set_scan_target(_scanTarget.get());
 }
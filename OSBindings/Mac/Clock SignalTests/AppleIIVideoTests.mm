@@ -0,0 +1,117 @@
+//
+//  AppleIIVideoTests.mm
+//  Clock SignalTests
+//
+//  Created on 19/10/2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "../../../Machines/Apple/AppleII/Video.hpp"
+
+namespace {
+
+/// Supplies pseudo-random main and auxiliary memory contents.
+class VideoBusHandler {
+	public:
+		VideoBusHandler() {
+			uint32_t seed = 0x1234567;
+			for(size_t c = 0; c < memory_.size(); ++c) {
+				seed = seed * 1664525 + 1013904223;
+				memory_[c] = uint8_t(seed >> 24);
+			}
+		}
+
+		void perform_read(uint16_t address, size_t count, uint8_t *base_target, uint8_t *auxiliary_target) {
+			for(size_t c = 0; c < count; ++c) {
+				base_target[c] = memory_[(address + c) & 0xffff];
+				auxiliary_target[c] = memory_[(address + c) ^ 0x8000];
+			}
+		}
+
+	private:
+		std::array<uint8_t, 65536> memory_;
+};
+
+/// Accepts and discards all output, vending real storage so that pixel generation isn't skipped.
+class DiscardingScanTarget: public Outputs::Display::ScanTarget {
+	public:
+		void set_modals(Modals) override {}
+		Scan *begin_scan() override { return &scan_; }
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) override { return data_.data(); }
+		void submit() override {}
+
+	private:
+		Scan scan_;
+		std::array<uint8_t, 2048> data_;
+};
+
+using AppleIIeVideo = Apple::II::Video::Video<VideoBusHandler, true>;
+
+}
+
+@interface AppleIIVideoTests : XCTestCase
+@end
+
+@implementation AppleIIVideoTests {
+	VideoBusHandler _bus_handler;
+	DiscardingScanTarget _scan_target;
+	std::unique_ptr<AppleIIeVideo> _video;
+}
+
+- (void)setUp {
+	_video.reset(new AppleIIeVideo(_bus_handler));
+	_video->set_scan_target(&_scan_target);
+
+	std::vector<uint8_t> character_rom(4096);
+	for(size_t c = 0; c < character_rom.size(); ++c) {
+		character_rom[c] = uint8_t(c * 7);
+	}
+	_video->set_character_rom(character_rom);
+}
+
+/// Sets the soft switches as given, then times the output of 60 whole frames.
+- (void)measureText:(bool)text highResolution:(bool)highResolution columns80:(bool)columns80 annunciator3:(bool)annunciator3 {
+	_video->set_text(text);
+	_video->set_high_resolution(highResolution);
+	_video->set_80_columns(columns80);
+	_video->set_annunciator_3(annunciator3);
+
+	[self measureBlock:^{
+		_video->run_for(Cycles(65 * 262 * 60));
+	}];
+}
+
+- (void)testText {
+	[self measureText:true highResolution:false columns80:false annunciator3:false];
+}
+
+- (void)testDoubleText {
+	[self measureText:true highResolution:false columns80:true annunciator3:false];
+}
+
+- (void)testLowResolution {
+	[self measureText:false highResolution:false columns80:false annunciator3:false];
+}
+
+- (void)testFatLowResolution {
+	[self measureText:false highResolution:false columns80:false annunciator3:true];
+}
+
+- (void)testDoubleLowResolution {
+	[self measureText:false highResolution:false columns80:true annunciator3:false];
+}
+
+- (void)testHighResolution {
+	[self measureText:false highResolution:true columns80:false annunciator3:false];
+}
+
+- (void)testDoubleHighResolution {
+	[self measureText:false highResolution:true columns80:true annunciator3:true];
+}
+
+@end
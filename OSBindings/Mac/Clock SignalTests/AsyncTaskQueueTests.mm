@@ -0,0 +1,176 @@
+//
+//  AsyncTaskQueueTests.mm
+//  Clock SignalTests
+//
+//  Created on 19/10/2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "AsyncTaskQueue.hpp"
+#include "WorkerPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+@interface AsyncTaskQueueTests : XCTestCase
+@end
+
+@implementation AsyncTaskQueueTests
+
+- (void)testOrdering {
+	// Interleave enqueues to many queues, so that they compete for workers.
+	const int queue_count = 100, task_count = 1000;
+	std::vector<std::unique_ptr<Concurrency::AsyncTaskQueue>> queues;
+	std::vector<std::vector<int>> results(queue_count);
+	for(int queue = 0; queue < queue_count; ++queue) {
+		queues.emplace_back(new Concurrency::AsyncTaskQueue);
+	}
+	for(int task = 0; task < task_count; ++task) {
+		for(int queue = 0; queue < queue_count; ++queue) {
+			queues[queue]->enqueue([&results, queue, task] {
+				results[queue].push_back(task);
+			});
+		}
+	}
+	for(auto &queue: queues) {
+		queue->flush();
+	}
+
+	for(const auto &result: results) {
+		XCTAssertEqual(result.size(), task_count);
+		for(int task = 0; task < task_count && task < int(result.size()); ++task) {
+			XCTAssertEqual(result[task], task);
+		}
+	}
+}
+
+- (void)testFlushFromWithinTask {
+	Concurrency::AsyncTaskQueue outer, inner;
+	int count = 0, count_after_flush = 0;
+	outer.enqueue([&inner, &count, &count_after_flush] {
+		for(int c = 0; c < 10; ++c) {
+			inner.enqueue([&count] { ++count; });
+		}
+		inner.flush();
+		count_after_flush = count;
+	});
+	outer.flush();
+	XCTAssertEqual(count_after_flush, 10);
+}
+
+/// Destroying a queue should perform everything enqueued upon it first, so that its owner can then safely
+/// destroy anything those tasks use.
+- (void)testDestructionWithPendingWork {
+	std::atomic<int> count(0);
+	{
+		Concurrency::AsyncTaskQueue queue;
+		for(int c = 0; c < 10; ++c) {
+			queue.enqueue([&count] {
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+				++count;
+			});
+		}
+	}
+	XCTAssertEqual(count.load(), 10);
+
+	{
+		Concurrency::DeferringAsyncTaskQueue queue;
+		for(int c = 0; c < 10; ++c) {
+			queue.defer([&count] { ++count; });
+		}
+	}
+	XCTAssertEqual(count.load(), 20);
+}
+
+- (void)testWorkerPool {
+	std::vector<int> results;
+	std::atomic<int> count(0);
+	{
+		Concurrency::WorkerPool pool(1);
+		XCTAssertEqual(pool.thread_count(), 1);
+		XCTAssertGreaterThanOrEqual(Concurrency::WorkerPool().thread_count(), 2);
+
+		// With a single thread, functions are performed in order; those enqueued from the pool's
+		// own thread, and any still outstanding upon destruction, are performed too.
+		for(int c = 0; c < 100; ++c) {
+			pool.enqueue([&pool, &results, &count, c] {
+				results.push_back(c);
+				pool.enqueue([&count] {
+					std::this_thread::sleep_for(std::chrono::microseconds(100));
+					++count;
+				});
+			});
+		}
+	}
+
+	XCTAssertEqual(results.size(), 100);
+	for(int c = 0; c < 100 && c < int(results.size()); ++c) {
+		XCTAssertEqual(results[c], c);
+	}
+	XCTAssertEqual(count.load(), 100);
+}
+
+#ifndef __APPLE__
+- (void)testFlushOnSingleThreadPool {
+	// The pool's only thread is occupied by outer, so flushing inner must perform its tasks
+	// on the caller rather than waiting for a worker.
+	Concurrency::WorkerPool pool(1);
+	Concurrency::AsyncTaskQueue outer(pool);
+	std::vector<std::unique_ptr<Concurrency::AsyncTaskQueue>> inner;
+	for(int c = 0; c < 4; ++c) {
+		inner.emplace_back(new Concurrency::AsyncTaskQueue(pool));
+	}
+
+	int count = 0;
+	outer.enqueue([&inner, &count] {
+		for(auto &queue: inner) {
+			queue->enqueue([&count] { ++count; });
+		}
+		for(auto &queue: inner) {
+			queue->flush();
+		}
+	});
+	outer.flush();
+	XCTAssertEqual(count, 4);
+}
+
+- (void)testDestructionOnBusyPool {
+	// The pool's only thread is occupied until released, so destroying a queue must perform its tasks
+	// on the caller rather than waiting for a worker.
+	Concurrency::WorkerPool pool(1);
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool is_released = false;
+	pool.enqueue([&mutex, &condition, &is_released] {
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [&is_released] { return is_released; });
+	});
+
+	std::vector<int> results;
+	{
+		Concurrency::AsyncTaskQueue queue(pool);
+		for(int c = 0; c < 10; ++c) {
+			queue.enqueue([&results, c] { results.push_back(c); });
+		}
+	}
+
+	XCTAssertEqual(results.size(), 10);
+	for(int c = 0; c < 10 && c < int(results.size()); ++c) {
+		XCTAssertEqual(results[c], c);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		is_released = true;
+	}
+	condition.notify_all();
+}
+#endif
+
+@end
@@ -9,6 +9,7 @@
 #import <XCTest/XCTest.h>
 #include "CRC.hpp"
 #include <string>
+#include <vector>
 
 @interface CRCTests : XCTestCase
 @end
@@ -81,4 +82,72 @@
 	XCTAssertEqual(crcGenerator.get_value(), 0xcbf43926);
 }
 
+- (std::vector<uint8_t>)pseudoRandomDataOfLength:(size_t)length {
+	std::vector<uint8_t> data(length);
+	uint32_t seed = 0x12345678;
+	for(auto &byte: data) {
+		seed = seed * 1103515245 + 12345;
+		byte = uint8_t(seed >> 16);
+	}
+	return data;
+}
+
+/// Checks that CRCs computed in bulk, whether by table slicing or in hardware, match those computed a byte at a time.
+- (void)testBulkMatchesBytewise {
+	const auto data = [self pseudoRandomDataOfLength:4096 + 7];
+
+	for(size_t length = 0; length < 300; ++length) {
+		for(size_t offset: {size_t(0), size_t(3)}) {
+			CRC::CRC32 bytewise32, bulk32;
+			CRC::CCITT bytewise16, bulk16;
+			for(size_t c = 0; c < length; ++c) {
+				bytewise32.add(data[offset + c]);
+				bytewise16.add(data[offset + c]);
+			}
+			bulk32.add(&data[offset], length);
+			bulk16.add(&data[offset], length);
+
+			XCTAssertEqual(bytewise32.get_value(), bulk32.get_value(), @"CRC32 differs at length %zu, offset %zu", length, offset);
+			XCTAssertEqual(bytewise16.get_value(), bulk16.get_value(), @"CCITT differs at length %zu, offset %zu", length, offset);
+		}
+	}
+
+	// Also check a bulk addition that follows partial data and precedes more.
+	CRC::CRC32 bytewise, bulk;
+	for(auto byte: data) bytewise.add(byte);
+	bulk.add(data[0]);
+	bulk.add(&data[1], 4000);
+	bulk.add(&data[4001], data.size() - 4001);
+	XCTAssertEqual(bytewise.get_value(), bulk.get_value());
+	XCTAssertEqual(bulk.compute_crc(data), bytewise.get_value());
+}
+
+- (void)testBulkCheckValues {
+	const std::string fox("The quick brown fox jumps over the lazy dog");
+	const std::vector<uint8_t> fox_data(fox.begin(), fox.end());
+	XCTAssertEqual(CRC::CRC32().compute_crc(fox_data), 0x414fa339);
+
+	std::vector<uint8_t> check_data;
+	for(int c = 0; c < 16; ++c) {
+		for(auto character: std::string("123456789")) check_data.push_back(uint8_t(character));
+	}
+	CRC::CRC32 crc32;
+	crc32.add(check_data.data(), 9);
+	XCTAssertEqual(crc32.get_value(), 0xcbf43926);
+
+	CRC::CCITT ccitt;
+	ccitt.add(check_data.data(), 9);
+	XCTAssertEqual(ccitt.get_value(), 0x29b1);
+}
+
+- (void)testCRC32Throughput {
+	const auto data = [self pseudoRandomDataOfLength:512*1024];
+	CRC::CRC32 crcGenerator;
+	[self measureBlock:^{
+		for(int c = 0; c < 10; ++c) {
+			crcGenerator.compute_crc(data);
+		}
+	}];
+}
+
 @end
@@ -0,0 +1,143 @@
+//
+//  ClockingHintTests.mm
+//  Clock SignalTests
+//
+//  Created on 19/10/2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "1770.hpp"
+#include "Tape.hpp"
+#include "LowpassSpeaker.hpp"
+#include "SampleSource.hpp"
+
+#include <vector>
+
+namespace {
+
+/// Records the most recent preference announced, and how many announcements there have been.
+struct RecordingObserver: public ClockingHint::Observer {
+	void set_component_prefers_clocking(ClockingHint::Source *component, ClockingHint::Preference clocking) override {
+		is_sleeping = clocking == ClockingHint::Preference::None;
+		++announcements;
+	}
+
+	bool is_sleeping = false;
+	int announcements = 0;
+};
+
+/// A sample source that is always at the zero level, counting how it is accessed.
+class SilentSource: public Outputs::Speaker::SampleSource {
+	public:
+		void get_samples(std::size_t number_of_samples, std::int16_t *target) {
+			++get_samples_calls;
+			std::fill(target, target + number_of_samples, 0);
+		}
+
+		void skip_samples(const std::size_t number_of_samples) {
+			samples_skipped += number_of_samples;
+		}
+
+		bool is_zero_level() {
+			return true;
+		}
+
+		int get_samples_calls = 0;
+		std::size_t samples_skipped = 0;
+};
+
+/// Collects all samples output by a speaker.
+struct CollectingDelegate: public Outputs::Speaker::Speaker::Delegate {
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) override {
+		samples.insert(samples.end(), buffer.begin(), buffer.end());
+	}
+
+	std::vector<int16_t> samples;
+};
+
+/// Runs a machine-style clocking loop for @c cycles cycles, skipping @c run whenever @c observer
+/// indicates that the component is asleep, and returns the number of calls elided.
+template <typename Function> int elided_calls(int cycles, const RecordingObserver &observer, Function run) {
+	int elided = 0;
+	for(int c = 0; c < cycles; ++c) {
+		if(observer.is_sleeping) {
+			++elided;
+		} else {
+			run();
+		}
+	}
+	return elided;
+}
+
+}
+
+@interface ClockingHintTests : XCTestCase
+@end
+
+@implementation ClockingHintTests
+
+- (void)testTapePlayerSleepsWithoutMotor {
+	Storage::Tape::BinaryTapePlayer tape_player(1000000);
+	RecordingObserver observer;
+	tape_player.set_clocking_hint_observer(&observer);
+
+	XCTAssertEqual(observer.announcements, 1);
+	XCTAssertTrue(observer.is_sleeping);
+
+	// With no tape inserted, even a running motor leaves the player asleep.
+	tape_player.set_motor_control(true);
+	XCTAssertTrue(observer.is_sleeping);
+
+	const int elided = elided_calls(1000, observer, [&] {
+		tape_player.run_for(Cycles(1));
+	});
+	XCTAssertEqual(elided, 1000);
+}
+
+- (void)testWD1770SleepsBetweenCommands {
+	WD::WD1770 controller(WD::WD1770::P1773);
+	RecordingObserver observer;
+	controller.set_clocking_hint_observer(&observer);
+	XCTAssertTrue(observer.is_sleeping);
+
+	// Step in, at the 6ms step rate, without verification; the step timer requires clocking.
+	controller.set_register(0, 0x40);
+	XCTAssertFalse(observer.is_sleeping);
+
+	// 6ms at 8Mhz is 48,000 cycles; the controller should then be idle again, and every
+	// subsequent call should be elided.
+	const int elided = elided_calls(60000, observer, [&] {
+		controller.run_for(Cycles(1));
+	});
+	XCTAssertTrue(observer.is_sleeping);
+	XCTAssertEqual(elided, 60000 - 48000);
+}
+
+- (void)testLowpassSpeakerSkipsSilentSource {
+	SilentSource source;
+	CollectingDelegate delegate;
+	Concurrency::DeferringAsyncTaskQueue queue;
+	Outputs::Speaker::LowpassSpeaker<SilentSource> speaker(source);
+
+	speaker.set_input_rate(1000000.0f);
+	speaker.set_output_rate(44100.0f, 512);
+	speaker.set_delegate(&delegate);
+
+	for(int c = 0; c < 100; ++c) {
+		speaker.run_for(queue, Cycles(10000));
+	}
+	queue.perform();
+	queue.flush();
+
+	// No samples should have been requested; all should have been skipped instead, and the output
+	// should be silent.
+	XCTAssertEqual(source.get_samples_calls, 0);
+	XCTAssertEqual(source.samples_skipped, std::size_t(1000000));
+	XCTAssertGreaterThan(delegate.samples.size(), std::size_t(0));
+	for(auto sample: delegate.samples) {
+		XCTAssertEqual(sample, 0);
+	}
+}
+
+@end
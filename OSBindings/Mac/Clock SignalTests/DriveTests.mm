@@ -0,0 +1,89 @@
+//
+//  DriveTests.mm
+//  Clock SignalTests
+//
+//  Created on 19/10/2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/Disk/Disk.hpp"
+#include "../../../Storage/Disk/Drive.hpp"
+#include "../../../Storage/Disk/Track/PCMTrack.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace Storage::Disk;
+
+namespace {
+
+/// A disk on which every track is the same run of flux transitions.
+class TestDisk: public Disk {
+	public:
+		TestDisk() {
+			PCMSegment segment;
+			segment.data = std::vector<bool>(1000, true);
+			segment.length_of_a_bit = Storage::Time(1, 1000);
+			track_.reset(new PCMTrack(segment));
+		}
+
+		HeadPosition get_maximum_head_position() override	{	return HeadPosition(80);	}
+		int get_head_count() override						{	return 1;					}
+		std::shared_ptr<Track> get_track_at_position(Track::Address) override	{	return track_;	}
+		void set_track_at_position(Track::Address, const std::shared_ptr<Track> &) override {}
+		void flush_tracks() override {}
+		bool get_is_read_only() override					{	return true;				}
+
+	private:
+		std::shared_ptr<Track> track_;
+};
+
+/// Records the time at which each index hole is seen.
+struct IndexHoleRecorder: public Drive::EventDelegate {
+	int time = 0;
+	std::vector<int> index_holes;
+
+	void process_event(const Drive::Event &event) override {
+		if(event.type == Track::Event::IndexHole) index_holes.push_back(time);
+	}
+	void advance(const Cycles cycles) override {
+		time += cycles.as_int();
+	}
+};
+
+}
+
+@interface DriveTests : XCTestCase
+@end
+
+@implementation DriveTests
+
+/// Steps the head twice within a single rotation and checks that the index hole still arrives once per rotation,
+/// i.e. that the drive keeps its place in the rotation across each change of track.
+- (void)testIndexHolesSurviveSteps {
+	const int clock_rate = 1000000;
+	const int cycles_per_rotation = clock_rate / 5;	// i.e. 300rpm.
+
+	Drive drive(clock_rate, 300, 1);
+	IndexHoleRecorder recorder;
+	drive.set_event_delegate(&recorder);
+	drive.set_disk(std::make_shared<TestDisk>());
+	drive.set_motor_on(true);
+
+	drive.run_for(Cycles(cycles_per_rotation / 4));
+	drive.step_to(HeadPosition(1));
+	drive.run_for(Cycles(cycles_per_rotation / 4));
+	drive.step_to(HeadPosition(2));
+	drive.run_for(Cycles(cycles_per_rotation * 2));
+
+	// The first index hole is announced as soon as the drive starts.
+	XCTAssertEqual(recorder.index_holes.size(), 3);
+	for(std::size_t c = 0; c < recorder.index_holes.size(); ++c) {
+		const int expected = int(c) * cycles_per_rotation;
+		XCTAssertLessThan(abs(recorder.index_holes[c] - expected), cycles_per_rotation / 100, @"Index hole %zu at %d rather than %d", c, recorder.index_holes[c], expected);
+	}
+}
+
+@end
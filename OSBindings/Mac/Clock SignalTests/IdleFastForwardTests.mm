@@ -0,0 +1,296 @@
+//
+//  IdleFastForwardTests.mm
+//  Clock SignalTests
+//
+//  Created on 19/10/2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "Z80.hpp"
+#include "6502.hpp"
+#include "6522.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/// Everything observable about a run, for comparison between accelerated and unaccelerated execution.
+struct Trace {
+	/// The time at which each interrupt was acknowledged.
+	std::vector<int> interrupt_times;
+	/// The time at the end of each call to run_for.
+	std::vector<int> run_end_times;
+	/// Register values at the end of the run.
+	std::vector<uint16_t> registers;
+	/// The number of units of time that were fast forwarded.
+	int fast_forwarded = 0;
+};
+
+/*!
+	A Z80 machine that, as per the MSX, inserts an extra half cycle of wait into every M1 cycle and
+	signals an interrupt every @c InterruptPeriod half cycles. The program halts, then counts interrupts in B.
+*/
+template <bool accelerate> class HaltingZ80: public CPU::Z80::BusHandler {
+	public:
+		static const int InterruptPeriod = 20000;
+
+		HaltingZ80() : z80_(*this) {
+			const uint8_t program[] = {
+				0xed, 0x56,		// IM 1
+				0xfb,			// EI
+				0x76,			// HALT
+				0x18, 0xfd,		// JR -3
+			};
+			std::copy(program, program + sizeof(program), memory_.begin());
+
+			const uint8_t handler[] = {
+				0x04,			// INC B
+				0xfb,			// EI
+				0xc9,			// RET
+			};
+			std::copy(handler, handler + sizeof(handler), memory_.begin() + 0x38);
+
+			z80_.set_value_of_register(CPU::Z80::Register::StackPointer, 0x8000);
+		}
+
+		HalfCycles perform_machine_cycle(const CPU::Z80::PartialMachineCycle &cycle) {
+			const HalfCycles addition((cycle.operation == CPU::Z80::PartialMachineCycle::ReadOpcode) ? 2 : 0);
+			const HalfCycles total_length = cycle.length + addition;
+			time_ += total_length.as_int();
+
+			if(cycle.is_terminal()) {
+				const uint16_t address = cycle.address ? *cycle.address : 0x0000;
+				switch(cycle.operation) {
+					default: break;
+
+					case CPU::Z80::PartialMachineCycle::ReadOpcode:
+					case CPU::Z80::PartialMachineCycle::Read:
+						*cycle.value = memory_[address];
+					break;
+					case CPU::Z80::PartialMachineCycle::Write:
+						memory_[address] = *cycle.value;
+					break;
+
+					case CPU::Z80::PartialMachineCycle::Interrupt:
+						trace.interrupt_times.push_back(time_);
+						z80_.set_interrupt_line(false);
+						time_until_interrupt_ = InterruptPeriod;
+						*cycle.value = 0xff;
+					break;
+				}
+			}
+
+			if(time_until_interrupt_ > 0) {
+				time_until_interrupt_ -= total_length.as_int();
+				if(time_until_interrupt_ <= 0) {
+					z80_.set_interrupt_line(true, HalfCycles(time_until_interrupt_));
+				}
+			}
+			return addition;
+		}
+
+		HalfCycles perform_halted_fetches(int &count, HalfCycles time_available) {
+			if(!accelerate) {
+				count = 0;
+				return HalfCycles(0);
+			}
+
+			// As per the MSX: each fetch is ten half cycles, and only those fetches that complete
+			// strictly before the next interrupt are performed.
+			count = std::min(count, time_available.as_int() / 10);
+			if(time_until_interrupt_ > 0) {
+				count = std::min(count, (time_until_interrupt_ - 1) / 10);
+			}
+			if(count <= 0) {
+				count = 0;
+				return HalfCycles(0);
+			}
+
+			time_ += count * 10;
+			time_until_interrupt_ -= count * 10;
+			trace.fast_forwarded += count;
+			return HalfCycles(count * 2);
+		}
+
+		void run_for(const Cycles cycles) {
+			z80_.run_for(cycles);
+			trace.run_end_times.push_back(time_);
+		}
+
+		Trace finish() {
+			using Register = CPU::Z80::Register;
+			for(const auto reg: {Register::ProgramCounter, Register::StackPointer, Register::BC, Register::R, Register::IFF1}) {
+				trace.registers.push_back(z80_.get_value_of_register(reg));
+			}
+			return trace;
+		}
+
+		Trace trace;
+
+	private:
+		CPU::Z80::Processor<HaltingZ80, false, false> z80_;
+		std::vector<uint8_t> memory_ = std::vector<uint8_t>(65536);
+		int time_ = 0;
+		int time_until_interrupt_ = InterruptPeriod;
+};
+
+/*!
+	A 6502 machine with, as per the Oric, a 6522 at $bf00 that signals an interrupt every @c InterruptPeriod cycles. The
+	program spins in an idle loop, which performs a write, until the interrupt handler sets a flag.
+*/
+template <bool accelerate> class IdlingMOS6502:
+	public CPU::MOS6502::BusHandler,
+	public MOS::MOS6522::IRQDelegatePortHandler::Delegate {
+	public:
+		static const int InterruptPeriod = 5000;
+
+		IdlingMOS6502() : mos6502_(*this), via_(via_port_handler_) {
+			const uint8_t program[] = {
+				0x58,				// CLI
+				0x85, 0x21,			// loop: STA $21
+				0xa5, 0x10,			// LDA $10
+				0xf0, 0xfa,			// BEQ loop
+				0xa9, 0x00,			// LDA #0
+				0x85, 0x10,			// STA $10
+				0x4c, 0x01, 0x02,	// JMP loop
+			};
+			std::copy(program, program + sizeof(program), memory_.begin() + 0x200);
+
+			const uint8_t handler[] = {
+				0xe6, 0x10,			// INC $10
+				0xad, 0x04, 0xbf,	// LDA $bf04
+				0x40,				// RTI
+			};
+			std::copy(handler, handler + sizeof(handler), memory_.begin() + 0x300);
+			memory_[0xfffe] = 0x00;
+			memory_[0xffff] = 0x03;
+
+			// Set timer 1 to free run, signalling an interrupt every InterruptPeriod cycles.
+			via_port_handler_.set_interrupt_delegate(this);
+			via_.set_register(0xb, 0x40);
+			via_.set_register(0xe, 0xc0);
+			via_.set_register(0x4, uint8_t(InterruptPeriod - 2));
+			via_.set_register(0x5, uint8_t((InterruptPeriod - 2) >> 8));
+
+			mos6502_.set_power_on(false);
+			mos6502_.set_value_of_register(CPU::MOS6502::Register::ProgramCounter, 0x200);
+			mos6502_.set_value_of_register(CPU::MOS6502::Register::A, 0x00);
+			if(accelerate) mos6502_.set_idle_loop_detection(16);
+		}
+
+		Cycles perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+			++time_;
+
+			if((address & 0xff00) == 0xbf00) {
+				if(isReadOperation(operation)) *value = via_.get_register(address);
+				else via_.set_register(address, *value);
+			} else if(isReadOperation(operation)) {
+				*value = memory_[address];
+				if(address == 0xfffe) trace.interrupt_times.push_back(time_);
+			} else {
+				memory_[address] = *value;
+			}
+
+			via_.run_for(Cycles(1));
+			return Cycles(1);
+		}
+
+		Cycles perform_idle_loop(const CPU::MOS6502::IdleLoop &loop) {
+			// As per the Oric: decline if the loop touches the VIA, otherwise advance only by
+			// iterations that end strictly before the VIA next signals an interrupt.
+			if(loop.lowest_data_address <= loop.highest_data_address && loop.highest_data_address >= 0xbf00) return Cycles(0);
+
+			int iterations = loop.maximum_iterations;
+			const HalfCycles time_until_interrupt = via_.get_time_until_interrupt();
+			if(time_until_interrupt >= HalfCycles(0)) {
+				iterations = std::min(iterations, (time_until_interrupt - HalfCycles(1)).cycles().as_int() / loop.iteration_length.as_int());
+			}
+			if(iterations <= 0) return Cycles(0);
+
+			const int duration = iterations * loop.iteration_length.as_int();
+			via_.run_for(Cycles(duration));
+			time_ += duration;
+			trace.fast_forwarded += duration;
+			return Cycles(duration);
+		}
+
+		void mos6522_did_change_interrupt_status(void *) {
+			mos6502_.set_irq_line(via_.get_interrupt_line());
+		}
+
+		void run_for(const Cycles cycles) {
+			mos6502_.run_for(cycles);
+			trace.run_end_times.push_back(time_);
+		}
+
+		Trace finish() {
+			using Register = CPU::MOS6502::Register;
+			for(const auto reg: {Register::ProgramCounter, Register::StackPointer, Register::Flags, Register::A, Register::X, Register::Y}) {
+				trace.registers.push_back(mos6502_.get_value_of_register(reg));
+			}
+			trace.registers.push_back(memory_[0x10]);
+			trace.registers.push_back(memory_[0x21]);
+			trace.registers.push_back(via_.get_register(0x4));
+			trace.registers.push_back(via_.get_register(0x5));
+			return trace;
+		}
+
+		Trace trace;
+
+	private:
+		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, IdlingMOS6502, false> mos6502_;
+		MOS::MOS6522::IRQDelegatePortHandler via_port_handler_;
+		MOS::MOS6522::MOS6522<MOS::MOS6522::IRQDelegatePortHandler> via_;
+		std::vector<uint8_t> memory_ = std::vector<uint8_t>(65536);
+		int time_ = 0;
+};
+
+/// Runs @c machine for @c total cycles in slices of @c slice cycles, returning its trace.
+template <typename Machine> Trace run(Machine &machine, int total, int slice) {
+	for(int c = 0; c < total; c += slice) {
+		machine.run_for(Cycles(slice));
+	}
+	return machine.finish();
+}
+
+}
+
+@interface IdleFastForwardTests : XCTestCase
+@end
+
+@implementation IdleFastForwardTests
+
+- (void)compareTrace:(const Trace &)accelerated withTrace:(const Trace &)unaccelerated {
+	XCTAssertGreaterThan(accelerated.fast_forwarded, 0, @"Fast forwarding was never used");
+	XCTAssertEqual(unaccelerated.fast_forwarded, 0);
+	XCTAssertGreaterThan(unaccelerated.interrupt_times.size(), 10);
+
+	XCTAssert(accelerated.interrupt_times == unaccelerated.interrupt_times, @"Interrupts were acknowledged at different times");
+	XCTAssert(accelerated.run_end_times == unaccelerated.run_end_times, @"Runs ended at different times");
+	XCTAssert(accelerated.registers == unaccelerated.registers, @"Final states differ");
+}
+
+- (void)testZ80HaltFastForward {
+	// Use a variety of slice lengths, including some much shorter and some longer than the interrupt period.
+	for(int slice: {7, 97, 1000, 12345}) {
+		HaltingZ80<true> accelerated;
+		HaltingZ80<false> unaccelerated;
+		[self
+			compareTrace:run(accelerated, 500000, slice)
+			withTrace:run(unaccelerated, 500000, slice)];
+	}
+}
+
+- (void)test6502IdleLoopFastForward {
+	for(int slice: {100, 997, 4000, 20011}) {
+		IdlingMOS6502<true> accelerated;
+		IdlingMOS6502<false> unaccelerated;
+		[self
+			compareTrace:run(accelerated, 200000, slice)
+			withTrace:run(unaccelerated, 200000, slice)];
+	}
+}
+
+@end
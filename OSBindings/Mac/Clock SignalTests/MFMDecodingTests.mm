@@ -0,0 +1,219 @@
+//
+//  MFMDecodingTests.mm
+//  Clock SignalTests
+//
+//  Created on 19/10/2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "Constants.hpp"
+#include "Encoder.hpp"
+#include "SegmentParser.hpp"
+#include "Shifter.hpp"
+#include "TrackSerialiser.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+/// Produces the tracks of a standard 40-track, nine-sector DSK-style disk, or of a five-sector FM disk.
+std::vector<std::shared_ptr<Storage::Disk::Track>> standard_tracks(bool is_double_density) {
+	std::vector<std::shared_ptr<Storage::Disk::Track>> tracks;
+	for(int track = 0; track < 40; ++track) {
+		std::vector<Storage::Encodings::MFM::Sector> sectors;
+		for(int sector = 0; sector < (is_double_density ? 9 : 5); ++sector) {
+			Storage::Encodings::MFM::Sector new_sector;
+			new_sector.address.track = uint8_t(track);
+			new_sector.address.sector = uint8_t(sector + 0xc1);
+			new_sector.size = is_double_density ? 2 : 1;
+			new_sector.samples.emplace_back();
+			for(int c = 0; c < (128 << new_sector.size); ++c) {
+				new_sector.samples[0].push_back(uint8_t(c*13 + sector*7 + track));
+			}
+			sectors.push_back(std::move(new_sector));
+		}
+		tracks.push_back(is_double_density ?
+			Storage::Encodings::MFM::GetMFMTrackWithSectors(sectors) :
+			Storage::Encodings::MFM::GetFMTrackWithSectors(sectors));
+	}
+	return tracks;
+}
+
+Storage::Time bit_length(bool is_double_density) {
+	return is_double_density ? Storage::Encodings::MFM::MFMBitLength : Storage::Encodings::MFM::FMBitLength;
+}
+
+}
+
+@interface MFMDecodingTests : XCTestCase
+@end
+
+@implementation MFMDecodingTests
+
+- (void)compareShiftersIsDoubleDensity:(bool)isDoubleDensity {
+	const auto track = standard_tracks(isDoubleDensity)[3];
+	const auto segment = Storage::Disk::track_serialisation(*track, bit_length(isDoubleDensity));
+
+	Storage::Encodings::MFM::Shifter bit_shifter, word_shifter;
+	bit_shifter.set_is_double_density(isDoubleDensity);
+	word_shifter.set_is_double_density(isDoubleDensity);
+
+	// Supply the segment to one shifter a bit at a time and to the other in words of varying
+	// length; every token should be found in the same place with the same CRC.
+	std::size_t word_cursor = 0;
+	uint64_t word = 0;
+	int word_length = 0, tokens = 0;
+	for(std::size_t bit_cursor = 0; bit_cursor < segment.data.size(); ++bit_cursor) {
+		bit_shifter.add_input_bit(segment.data[bit_cursor] ? 1 : 0);
+		if(bit_shifter.get_token() == Storage::Encodings::MFM::Shifter::Token::None) continue;
+
+		while(true) {
+			if(!word_length) {
+				word_length = int(std::min(segment.data.size() - word_cursor, std::size_t(1 + (word_cursor % 61))));
+				word = 0;
+				for(int c = 0; c < word_length; ++c) {
+					word = (word << 1) | (segment.data[word_cursor + std::size_t(c)] ? 1 : 0);
+				}
+			}
+
+			const int consumed = word_shifter.add_input_bits(word, word_length);
+			word_length -= consumed;
+			word_cursor += std::size_t(consumed);
+			if(word_shifter.get_token() != Storage::Encodings::MFM::Shifter::Token::None) break;
+		}
+
+		XCTAssertEqual(word_cursor, bit_cursor + 1);
+		XCTAssertEqual(word_shifter.get_token(), bit_shifter.get_token());
+		XCTAssertEqual(word_shifter.get_byte(), bit_shifter.get_byte());
+		XCTAssertEqual(word_shifter.get_crc_generator().get_value(), bit_shifter.get_crc_generator().get_value());
+		++tokens;
+
+		// Switch sync obedience periodically, as a controller would upon reading a mark.
+		if(!(tokens % 37)) {
+			bit_shifter.set_should_obey_syncs(tokens % 74);
+			word_shifter.set_should_obey_syncs(tokens % 74);
+		}
+	}
+	XCTAssertGreaterThan(tokens, 0);
+}
+
+- (void)testMFMShifters {
+	[self compareShiftersIsDoubleDensity:true];
+}
+
+- (void)testFMShifters {
+	[self compareShiftersIsDoubleDensity:false];
+}
+
+/// Supplies a track to a shifter and checks its CRC every @c interval tokens against a CRC that is fed one byte
+/// at a time as each token is found. The shifter adds bytes to its generator in groups, so this checks that
+/// none are lost or reordered, whenever the generator is inspected.
+- (void)compareCRCIsDoubleDensity:(bool)isDoubleDensity interval:(int)interval {
+	const auto track = standard_tracks(isDoubleDensity)[5];
+	const auto segment = Storage::Disk::track_serialisation(*track, bit_length(isDoubleDensity));
+
+	Storage::Encodings::MFM::Shifter shifter;
+	shifter.set_is_double_density(isDoubleDensity);
+	CRC::CCITT bytewise_crc;
+	int tokens = 0, valid_crcs = 0, bytes_until_syncs = 0;
+	for(const auto bit: segment.data) {
+		shifter.add_input_bit(bit ? 1 : 0);
+		const auto token = shifter.get_token();
+		switch(token) {
+			case Storage::Encodings::MFM::Shifter::Token::None: continue;
+
+			case Storage::Encodings::MFM::Shifter::Token::Sync:
+				if(shifter.get_byte() == Storage::Encodings::MFM::MFMSyncByteValue) {
+					bytewise_crc.set_value(Storage::Encodings::MFM::MFMPostSyncCRCValue);
+				}
+			break;
+
+			case Storage::Encodings::MFM::Shifter::Token::Byte:
+				bytewise_crc.add(shifter.get_byte());
+			break;
+
+			default:
+				// An FM mark begins a new CRC; an MFM mark is just the byte following a sync.
+				if(!isDoubleDensity) bytewise_crc.reset();
+				bytewise_crc.add(shifter.get_byte());
+			break;
+		}
+
+		// As a controller would, ignore syncs within the body and CRC of each header and sector.
+		if(token == Storage::Encodings::MFM::Shifter::Token::ID) {
+			bytes_until_syncs = 6;
+		} else if(token == Storage::Encodings::MFM::Shifter::Token::Data) {
+			bytes_until_syncs = (isDoubleDensity ? 512 : 256) + 2;
+		} else if(bytes_until_syncs) {
+			--bytes_until_syncs;
+		}
+		shifter.set_should_obey_syncs(!bytes_until_syncs);
+
+		++tokens;
+		if(!(tokens % interval)) {
+			XCTAssertEqual(shifter.get_crc_generator().get_value(), bytewise_crc.get_value(), @"CRC differs after token %d", tokens);
+			valid_crcs += !bytewise_crc.get_value();
+		}
+	}
+
+	XCTAssertEqual(shifter.get_crc_generator().get_value(), bytewise_crc.get_value());
+	XCTAssertGreaterThan(tokens, 0);
+	if(interval == 1) {
+		// Every ID and data CRC should have been seen to be valid.
+		XCTAssertGreaterThanOrEqual(valid_crcs, isDoubleDensity ? 18 : 10);
+	}
+}
+
+- (void)testCRC {
+	for(const bool is_double_density: {false, true}) {
+		for(const int interval: {1, 5, 8, 13}) {
+			[self compareCRCIsDoubleDensity:is_double_density interval:interval];
+		}
+	}
+}
+
+- (void)testParsing {
+	for(bool is_double_density: {false, true}) {
+		const auto tracks = standard_tracks(is_double_density);
+		for(std::size_t track = 0; track < tracks.size(); ++track) {
+			const auto sectors = Storage::Encodings::MFM::sectors_from_segment(
+				Storage::Disk::track_serialisation(*tracks[track], bit_length(is_double_density)),
+				is_double_density);
+			XCTAssertEqual(sectors.size(), std::size_t(is_double_density ? 9 : 5));
+
+			for(const auto &pair: sectors) {
+				const auto &sector = pair.second;
+				XCTAssertEqual(sector.address.track, uint8_t(track));
+				XCTAssertEqual(sector.samples[0].size(), std::size_t(128 << sector.size));
+				XCTAssertEqual(sector.samples[0][1], uint8_t(13 + (sector.address.sector - 0xc1)*7 + int(track)));
+			}
+		}
+	}
+}
+
+- (void)testSerialisationThroughput {
+	const auto tracks = standard_tracks(true);
+	[self measureBlock:^{
+		for(const auto &track: tracks) {
+			Storage::Disk::track_serialisation(*track, Storage::Encodings::MFM::MFMBitLength);
+		}
+	}];
+}
+
+- (void)testParsingThroughput {
+	std::vector<Storage::Disk::PCMSegment> segments;
+	for(const auto &track: standard_tracks(true)) {
+		segments.push_back(Storage::Disk::track_serialisation(*track, Storage::Encodings::MFM::MFMBitLength));
+	}
+
+	[self measureBlock:^{
+		for(const auto &segment: segments) {
+			Storage::Disk::PCMSegment copy = segment;
+			Storage::Encodings::MFM::sectors_from_segment(std::move(copy), true);
+		}
+	}];
+}
+
+@end
@@ -0,0 +1,107 @@
+//
+//  MOS6502DisassemblerTests.mm
+//  Clock SignalTests
+//
+//  Created on 19/10/2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Analyser/Static/Disassembler/6502.hpp"
+
+#include <mutex>
+#include <vector>
+
+using namespace Analyser::Static::MOS6502;
+
+namespace {
+
+/// Captures everything in a FlatDisassembly that is meaningful, in the order it was found.
+struct Summary {
+	std::vector<uint16_t> instruction_addresses;
+	std::vector<int> instructions;
+	std::vector<std::vector<uint16_t>> sets;
+
+	Summary() {}
+	Summary(const FlatDisassembly &disassembly) :
+		instruction_addresses(disassembly.instruction_addresses.begin(), disassembly.instruction_addresses.end()) {
+		for(const auto address: instruction_addresses) {
+			const Instruction &instruction = disassembly.instructions_by_address[address];
+			instructions.push_back(instruction.address);
+			instructions.push_back(instruction.operation);
+			instructions.push_back(instruction.addressing_mode);
+			instructions.push_back(instruction.operand);
+		}
+		for(const auto set: {
+			&disassembly.outward_calls, &disassembly.internal_calls,
+			&disassembly.external_stores, &disassembly.external_loads, &disassembly.external_modifies,
+			&disassembly.internal_stores, &disassembly.internal_loads, &disassembly.internal_modifies}) {
+			sets.emplace_back(set->begin(), set->end());
+		}
+	}
+
+	bool operator ==(const Summary &rhs) const {
+		return instruction_addresses == rhs.instruction_addresses && instructions == rhs.instructions && sets == rhs.sets;
+	}
+};
+
+}
+
+@interface MOS6502DisassemblerTests : XCTestCase
+@end
+
+@implementation MOS6502DisassemblerTests
+
+/// Disassembles a collection of 4kb banks of arbitrary content both via DisassembleBanks and one after another
+/// via Disassemble, and checks that the two agree for every bank.
+- (void)testDisassembleBanksMatchesSequential {
+	const std::size_t bank_count = 64;
+	const std::function<std::size_t(uint16_t)> address_mapper = [](uint16_t address) {
+		if(!(address & 0x1000)) return static_cast<std::size_t>(-1);
+		return static_cast<std::size_t>(address & 0xfff);
+	};
+
+	// Fill each bank with pseudo-random content, then point its vectors somewhere within it.
+	std::vector<std::vector<uint8_t>> banks(bank_count);
+	std::vector<std::vector<uint16_t>> entry_points(bank_count);
+	uint32_t seed = 0x12345678;
+	for(std::size_t bank = 0; bank < bank_count; ++bank) {
+		banks[bank].resize(4096);
+		for(auto &byte: banks[bank]) {
+			seed = seed * 1103515245 + 12345;
+			byte = uint8_t(seed >> 16);
+		}
+		entry_points[bank] = {
+			uint16_t(0x1000 | ((bank * 61) & 0xfff)),
+			uint16_t(0x1000 | ((bank * 1021 + 7) & 0xfff))
+		};
+	}
+
+	std::vector<Summary> sequential;
+	FlatDisassembly disassembly;
+	for(std::size_t bank = 0; bank < bank_count; ++bank) {
+		Disassemble(disassembly, banks[bank], address_mapper, entry_points[bank]);
+		sequential.emplace_back(disassembly);
+	}
+
+	std::vector<Summary> parallel(bank_count);
+	std::vector<int> receipts(bank_count);
+	std::mutex mutex;
+	DisassembleBanks(banks, address_mapper, entry_points, [&parallel, &receipts, &mutex] (std::size_t bank, const FlatDisassembly &disassembly) {
+		std::lock_guard<std::mutex> lock(mutex);
+		parallel[bank] = Summary(disassembly);
+		++receipts[bank];
+	});
+
+	std::size_t total_instructions = 0;
+	for(std::size_t bank = 0; bank < bank_count; ++bank) {
+		XCTAssertEqual(receipts[bank], 1, @"Bank %zu received %d times", bank, receipts[bank]);
+		XCTAssert(parallel[bank] == sequential[bank], @"Bank %zu differs", bank);
+		total_instructions += sequential[bank].instruction_addresses.size();
+	}
+
+	// Make sure that there was something to compare.
+	XCTAssertGreaterThan(total_instructions, bank_count * 4);
+}
+
+@end
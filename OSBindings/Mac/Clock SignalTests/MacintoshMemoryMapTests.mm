@@ -0,0 +1,156 @@
+//
+//  MacintoshMemoryMapTests.mm
+//  Clock SignalTests
+//
+//  Created on 19/10/2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Apple/Macintosh/MemoryMap.hpp"
+
+#include <vector>
+
+using Model = Analyser::Static::Macintosh::Target::Model;
+using namespace Apple::Macintosh;
+
+namespace {
+
+struct Region {
+	uint32_t start, end;
+	BusDevice device;
+};
+
+/// @returns The device at byte address @c address according to the Macintosh's address decoding,
+/// given @c model and the state of the ROM overlay.
+BusDevice device_at(Model model, bool rom_is_overlay, uint32_t address) {
+	static const std::vector<Region> small_overlay = {
+		{0x000000, 0x100000, BusDevice::ROM},
+		{0x100000, 0x200000, BusDevice::Unassigned},
+		{0x200000, 0x300000, BusDevice::ROM},
+		{0x300000, 0x400000, BusDevice::Unassigned},
+		{0x400000, 0x500000, BusDevice::ROM},
+		{0x500000, 0x600000, BusDevice::Unassigned},
+		{0x600000, 0x800000, BusDevice::RAM},
+	};
+	static const std::vector<Region> small_normal = {
+		{0x000000, 0x400000, BusDevice::RAM},
+		{0x400000, 0x500000, BusDevice::ROM},
+		{0x500000, 0x800000, BusDevice::Unassigned},
+	};
+	static const std::vector<Region> plus_overlay = {
+		{0x000000, 0x100000, BusDevice::ROM},
+		{0x100000, 0x400000, BusDevice::Unassigned},
+		{0x400000, 0x500000, BusDevice::ROM},
+		{0x500000, 0x580000, BusDevice::Unassigned},
+		{0x580000, 0x600000, BusDevice::SCSI},
+		{0x600000, 0x800000, BusDevice::RAM},
+	};
+	static const std::vector<Region> plus_normal = {
+		{0x000000, 0x400000, BusDevice::RAM},
+		{0x400000, 0x500000, BusDevice::ROM},
+		{0x500000, 0x580000, BusDevice::Unassigned},
+		{0x580000, 0x600000, BusDevice::SCSI},
+		{0x600000, 0x800000, BusDevice::Unassigned},
+	};
+	static const std::vector<Region> io = {
+		{0x800000, 0x900000, BusDevice::Unassigned},
+		{0x900000, 0xa00000, BusDevice::SCCReadResetPhase},
+		{0xa00000, 0xb00000, BusDevice::Unassigned},
+		{0xb00000, 0xc00000, BusDevice::SCCWrite},
+		{0xc00000, 0xd00000, BusDevice::Unassigned},
+		{0xd00000, 0xe00000, BusDevice::IWM},
+		{0xe00000, 0xe80000, BusDevice::Unassigned},
+		{0xe80000, 0xf00000, BusDevice::VIA},
+		{0xf00000, 0xf80000, BusDevice::PhaseRead},
+		{0xf80000, 0x1000000, BusDevice::Unassigned},
+	};
+
+	const auto &lower =
+		(model == Model::MacPlus) ?
+			(rom_is_overlay ? plus_overlay : plus_normal) :
+			(rom_is_overlay ? small_overlay : small_normal);
+	for(const auto regions: {&lower, &io}) {
+		for(const auto &region: *regions) {
+			if(address >= region.start && address < region.end) return region.device;
+		}
+	}
+	return BusDevice::Unassigned;
+}
+
+}
+
+@interface MacintoshMemoryMapTests : XCTestCase
+@end
+
+@implementation MacintoshMemoryMapTests
+
+/// Walks the whole address space of every model, with the ROM overlay both enabled and disabled, reading and
+/// writing words via the page table and via the device decode, and checks that the two always agree.
+- (void)testPageTableMatchesDeviceDecode {
+	for(const auto model: {Model::Mac128k, Model::Mac512k, Model::Mac512ke, Model::MacPlus}) {
+		const uint32_t ram_mask = ((model == Model::Mac128k) ? 128*1024 : 512*1024) / 2 - 1;
+		const uint32_t rom_mask = ((model >= Model::Mac512ke) ? 128*1024 : 64*1024) / 2 - 1;
+
+		std::vector<uint16_t> rom(rom_mask + 1);
+		for(size_t c = 0; c < rom.size(); ++c) rom[c] = uint16_t(c * 3 + 1);
+
+		for(const bool rom_is_overlay: {false, true}) {
+			std::vector<uint16_t> ram(ram_mask + 1);
+			for(size_t c = 0; c < ram.size(); ++c) ram[c] = uint16_t(c ^ 0x5555);
+			std::vector<uint16_t> expected_ram = ram;
+
+			MemoryMap map;
+			map.populate(model, rom_is_overlay, ram.data(), ram_mask, rom.data(), rom_mask);
+
+			// Visit several words in each 64kb of the address space, including the first and last.
+			for(uint32_t address = 0; address < 0x1000000; address += 0x1000) {
+				for(const uint32_t offset: {0x000, 0x4a2, 0xffe}) {
+					const uint32_t byte_address = address + offset;
+					const uint32_t word_address = byte_address >> 1;
+					const BusDevice device = device_at(model, rom_is_overlay, byte_address);
+					const MemoryPage &page = map.pages[word_address >> 18];
+
+					XCTAssert(map.devices[word_address >> 18] == device, @"Device mismatch at %06x", byte_address);
+					XCTAssertEqual(page.is_ram, device == BusDevice::RAM, @"RAM flag mismatch at %06x", byte_address);
+
+					// Reads: the device decode reads RAM and ROM; nothing else is plain memory.
+					switch(device) {
+						case BusDevice::RAM:
+							XCTAssert(page.read != nullptr, @"No RAM read pointer at %06x", byte_address);
+							if(page.read) {
+								XCTAssertEqual(page.read[word_address & page.mask], expected_ram[word_address & ram_mask], @"RAM read mismatch at %06x", byte_address);
+							}
+						break;
+						case BusDevice::ROM:
+							XCTAssert(page.read != nullptr, @"No ROM read pointer at %06x", byte_address);
+							if(page.read) {
+								XCTAssertEqual(page.read[word_address & page.mask], rom[word_address & rom_mask], @"ROM read mismatch at %06x", byte_address);
+							}
+						break;
+						default:
+							XCTAssert(page.read == nullptr, @"Unexpected read pointer at %06x", byte_address);
+						break;
+					}
+
+					// Writes: the device decode writes to RAM only, ignoring writes to ROM and passing
+					// anything else to the relevant device.
+					const uint16_t value = uint16_t(byte_address ^ (byte_address >> 16));
+					if(device == BusDevice::RAM) {
+						expected_ram[word_address & ram_mask] = value;
+						XCTAssert(page.write != nullptr, @"No RAM write pointer at %06x", byte_address);
+					} else {
+						XCTAssert(page.write == nullptr, @"Unexpected write pointer at %06x", byte_address);
+					}
+					if(page.write) {
+						page.write[word_address & page.mask] = value;
+					}
+				}
+			}
+
+			XCTAssert(ram == expected_ram);
+		}
+	}
+}
+
+@end
@@ -11,6 +11,37 @@
 
 #include "9918.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+/// Records, in order, every pixel posted as part of a run of pixels. Single-pixel data areas are
+/// ignored, as they're used for borders, which may legitimately be posted in differing pieces.
+class RecordingScanTarget: public Outputs::Display::ScanTarget {
+	public:
+		void set_modals(Modals) override {}
+		Scan *begin_scan() override { return &scan_; }
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) override {
+			buffer_.resize(required_length * 4);
+			return buffer_.data();
+		}
+		void end_data(size_t actual_length) override {
+			if(actual_length < 2) return;
+			pixels.insert(pixels.end(), buffer_.begin(), buffer_.begin() + long(actual_length * 4));
+		}
+		void submit() override {}
+
+		std::vector<uint8_t> pixels;
+
+	private:
+		Scan scan_;
+		std::vector<uint8_t> buffer_;
+};
+
+}
+
 @interface MasterSystemVDPTests : XCTestCase
 @end
 
@@ -157,6 +188,62 @@
 	}
 }
 
+/// Checks that a VDP that is polled throughout produces exactly the same output as one that isn't,
+/// i.e. that lines which are fetched and drawn piecemeal exactly match those done in a single pass.
+- (void)testPolledOutputMatchesUnpolled {
+	RecordingScanTarget targets[2];
+	for(int c = 0; c < 2; ++c) {
+		srand(1);
+		TI::TMS::TMS9918 vdp(TI::TMS::Personality::SMSVDP);
+		vdp.set_scan_target(&targets[c]);
+
+		// Fill CRAM and VRAM with a pattern, positioning sprites so that some are visible.
+		// CRAM is written first so that all resulting CRAM dots have been output before
+		// the comparison period.
+		vdp.set_register(1, 0x00);
+		vdp.set_register(1, 0xc0);
+		for(int colour = 0; colour < 32; ++colour) {
+			vdp.set_register(0, uint8_t(colour * 7));
+			vdp.run_for(HalfCycles(40));
+		}
+		vdp.set_register(1, 0x00);
+		vdp.set_register(1, 0x40);
+		uint32_t seed = 0x1234567;
+		for(int address = 0; address < 16384; ++address) {
+			seed = seed * 1664525 + 1013904223;
+			vdp.set_register(0, (address & 0x3f00) == 0x3f00 && (address & 0xff) < 64 ? uint8_t((seed >> 24) % 180) : uint8_t(seed >> 24));
+			vdp.run_for(HalfCycles(40));
+		}
+
+		// Select mode 4 with 8x16 sprites, the name table at 0x3800, sprites at 0x3f00 and a scroll position.
+		const uint8_t registers[][2] = {
+			{0x06, 0x80}, {0xe2, 0x81}, {0xff, 0x82}, {0xff, 0x85}, {0xfb, 0x86}, {0x03, 0x87}, {0x13, 0x88}, {0x05, 0x89}
+		};
+		for(const auto &pair: registers) {
+			vdp.set_register(1, pair[0]);
+			vdp.set_register(1, pair[1]);
+		}
+
+		// Run for a few frames, either in one go or while polling the status register
+		// at irregular intervals.
+		int remaining = 262 * 228 * 2 * 5;
+		if(c) {
+			while(remaining > 0) {
+				seed = seed * 1664525 + 1013904223;
+				const int step = std::min(remaining, 1 + int((seed >> 24) % 150));
+				vdp.run_for(HalfCycles(step));
+				vdp.get_register(1);
+				remaining -= step;
+			}
+		} else {
+			vdp.run_for(HalfCycles(remaining));
+		}
+	}
+
+	XCTAssertFalse(targets[0].pixels.empty());
+	XCTAssert(targets[0].pixels == targets[1].pixels);
+}
+
 - (void)testTimeUntilLine {
 	TI::TMS::TMS9918 vdp(TI::TMS::Personality::SMSVDP);
 
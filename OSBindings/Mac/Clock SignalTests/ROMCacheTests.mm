@@ -0,0 +1,157 @@
+//
+//  ROMCacheTests.mm
+//  Clock SignalTests
+//
+//  Created on 19/10/2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "ROMCache.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+/// Supplies a four-byte image for every ROM other than those named "missing.rom", counting the ROMs requested.
+struct CountingFetcher {
+	int requests = 0;
+
+	ROMMachine::ROMFetcher fetcher() {
+		return [this] (const std::vector<ROMMachine::ROM> &roms) {
+			std::vector<std::unique_ptr<std::vector<uint8_t>>> results;
+			for(const auto &rom: roms) {
+				++requests;
+				if(rom.file_name == "missing.rom") {
+					results.emplace_back(nullptr);
+				} else {
+					results.emplace_back(new std::vector<uint8_t>{0x01, 0x02, 0x03, 0x04});
+				}
+			}
+			return results;
+		};
+	}
+};
+
+const std::vector<ROMMachine::ROM> roms = {
+	ROMMachine::ROM("Test", "a test ROM", "test.rom", 4, 0u),
+	ROMMachine::ROM("Test", "a missing ROM", "missing.rom", 4, 0u),
+};
+
+const std::function<std::vector<uint16_t>(const std::vector<uint8_t> &)> big_endian = [] (const std::vector<uint8_t> &source) {
+	return std::vector<uint16_t>{uint16_t((source[0] << 8) | source[1]), uint16_t((source[2] << 8) | source[3])};
+};
+
+}
+
+@interface ROMCacheTests : XCTestCase
+@end
+
+@implementation ROMCacheTests
+
+- (void)testFetch {
+	ROMMachine::ROMCache cache;
+	CountingFetcher host;
+
+	auto first = cache.fetch(host.fetcher(), roms);
+	XCTAssertEqual(first.size(), 2);
+	XCTAssert(first[0] != nullptr);
+	XCTAssert(first[1] == nullptr);
+	XCTAssert(*first[0] == std::vector<uint8_t>({0x01, 0x02, 0x03, 0x04}));
+	XCTAssertEqual(host.requests, 2);
+
+	// The available ROM should now be shared, without asking the host again; the missing one should be requested again.
+	auto second = cache.fetch(host.fetcher(), roms);
+	XCTAssert(second[0] == first[0]);
+	XCTAssert(second[1] == nullptr);
+	XCTAssertEqual(host.requests, 3);
+
+	// Once no longer in use, the ROM should be released and requested again upon the next fetch.
+	const std::weak_ptr<const std::vector<uint8_t>> weak_first = first[0];
+	first.clear();
+	second.clear();
+	XCTAssert(weak_first.expired());
+
+	const auto third = cache.fetch(host.fetcher(), roms);
+	XCTAssert(*third[0] == std::vector<uint8_t>({0x01, 0x02, 0x03, 0x04}));
+	XCTAssertEqual(host.requests, 5);
+}
+
+- (void)testTransformed {
+	ROMMachine::ROMCache cache;
+	CountingFetcher host;
+	auto source = cache.fetch(host.fetcher(), roms)[0];
+
+	int transformations = 0;
+	const std::function<std::vector<uint16_t>(const std::vector<uint8_t> &)> counting_big_endian = [&transformations] (const std::vector<uint8_t> &source) {
+		++transformations;
+		return big_endian(source);
+	};
+
+	// Two requests for the same transformation should share a single result.
+	auto first = cache.transformed<std::vector<uint16_t>>(source, "big-endian", counting_big_endian);
+	auto second = cache.transformed<std::vector<uint16_t>>(source, "big-endian", counting_big_endian);
+	XCTAssert(first == second);
+	XCTAssert(*first == std::vector<uint16_t>({0x0102, 0x0304}));
+	XCTAssertEqual(transformations, 1);
+
+	// A differently-named transformation should be distinct.
+	const auto other = cache.transformed<std::vector<uint16_t>>(source, "other", counting_big_endian);
+	XCTAssert(other != first);
+	XCTAssertEqual(transformations, 2);
+
+	// Once no longer in use, the result should be released and recreated upon the next request.
+	std::weak_ptr<const std::vector<uint16_t>> weak_first = first;
+	first.reset();
+	second.reset();
+	XCTAssert(weak_first.expired());
+
+	const auto third = cache.transformed<std::vector<uint16_t>>(source, "big-endian", counting_big_endian);
+	XCTAssert(*third == std::vector<uint16_t>({0x0102, 0x0304}));
+	XCTAssertEqual(transformations, 3);
+
+	// A transformation should keep its source cached, and be found again from that source.
+	const std::weak_ptr<const std::vector<uint8_t>> weak_source = source;
+	source.reset();
+	XCTAssertFalse(weak_source.expired());
+
+	const int requests = host.requests;
+	source = cache.fetch(host.fetcher(), roms)[0];
+	XCTAssert(source == weak_source.lock());
+	XCTAssertEqual(host.requests, requests + 1);	// i.e. only the missing ROM.
+
+	const auto fourth = cache.transformed<std::vector<uint16_t>>(source, "big-endian", counting_big_endian);
+	XCTAssert(fourth == third);
+	XCTAssertEqual(transformations, 3);
+}
+
+- (void)testTransformedBySourceIdentity {
+	ROMMachine::ROMCache cache;
+	CountingFetcher host;
+	int transformations = 0;
+	const std::function<std::vector<uint16_t>(const std::vector<uint8_t> &)> counting_big_endian = [&transformations] (const std::vector<uint8_t> &source) {
+		++transformations;
+		return big_endian(source);
+	};
+
+	// A source that is equal in content, but a distinct image, should be transformed separately.
+	const auto source = cache.fetch(host.fetcher(), roms)[0];
+	const ROMMachine::SharedROM copy = std::make_shared<const std::vector<uint8_t>>(*source);
+	const auto first = cache.transformed<std::vector<uint16_t>>(source, "big-endian", counting_big_endian);
+	auto second = cache.transformed<std::vector<uint16_t>>(copy, "big-endian", counting_big_endian);
+	XCTAssert(first != second);
+	XCTAssertEqual(transformations, 2);
+
+	// Sources released by their callers should never be matched with a later source, even one allocated
+	// in the same place, so each of these should be transformed afresh.
+	std::vector<std::shared_ptr<const std::vector<uint16_t>>> results;
+	for(uint8_t c = 0; c < 10; ++c) {
+		const ROMMachine::SharedROM replacement = std::make_shared<const std::vector<uint8_t>>(std::vector<uint8_t>{c, 0x00, 0x00, c});
+		results.push_back(cache.transformed<std::vector<uint16_t>>(replacement, "big-endian", counting_big_endian));
+		XCTAssert(*results.back() == std::vector<uint16_t>({uint16_t(c << 8), c}));
+	}
+	XCTAssertEqual(transformations, 12);
+}
+
+@end
@@ -0,0 +1,169 @@
+//
+//  SessionHostTests.mm
+//  Clock SignalTests
+//
+//  Created on 19/10/2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "SessionHost.hpp"
+#include "AsyncTaskQueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// A machine that does nothing but record how it is run.
+class TestMachine: public Machine::DynamicMachine, public CRTMachine::Machine {
+	public:
+		/// The total amount of time for which this machine has been run.
+		std::atomic<double> run_time;
+		/// Set if this machine was ever run, or had an action performed, on two threads at once.
+		std::atomic<bool> was_reentered;
+		/// The number of actions performed upon this machine.
+		int actions = 0;
+
+		/// Creates a machine that spends @c work_duration on each call to run_for.
+		TestMachine(std::chrono::microseconds work_duration = std::chrono::microseconds(200)) :
+			run_time(0.0), was_reentered(false), work_duration_(work_duration), is_busy_(false) {}
+
+		/// Performs an action upon this machine, as if from the host.
+		void perform_action() {
+			enter();
+			++actions;
+			leave();
+		}
+
+		// CRTMachine::Machine overrides.
+		void set_scan_target(Outputs::Display::ScanTarget *) override {}
+		Outputs::Speaker::Speaker *get_speaker() override { return nullptr; }
+		void run_for(const Cycles) override {}
+		void run_for(Time::Seconds duration) override {
+			enter();
+
+			// Simulate some work.
+			std::this_thread::sleep_for(work_duration_);
+			run_time = run_time + duration;
+
+			leave();
+		}
+
+		// Machine::DynamicMachine overrides.
+		Activity::Source *activity_source() override { return nullptr; }
+		Configurable::Device *configurable_device() override { return nullptr; }
+		CRTMachine::Machine *crt_machine() override { return this; }
+		JoystickMachine::Machine *joystick_machine() override { return nullptr; }
+		KeyboardMachine::Machine *keyboard_machine() override { return nullptr; }
+		MouseMachine::Machine *mouse_machine() override { return nullptr; }
+		MediaTarget::Machine *media_target() override { return nullptr; }
+		void *raw_pointer() override { return this; }
+
+	private:
+		const std::chrono::microseconds work_duration_;
+		std::atomic<bool> is_busy_;
+
+		void enter() {
+			if(is_busy_.exchange(true)) was_reentered = true;
+		}
+		void leave() {
+			is_busy_ = false;
+		}
+};
+
+}
+
+@interface SessionHostTests : XCTestCase
+@end
+
+@implementation SessionHostTests
+
+- (void)testSlices {
+	const int session_count = 20;
+	const double test_length = 0.5;
+
+	Concurrency::WorkerPool pool(4);
+	Machine::SessionHost host(pool);
+
+	std::vector<TestMachine *> machines;
+	std::vector<Machine::SessionHost::SessionID> sessions;
+	for(int c = 0; c < session_count; ++c) {
+		machines.push_back(new TestMachine);
+		sessions.push_back(host.add_session(std::unique_ptr<Machine::DynamicMachine>(machines.back())));
+	}
+
+	// Apply a stream of actions while the sessions run.
+	const auto end_time = std::chrono::steady_clock::now() + std::chrono::duration<double>(test_length);
+	int actions = 0;
+	while(std::chrono::steady_clock::now() < end_time) {
+		for(const auto session: sessions) {
+			XCTAssertTrue(host.perform(session, [] (Machine::DynamicMachine &machine) {
+				static_cast<TestMachine *>(machine.raw_pointer())->perform_action();
+			}));
+		}
+		++actions;
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+
+	// Every session should have been kept close to real time.
+	const auto reports = host.get_session_reports();
+	XCTAssertEqual(reports.size(), session_count);
+	for(const auto &report: reports) {
+		XCTAssertLessThan(report.lag, 0.05);
+		XCTAssertGreaterThan(report.run_time, test_length * 0.5);
+		XCTAssertEqual(report.skipped_time, 0.0);
+	}
+
+	// Removing a session should return its machine, having performed all outstanding actions,
+	// and never having run it or performed an action on it concurrently.
+	for(int c = 0; c < session_count; ++c) {
+		const auto machine = host.remove_session(sessions[c]);
+		XCTAssert(machine.get() == machines[c]);
+		XCTAssertEqual(machines[c]->actions, actions);
+		XCTAssertFalse(machines[c]->was_reentered);
+		XCTAssertGreaterThan(machines[c]->run_time.load(), test_length * 0.5);
+	}
+
+	// The sessions should now be gone.
+	XCTAssertEqual(host.get_session_reports().size(), 0);
+	XCTAssert(host.remove_session(sessions[0]) == nullptr);
+	XCTAssertFalse(host.perform(sessions[0], [] (Machine::DynamicMachine &) {}));
+}
+
+- (void)testQueuesAreNotStarved {
+	// Host more sessions than the pool has threads, each of which takes a long time to run.
+	const auto work_duration = std::chrono::milliseconds(50);
+	Concurrency::WorkerPool pool(2);
+	Machine::SessionHost host(pool);
+	for(int c = 0; c < 4; ++c) {
+		host.add_session(std::unique_ptr<Machine::DynamicMachine>(new TestMachine(work_duration)));
+	}
+
+	// Tasks on a queue that shares the pool should nevertheless be performed promptly, rather than
+	// waiting for a slice to end.
+	Concurrency::AsyncTaskQueue queue(pool);
+	std::chrono::steady_clock::duration longest_wait(0);
+	for(int c = 0; c < 20; ++c) {
+		const auto enqueue_time = std::chrono::steady_clock::now();
+		std::atomic<bool> is_performed(false);
+		queue.enqueue([&longest_wait, &is_performed, enqueue_time] {
+			longest_wait = std::max(longest_wait, std::chrono::steady_clock::now() - enqueue_time);
+			is_performed = true;
+		});
+
+		// Wait rather than flush, as flush would perform the task here.
+		while(!is_performed) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(7));
+	}
+
+	XCTAssertLessThan(std::chrono::duration<double>(longest_wait).count(), std::chrono::duration<double>(work_duration).count() / 2.0);
+}
+
+@end
@@ -0,0 +1,265 @@
+//
+//  SharedMemoryScanTargetTests.mm
+//  Clock SignalTests
+//
+//  Created on 19/10/2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Outputs/SharedMemory/ScanTarget.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace Outputs::Display;
+
+namespace {
+
+/// @returns A segment name that is unique to this process and @c purpose; macOS limits such names to 31 characters.
+std::string segment_name(const char *purpose) {
+	return "/cs-test-" + std::to_string(getpid()) + "-" + purpose;
+}
+
+/// @returns Modals for Luminance8 input, with every numeric field set to @c tag.
+ScanTarget::Modals tagged_modals(int tag) {
+	ScanTarget::Modals modals;
+	modals.input_data_type = InputDataType::Luminance8;
+	modals.cycles_per_line = tag;
+	modals.expected_vertical_lines = tag;
+	modals.colour_cycle_numerator = tag;
+	modals.colour_cycle_denominator = tag;
+	for(auto &entry: modals.input_data_tweaks.palette) {
+		entry = uint32_t(tag);
+	}
+	return modals;
+}
+
+/// @returns @c true if every numeric field of @c modals has the same value, i.e. they weren't torn.
+bool modals_are_consistent(const ScanTarget::Modals &modals) {
+	const int tag = modals.cycles_per_line;
+	if(modals.expected_vertical_lines != tag) return false;
+	if(modals.colour_cycle_numerator != tag) return false;
+	if(modals.colour_cycle_denominator != tag) return false;
+	for(const auto entry: modals.input_data_tweaks.palette) {
+		if(entry != uint32_t(tag)) return false;
+	}
+	return true;
+}
+
+/// The number of pixels of data supplied with each scan; two fit within each row of the write area.
+const int ScanLength = 1000;
+
+/*!
+	Outputs a single visible line at @c y, comprising @c scans_per_line scans. Each carries @c serial, which is incremented
+	for each, in its cycles_since_end_of_horizontal_retrace, and data with value @c serial + x at each x.
+*/
+void output_line(ScanTarget &target, uint16_t y, int scans_per_line, uint16_t &serial) {
+	ScanTarget::Scan::EndPoint location{};
+	location.y = y;
+	target.announce(ScanTarget::Event::EndHorizontalRetrace, true, location, 0);
+
+	for(int c = 0; c < scans_per_line; ++c) {
+		uint8_t *const data = target.begin_data(ScanLength, 1);
+		if(data) {
+			for(int x = 0; x < ScanLength; ++x) {
+				data[x] = uint8_t(serial + x);
+			}
+			target.end_data(ScanLength);
+		}
+
+		ScanTarget::Scan *const scan = target.begin_scan();
+		if(scan) {
+			scan->end_points[0] = scan->end_points[1] = location;
+			scan->end_points[0].data_offset = 0;
+			scan->end_points[1].data_offset = ScanLength;
+			scan->end_points[0].cycles_since_end_of_horizontal_retrace = serial;
+			target.end_scan();
+		}
+		++serial;
+	}
+
+	target.announce(ScanTarget::Event::BeginHorizontalRetrace, false, location, 0);
+}
+
+}
+
+@interface SharedMemoryScanTargetTests : XCTestCase
+@end
+
+@implementation SharedMemoryScanTargetTests
+
+- (void)testModalsDiscardEarlierSubmissions {
+	SharedMemory::ScanTarget producer(segment_name("modals"));
+	SharedMemory::Reader reader(producer.name());
+	ScanTarget &target = producer;
+	uint16_t serial = 0;
+	int received_serial = -1;
+	ScanTarget::Modals received_modals;
+	const auto receiver = [&received_serial, &received_modals] (const SharedMemory::Reader::Submission &submission) {
+		received_modals = submission.modals;
+		received_serial = submission.scans[submission.begin.scan_buffer].scan.end_points[0].cycles_since_end_of_horizontal_retrace;
+	};
+
+	// Nothing can be read before modals are supplied.
+	output_line(target, 0, 1, serial);
+	target.submit();
+	XCTAssertFalse(reader.read(receiver));
+
+	// The first read after a change of modals should discard everything, including anything
+	// submitted since the change.
+	target.set_modals(tagged_modals(1));
+	target.submit();
+	output_line(target, 1, 1, serial);
+	target.submit();
+	XCTAssertFalse(reader.read(receiver));
+
+	// Thereafter submissions should be received.
+	output_line(target, 2, 1, serial);
+	target.submit();
+	XCTAssertTrue(reader.read(receiver));
+	XCTAssertEqual(received_serial, 2);
+	XCTAssertEqual(received_modals.cycles_per_line, 1);
+
+	// Anything produced but not yet submitted at the time of a change of modals shouldn't be submitted.
+	output_line(target, 3, 1, serial);
+	target.set_modals(tagged_modals(2));
+	target.submit();
+	XCTAssertFalse(reader.read(receiver));
+
+	output_line(target, 4, 1, serial);
+	target.submit();
+	XCTAssertTrue(reader.read(receiver));
+	XCTAssertEqual(received_serial, 4);
+	XCTAssertEqual(received_modals.cycles_per_line, 2);
+
+	// With nothing new submitted, there should be nothing to read.
+	XCTAssertFalse(reader.read(receiver));
+}
+
+- (void)testConcurrentModalsChanges {
+	SharedMemory::ScanTarget producer(segment_name("concurrent"));
+	SharedMemory::Reader reader(producer.name());
+	ScanTarget &target = producer;
+
+	// Change modals repeatedly, tagging each scan with the modals it was produced under. Output continues
+	// under each set of modals until the reader has received some of it.
+	const int final_tag = 500;
+	std::atomic<int> received_tag(0);
+	std::thread producer_thread([&target, &received_tag] {
+		for(int tag = 1; tag <= final_tag; ++tag) {
+			target.set_modals(tagged_modals(tag));
+			target.submit();
+
+			while(received_tag < tag) {
+				uint16_t serial = uint16_t(tag);
+				output_line(target, uint16_t(tag), 1, serial);
+				target.submit();
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	// Every submission should be received with consistent modals, which are those in effect when it was produced.
+	int torn_modals = 0, mismatched_scans = 0, regressions = 0;
+	while(received_tag < final_tag) {
+		reader.read([&] (const SharedMemory::Reader::Submission &submission) {
+			if(!modals_are_consistent(submission.modals)) ++torn_modals;
+
+			const int tag = submission.modals.cycles_per_line;
+			if(tag < received_tag) ++regressions;
+
+			for(int c = submission.begin.scan_buffer; c != submission.end.scan_buffer; c = (c + 1) % SharedMemory::ScanBufferSize) {
+				if(submission.scans[c].scan.end_points[0].cycles_since_end_of_horizontal_retrace != tag) ++mismatched_scans;
+			}
+			received_tag = tag;
+		});
+		std::this_thread::yield();
+	}
+	producer_thread.join();
+
+	XCTAssertEqual(torn_modals, 0);
+	XCTAssertEqual(mismatched_scans, 0);
+	XCTAssertEqual(regressions, 0);
+}
+
+- (void)testRingsWrapAround {
+	SharedMemory::ScanTarget producer(segment_name("wrap"));
+	SharedMemory::Reader reader(producer.name());
+	ScanTarget &target = producer;
+
+	target.set_modals(tagged_modals(1));
+	target.submit();
+	XCTAssertFalse(reader.read([] (const SharedMemory::Reader::Submission &) {}));
+
+	// The first line is never allocated, so output and consume one before checking anything.
+	uint16_t serial = 0;
+	output_line(target, 0, 2, serial);
+	target.submit();
+	XCTAssertTrue(reader.read([] (const SharedMemory::Reader::Submission &) {}));
+
+	// Output enough lines, scans and rows of data to pass all the way around each ring at least twice,
+	// reading only after every few lines so that some submissions themselves wrap around.
+	const int line_count = 5000;
+	const int scans_per_line = 2;
+	const uint16_t first_serial = serial;
+	uint16_t expected_serial = serial;
+	int bad_serials = 0, bad_lines = 0, bad_data = 0;
+	bool scans_wrapped = false, lines_wrapped = false, write_area_wrapped = false;
+	const auto receiver = [&] (const SharedMemory::Reader::Submission &submission) {
+		scans_wrapped |= submission.end.scan_buffer < submission.begin.scan_buffer;
+		lines_wrapped |= submission.end.line < submission.begin.line;
+		write_area_wrapped |= submission.end.write_area < submission.begin.write_area;
+
+		for(int c = submission.begin.scan_buffer; c != submission.end.scan_buffer; c = (c + 1) % SharedMemory::ScanBufferSize) {
+			const auto &scan = submission.scans[c];
+
+			// Scans should arrive in order, without omission, and each should fall on a newly-submitted line.
+			const uint16_t scan_serial = scan.scan.end_points[0].cycles_since_end_of_horizontal_retrace;
+			if(scan_serial != expected_serial) ++bad_serials;
+			expected_serial = uint16_t(scan_serial + 1);
+
+			const int line_offset = (scan.line - submission.begin.line + SharedMemory::LineBufferHeight) % SharedMemory::LineBufferHeight;
+			const int new_lines = (submission.end.line - submission.begin.line + SharedMemory::LineBufferHeight) % SharedMemory::LineBufferHeight;
+			if(line_offset < 1 || line_offset > new_lines || submission.lines[scan.line].end_points[0].y != scan.scan.end_points[0].y) {
+				++bad_lines;
+			}
+
+			const uint8_t *const data = &submission.write_area[
+				size_t(SharedMemory::write_area_address(scan.scan.end_points[0].data_offset, scan.data_y)) * submission.data_type_size
+			];
+			for(int x = 0; x < ScanLength; ++x) {
+				if(data[x] != uint8_t(scan_serial + x)) {
+					++bad_data;
+					break;
+				}
+			}
+		}
+	};
+
+	for(int line = 1; line <= line_count; ++line) {
+		output_line(target, uint16_t(line), scans_per_line, serial);
+		target.submit();
+		if(!(line % 3)) {
+			XCTAssertTrue(reader.read(receiver));
+		}
+	}
+	reader.read(receiver);
+
+	XCTAssertEqual(expected_serial, uint16_t(first_serial + line_count * scans_per_line));
+	XCTAssertEqual(bad_serials, 0);
+	XCTAssertEqual(bad_lines, 0);
+	XCTAssertEqual(bad_data, 0);
+
+	// Two scans of ScanLength fit per row of the write area, so each ring should have wrapped.
+	XCTAssertGreaterThan(line_count * scans_per_line, 2 * SharedMemory::ScanBufferSize);
+	XCTAssertGreaterThan(line_count, 2 * SharedMemory::LineBufferHeight);
+	XCTAssertGreaterThan(line_count * scans_per_line / 2, 2 * SharedMemory::WriteAreaHeight);
+	XCTAssertTrue(scans_wrapped);
+	XCTAssertTrue(lines_wrapped);
+	XCTAssertTrue(write_area_wrapped);
+}
+
+@end
@@ -0,0 +1,273 @@
+//
+//  Vic20ThreadedDriveTests.mm
+//  Clock SignalTests
+//
+//  Created on 19/10/2026.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Commodore/Vic-20/Vic20.hpp"
+#include "../../../Machines/CRTMachine.hpp"
+#include "../../../Analyser/Static/Commodore/Target.hpp"
+#include "../../../Storage/Disk/DiskImage/DiskImage.hpp"
+#include "../../../Storage/Disk/DiskImage/Formats/D64.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/*!
+	A stand-in Vic kernel, entered upon reset, which receives 32 bytes over the serial bus. Before each it releases
+	data to indicate that it is ready; it then samples data as clock is released for each of eight bits, logging
+	the byte to $1000 and the number of polls it spent waiting for each bit to $1100, and pulls data low to
+	acknowledge.
+
+	The number of polls ties the log to the relative timing of the two processors.
+*/
+const uint8_t vic_program[] = {
+	// start:
+		0x78,					// SEI
+		0xd8,					// CLD
+		0xa2, 0xff,				// LDX #$FF
+		0x9a,					// TXS
+		0xa9, 0xec,				// LDA #$EC
+		0x8d, 0x2c, 0x91,		// STA $912C	; release clock; hold data low
+		0xa2, 0x00,				// LDX #$00	; index into the poll-count log
+		0xa0, 0x00,				// LDY #$00	; index into the byte log
+	// byte:
+		0xa9, 0xcc,				// LDA #$CC
+		0x8d, 0x2c, 0x91,		// STA $912C	; release data: ready to receive
+		0xa9, 0x08,				// LDA #$08
+		0x85, 0xfa,				// STA $FA	; bits remaining
+	// bit:
+		0xa9, 0x00,				// LDA #$00
+		0x85, 0xfb,				// STA $FB	; polls
+	// high:
+		0xe6, 0xfb,				// INC $FB
+		0xad, 0x11, 0x91,		// LDA $9111
+		0x4a,					// LSR A	; clock -> carry
+		0x90, 0xf8,				// BCC high	; wait for clock to be released
+		0x4a,					// LSR A	; data -> carry
+		0x66, 0xfc,				// ROR $FC
+		0xa5, 0xfb,				// LDA $FB
+		0x9d, 0x00, 0x11,		// STA $1100,X	; log the number of polls
+		0xe8,					// INX
+	// low:
+		0xad, 0x11, 0x91,		// LDA $9111
+		0x4a,					// LSR A
+		0xb0, 0xfa,				// BCS low	; wait for clock to be pulled low
+		0xc6, 0xfa,				// DEC $FA
+		0xd0, 0xe1,				// BNE bit
+		0xa5, 0xfc,				// LDA $FC
+		0x99, 0x00, 0x10,		// STA $1000,Y	; log the byte
+		0xc8,					// INY
+		0xa9, 0xec,				// LDA #$EC
+		0x8d, 0x2c, 0x91,		// STA $912C	; pull data low: acknowledge
+		0xa9, 0x28,				// LDA #$28
+		0x85, 0xfb,				// STA $FB
+	// hold:
+		0xc6, 0xfb,				// DEC $FB
+		0xd0, 0xfc,				// BNE hold	; give the drive time to spot that
+		0xc0, 0x20,				// CPY #$20
+		0xd0, 0xc1,				// BNE byte
+	// done:
+		0x4c, 0x4d, 0xe0,		// JMP done
+	// rti:
+		0x40,					// RTI
+};
+const uint16_t vic_rti = 0xe050;
+
+/*!
+	A stand-in 1540 ROM, entered upon reset, which spins the disk and sends the third byte following each sync it
+	finds to the Vic, in the format expected by vic_program.
+*/
+const uint8_t drive_program[] = {
+	// start:
+		0x78,					// SEI
+		0xd8,					// CLD
+		0xa2, 0xff,				// LDX #$FF
+		0x9a,					// TXS
+		0xa9, 0x1a,				// LDA #$1A
+		0x8d, 0x02, 0x18,		// STA $1802	; serial VIA: data out, clock out, ATN acknowledge
+		0xa9, 0x08,				// LDA #$08
+		0x8d, 0x00, 0x18,		// STA $1800	; hold clock low; release data
+		0xa9, 0x6f,				// LDA #$6F
+		0x8d, 0x02, 0x1c,		// STA $1C02
+		0xa9, 0x6c,				// LDA #$6C
+		0x8d, 0x00, 0x1c,		// STA $1C00	; motor and LED on, density 3
+		0xa9, 0xee,				// LDA #$EE
+		0x8d, 0x0c, 0x1c,		// STA $1C0C	; have byte-ready set the overflow flag
+	// sync:
+		0x2c, 0x00, 0x1c,		// BIT $1C00
+		0x30, 0xfb,				// BMI sync	; wait for a sync
+		0xb8,					// CLV
+		0xa0, 0x03,				// LDY #$03
+	// byte:
+		0x50, 0xfe,				// BVC byte	; wait for a byte
+		0xb8,					// CLV
+		0xad, 0x01, 0x1c,		// LDA $1C01
+		0x88,					// DEY
+		0xd0, 0xf7,				// BNE byte	; keep the third following the sync
+		0x20, 0x35, 0xc0,		// JSR send
+		0x4c, 0x1e, 0xc0,		// JMP sync
+	// send:
+		0x85, 0x80,				// STA $80
+	// ready:
+		0xad, 0x00, 0x18,		// LDA $1800
+		0x29, 0x01,				// AND #$01
+		0xd0, 0xf9,				// BNE ready	; wait for data to be released
+		0xa2, 0x08,				// LDX #$08
+	// bit:
+		0x46, 0x80,				// LSR $80
+		0xa9, 0x08,				// LDA #$08
+		0xb0, 0x02,				// BCS one
+		0x09, 0x02,				// ORA #$02	; pull data low for a 0
+	// one:
+		0x8d, 0x00, 0x18,		// STA $1800
+		0x29, 0xf7,				// AND #$F7
+		0x8d, 0x00, 0x18,		// STA $1800	; release clock: bit is valid
+		0xa0, 0x0a,				// LDY #$0A
+	// d1:
+		0x88,					// DEY
+		0xd0, 0xfd,				// BNE d1
+		0x09, 0x08,				// ORA #$08
+		0x8d, 0x00, 0x18,		// STA $1800	; pull clock low
+		0xa0, 0x0a,				// LDY #$0A
+	// d2:
+		0x88,					// DEY
+		0xd0, 0xfd,				// BNE d2
+		0xca,					// DEX
+		0xd0, 0xde,				// BNE bit
+		0xa9, 0x08,				// LDA #$08
+		0x8d, 0x00, 0x18,		// STA $1800	; release data
+	// ack:
+		0xad, 0x00, 0x18,		// LDA $1800
+		0x29, 0x01,				// AND #$01
+		0xf0, 0xf9,				// BEQ ack	; wait for data to be pulled low
+		0x60,					// RTS
+	// rti:
+		0x40,					// RTI
+};
+const uint16_t drive_rti = 0xc06f;
+
+/// @returns A ROM image of @c size bytes with @c program at its start, and its vectors pointing into @c program.
+std::vector<uint8_t> rom_image(size_t size, const uint8_t *program, size_t program_size, uint16_t origin, uint16_t rti) {
+	std::vector<uint8_t> rom(size, 0xea);
+	std::copy(program, program + program_size, rom.begin());
+
+	const uint16_t vectors[] = {rti, origin, rti};
+	for(size_t c = 0; c < 3; ++c) {
+		rom[size - 6 + c*2] = uint8_t(vectors[c]);
+		rom[size - 5 + c*2] = uint8_t(vectors[c] >> 8);
+	}
+	return rom;
+}
+
+/// Supplies the stand-in kernel and drive ROMs, and empty images of any other ROM requested.
+std::vector<std::unique_ptr<std::vector<uint8_t>>> fetch_roms(const std::vector<ROMMachine::ROM> &roms) {
+	std::vector<std::unique_ptr<std::vector<uint8_t>>> results;
+	for(const auto &rom: roms) {
+		if(rom.file_name == "kernel-pal.bin") {
+			results.emplace_back(new std::vector<uint8_t>(rom_image(rom.size, vic_program, sizeof(vic_program), 0xe000, vic_rti)));
+		} else if(rom.file_name == "1540.bin") {
+			results.emplace_back(new std::vector<uint8_t>(rom_image(rom.size, drive_program, sizeof(drive_program), 0xc000, drive_rti)));
+		} else {
+			results.emplace_back(new std::vector<uint8_t>(rom.size));
+		}
+	}
+	return results;
+}
+
+/// Records every change in level on the serial bus, in order.
+class BusMonitor: public Commodore::Serial::Port {
+	public:
+		std::vector<std::pair<Commodore::Serial::Line, Commodore::Serial::LineLevel>> changes;
+
+		void set_input(Commodore::Serial::Line line, Commodore::Serial::LineLevel value) override {
+			changes.emplace_back(line, value);
+		}
+};
+
+struct Result {
+	std::vector<std::pair<Commodore::Serial::Line, Commodore::Serial::LineLevel>> bus_changes;
+	std::vector<uint16_t> registers;
+	std::vector<uint8_t> log;
+};
+
+/// Runs the stand-in programs against the D64 at @c disk_path, with the drive on its own thread if @c threaded is @c true.
+Result run(const std::string &disk_path, bool threaded) {
+	Analyser::Static::Commodore::Target target;
+	target.has_c1540 = true;
+	target.media.disks.emplace_back(new Storage::Disk::DiskImageHolder<Storage::Disk::D64>(disk_path));
+
+	std::unique_ptr<Commodore::Vic20::Machine> machine(Commodore::Vic20::Machine::Vic20(&target, fetch_roms));
+	auto monitor = std::make_shared<BusMonitor>();
+	machine->attach_serial_port(monitor);
+
+	Configurable::SelectionSet selections;
+	selections["threadeddrive"] = std::unique_ptr<Configurable::Selection>(new Configurable::BooleanSelection(threaded));
+	dynamic_cast<Configurable::Device *>(machine.get())->set_selections(selections);
+
+	// Run for a second, in slices of the sort a host might use.
+	auto crt_machine = dynamic_cast<CRTMachine::Machine *>(machine.get());
+	for(int c = 0; c < 100; ++c) {
+		crt_machine->run_for(0.01);
+	}
+
+	Result result;
+	result.bus_changes = monitor->changes;
+	for(const auto reg: {CPU::MOS6502::ProgramCounter, CPU::MOS6502::Flags, CPU::MOS6502::A, CPU::MOS6502::X, CPU::MOS6502::Y, CPU::MOS6502::StackPointer}) {
+		result.registers.push_back(machine->get_value_of_register(reg));
+	}
+	for(uint16_t address = 0x1000; address < 0x1020; ++address) {
+		result.log.push_back(machine->get_memory_value(address));
+	}
+	for(uint16_t address = 0x1100; address < 0x1200; ++address) {
+		result.log.push_back(machine->get_memory_value(address));
+	}
+	return result;
+}
+
+}
+
+@interface Vic20ThreadedDriveTests : XCTestCase
+@end
+
+@implementation Vic20ThreadedDriveTests
+
+- (void)testThreadedDriveMatchesLockstep {
+	// Write a D64 in which every sector has distinct contents.
+	char disk_path[] = "/tmp/vic20-threaded-drive-XXXXXX";
+	const int file = mkstemp(disk_path);
+	XCTAssertNotEqual(file, -1);
+	FILE *const disk = fdopen(file, "wb");
+	for(int c = 0; c < 683 * 256; ++c) {
+		fputc((c * 7) ^ (c >> 8), disk);
+	}
+	fclose(disk);
+
+	const Result lockstep = run(disk_path, false);
+	const Result threaded = run(disk_path, true);
+	unlink(disk_path);
+
+	// Check that the test itself works: all 32 bytes should have been received and
+	// the Vic should have finished in its closing JMP.
+	XCTAssertGreaterThanOrEqual(lockstep.registers[0], 0xe04d);
+	XCTAssertLessThan(lockstep.registers[0], 0xe050);
+	XCTAssertEqual(lockstep.registers[4], 32);
+	XCTAssertGreaterThan(lockstep.bus_changes.size(), 32 * 16);
+
+	// The threaded drive should have produced exactly the same bus traffic, Vic state and record of timing.
+	XCTAssert(threaded.bus_changes == lockstep.bus_changes);
+	XCTAssert(threaded.registers == lockstep.registers);
+	XCTAssert(threaded.log == lockstep.log);
+}
+
+@end
@@ -13,6 +13,7 @@
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <thread>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -28,8 +29,9 @@
 
 #include "../../Activity/Observer.hpp"
 #include "../../Outputs/OpenGL/Primitives/Rectangle.hpp"
+#include "../../Outputs/OpenGL/Primitives/Shader.hpp"
 #include "../../Outputs/OpenGL/ScanTarget.hpp"
-#include "../../Outputs/OpenGL/Screenshot.hpp"
+#include "../../Outputs/OpenGL/ScreenshotQueue.hpp"
 
 namespace {
 
@@ -302,6 +304,30 @@ std::string system_get(const char *command) {
 	return result;
 }
 
+/*!
+	@returns A directory in which to cache compiled shaders, which is created if necessary — preferably
+		$XDG_CACHE_HOME/clksignal, otherwise ~/.cache/clksignal — or the empty string if none is available.
+*/
+std::string shader_cache_directory() {
+	std::string directory;
+	const char *const cache_home = getenv("XDG_CACHE_HOME");
+	if(cache_home && *cache_home) {
+		directory = cache_home;
+	} else {
+		const char *const home = getenv("HOME");
+		if(!home) return "";
+		directory = std::string(home) + "/.cache";
+		mkdir(directory.c_str(), 0700);
+	}
+
+	directory += "/clksignal";
+	mkdir(directory.c_str(), 0700);
+
+	struct stat directory_stats;
+	if(stat(directory.c_str(), &directory_stats) || !S_ISDIR(directory_stats.st_mode)) return "";
+	return directory;
+}
+
 /*!
 	Maintains a communicative window title.
 */
@@ -502,10 +528,32 @@ int main(int argc, char *argv[]) {
 	GLint target_framebuffer = 0;
 	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &target_framebuffer);
 
+	// Keep compiled shaders between sessions.
+	const std::string cache_directory = shader_cache_directory();
+	if(!cache_directory.empty()) {
+		Outputs::Display::OpenGL::Shader::set_binary_cache_directory(cache_directory);
+	}
+
 	// Setup output, assuming a CRT machine for now, and prepare a best-effort updater.
 	Outputs::Display::OpenGL::ScanTarget scan_target(target_framebuffer);
 	machine->crt_machine()->set_scan_target(&scan_target);
 
+	// Compile the shaders for all other display types on a separate context, so that a later
+	// change of display type needn't stall for compilation.
+	SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+	SDL_GLContext precompilation_context = SDL_GL_CreateContext(window);
+	SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+	SDL_GL_MakeCurrent(window, gl_context);
+
+	std::thread shader_precompiler;
+	if(precompilation_context) {
+		shader_precompiler = std::thread([window, precompilation_context, &scan_target] {
+			SDL_GL_MakeCurrent(window, precompilation_context);
+			scan_target.precompile_shaders();
+			SDL_GL_MakeCurrent(window, nullptr);
+		});
+	}
+
 	// For now, lie about audio output intentions.
 	auto speaker = machine->crt_machine()->get_speaker();
 	if(speaker) {
@@ -617,6 +665,10 @@ int main(int argc, char *argv[]) {
 	const bool uses_mouse = !!machine->mouse_machine();
 	bool should_quit = false;
 	Uint32 fullscreen_mode = 0;
+
+	// Screenshots are read back asynchronously, and saved on a background thread.
+	std::unique_ptr<Outputs::Display::OpenGL::ScreenshotQueue> screenshot_queue(new Outputs::Display::OpenGL::ScreenshotQueue);
+	std::string screenshot_target;
 	while(!should_quit) {
 		// Process all pending events.
 		SDL_Event event;
@@ -661,9 +713,6 @@ int main(int argc, char *argv[]) {
 
 					// Capture ctrl+shift+d as a take-a-screenshot command.
 					if(event.key.keysym.sym == SDLK_d && (SDL_GetModState()&KMOD_CTRL) && (SDL_GetModState()&KMOD_SHIFT)) {
-						// Grab the screen buffer.
-						Outputs::Display::OpenGL::Screenshot screenshot(4, 3);
-
 						// Pick the directory for images. Try `xdg-user-dir PICTURES` first.
 						std::string target_directory = system_get("xdg-user-dir PICTURES");
 
@@ -687,19 +736,8 @@ int main(int argc, char *argv[]) {
 							++index;
 						}
 
-						// Create a suitable SDL surface and save the thing.
-						const bool is_big_endian = SDL_BYTEORDER == SDL_BIG_ENDIAN;
-						SDL_Surface *const surface = SDL_CreateRGBSurfaceFrom(
-							screenshot.pixel_data.data(),
-							screenshot.width, screenshot.height,
-							8*4,
-							screenshot.width*4,
-							is_big_endian ? 0xff000000 : 0x000000ff,
-							is_big_endian ? 0x00ff0000 : 0x0000ff00,
-							is_big_endian ? 0x0000ff00 : 0x00ff0000,
-							0);
-						SDL_SaveBMP(surface, target.c_str());
-						SDL_FreeSurface(surface);
+						// Note the target; the capture will occur after the next frame is drawn.
+						screenshot_target = target;
 						break;
 					}
 
@@ -840,11 +878,38 @@ int main(int argc, char *argv[]) {
 		updater.update();
 		scan_target.update(int(window_width), int(window_height));
 		scan_target.draw(int(window_width), int(window_height));
+
+		// Begin capture of a screenshot, if one was requested; pick up any that have completed.
+		// If too many captures are already in flight, try again next frame.
+		if(!screenshot_target.empty()) {
+			const std::string target = screenshot_target;
+			const bool did_request = screenshot_queue->request(4, 3, [target] (const Outputs::Display::OpenGL::Screenshot &screenshot) {
+				// Create a suitable SDL surface and save the thing.
+				const bool is_big_endian = SDL_BYTEORDER == SDL_BIG_ENDIAN;
+				SDL_Surface *const surface = SDL_CreateRGBSurfaceFrom(
+					const_cast<uint8_t *>(screenshot.pixel_data.data()),
+					screenshot.width, screenshot.height,
+					8*4,
+					screenshot.width*4,
+					is_big_endian ? 0xff000000 : 0x000000ff,
+					is_big_endian ? 0x00ff0000 : 0x0000ff00,
+					is_big_endian ? 0x0000ff00 : 0x00ff0000,
+					0);
+				SDL_SaveBMP(surface, target.c_str());
+				SDL_FreeSurface(surface);
+			});
+			if(did_request) screenshot_target.clear();
+		}
+		screenshot_queue->update();
+
 		if(activity_observer) activity_observer->draw();
 		SDL_GL_SwapWindow(window);
 	}
 
-	// Clean up.
+	// Clean up, completing any outstanding screenshots while the OpenGL context still exists.
+	screenshot_queue.reset();
+	if(shader_precompiler.joinable()) shader_precompiler.join();
+	if(precompilation_context) SDL_GL_DeleteContext(precompilation_context);
 	joysticks.clear();
 	SDL_DestroyWindow( window );
 	SDL_Quit();
@@ -103,6 +103,12 @@ void CRT::set_input_data_type(Outputs::Display::InputDataType input_data_type) {
 	scan_target_->set_modals(scan_target_modals_);
 }
 
+void CRT::set_palette(const uint32_t *colours, size_t count) {
+	auto &palette = scan_target_modals_.input_data_tweaks.palette;
+	std::copy(colours, colours + std::min(count, sizeof(palette) / sizeof(*palette)), palette);
+	scan_target_->set_modals(scan_target_modals_);
+}
+
 void CRT::set_brightness(float brightness) {
 	scan_target_modals_.brightness = brightness;
 	scan_target_->set_modals(scan_target_modals_);
@@ -275,6 +275,9 @@ class CRT {
 		/*! Sets the input data type. */
 		void set_input_data_type(Outputs::Display::InputDataType);
 
+		/*! Sets the colours indexed by the PackedPalette input data types; up to 16 may be supplied. */
+		void set_palette(const uint32_t *colours, size_t count);
+
 		/*! Sets the output brightness. */
 		void set_brightness(float);
 };
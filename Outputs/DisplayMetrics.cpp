@@ -44,6 +44,25 @@ int Metrics::current_line() {
 	return lines_this_frame_;
 }
 
+// MARK: Repeated frame detection.
+
+void Metrics::announce_frame(bool was_skipped) {
+	std::atomic<int> &incremented = was_skipped ? frames_skipped_ : frames_drawn_;
+	std::atomic<int> &other = was_skipped ? frames_drawn_ : frames_skipped_;
+	++incremented;
+
+	// As per announce_draw_status, don't allow the record of history to extend too far into the past.
+	if(frames_skipped_ + frames_drawn_ > 200) {
+		if(other) --other; else --incremented;
+	}
+}
+
+float Metrics::skipped_frame_ratio() {
+	const int skipped = frames_skipped_;
+	const int total = skipped + frames_drawn_;
+	return total ? float(skipped) / float(total) : 0.0f;
+}
+
 // MARK: GPU processing speed decisions.
 
 void Metrics::announce_did_resize() {
@@ -12,6 +12,7 @@
 #include "ScanTarget.hpp"
 
 #include <array>
+#include <atomic>
 #include <chrono>
 
 namespace Outputs {
@@ -41,6 +42,12 @@ class Metrics {
 		/// @returns The number of lines since vertical retrace ended.
 		int current_line();
 
+		/// Notifies Metrics that a frame has been completed, and whether it was skipped as a repeat of its predecessor.
+		void announce_frame(bool was_skipped);
+
+		/// @returns The proportion of recent frames that were skipped as repeats of their predecessors.
+		float skipped_frame_ratio();
+
 	private:
 		int lines_this_frame_ = 0;
 		std::array<int, 20> line_total_history_;
@@ -49,6 +56,10 @@ class Metrics {
 
 		int frames_hit_ = 0;
 		int frames_missed_ = 0;
+
+		// These are announced by the producer of frames but may be inspected from elsewhere.
+		std::atomic<int> frames_skipped_{0};
+		std::atomic<int> frames_drawn_{0};
 };
 
 }
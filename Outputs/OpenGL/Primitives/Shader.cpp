@@ -9,6 +9,9 @@
 #include "Shader.hpp"
 
 #include "../../Log.hpp"
+
+#include <cstdio>
+#include <cstring>
 #include <vector>
 
 using namespace Outputs::Display::OpenGL;
@@ -17,6 +20,128 @@ namespace {
 	// The below is disabled because it isn't context/thread-specific. Which makes it
 	// fairly 'unuseful'.
 //	Shader *bound_shader = nullptr;
+
+	// Shaders may be constructed on multiple threads, each with its own context,
+	// so access to both the cache directory and the files within it is serialised.
+	std::mutex binary_cache_mutex;
+	std::string binary_cache_directory;
+
+	/// Implements a 64-bit FNV-1a hash, with each string terminated so that concatenations are distinct.
+	struct Hash {
+		uint64_t value = 0xcbf29ce484222325;
+
+		void add(const char *string) {
+			if(string) {
+				while(*string) add_byte(uint8_t(*string++));
+			}
+			add_byte(0);
+		}
+
+		void add_byte(uint8_t byte) {
+			value = (value ^ byte) * 0x100000001b3;
+		}
+	};
+}
+
+void Shader::set_binary_cache_directory(const std::string &directory) {
+	std::lock_guard<std::mutex> lock(binary_cache_mutex);
+	binary_cache_directory = directory;
+}
+
+std::string Shader::binary_cache_path(const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<AttributeBinding> &attribute_bindings) {
+	std::string directory;
+	{
+		std::lock_guard<std::mutex> lock(binary_cache_mutex);
+		directory = binary_cache_directory;
+	}
+	if(directory.empty()) return "";
+
+	// Program binaries are available only if the driver offers at least one format. Older
+	// drivers won't recognise the query at all, so clear any error that produces.
+	GLint format_count = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+	if(glGetError() != GL_NO_ERROR || !format_count) return "";
+
+	// Binaries are valid only for the driver that produced them.
+	Hash hash;
+	hash.add(reinterpret_cast<const char *>(glGetString(GL_VENDOR)));
+	hash.add(reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+	hash.add(reinterpret_cast<const char *>(glGetString(GL_VERSION)));
+
+	hash.add(vertex_shader.c_str());
+	hash.add(fragment_shader.c_str());
+	for(const auto &binding: attribute_bindings) {
+		hash.add(binding.name.c_str());
+		hash.add_byte(uint8_t(binding.index));
+	}
+
+	char name[21];
+	snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(hash.value));
+	return directory + "/" + name;
+}
+
+bool Shader::load_binary(const std::string &path) {
+	std::vector<uint8_t> contents;
+	{
+		std::lock_guard<std::mutex> lock_guard(binary_cache_mutex);
+		FILE *const file = std::fopen(path.c_str(), "rb");
+		if(!file) return false;
+
+		std::fseek(file, 0, SEEK_END);
+		const long size = std::ftell(file);
+		std::fseek(file, 0, SEEK_SET);
+		if(size > 0) {
+			contents.resize(size_t(size));
+			if(std::fread(contents.data(), 1, contents.size(), file) != contents.size()) contents.clear();
+		}
+		std::fclose(file);
+	}
+
+	// The file holds the binary's format followed by the binary itself.
+	if(contents.size() <= sizeof(GLenum)) return false;
+	GLenum format;
+	std::memcpy(&format, contents.data(), sizeof(format));
+	glProgramBinary(shader_program_, format, &contents[sizeof(GLenum)], GLsizei(contents.size() - sizeof(GLenum)));
+
+	// The driver is entitled to reject a binary for any reason — e.g. it has been updated
+	// in a way that doesn't affect its version string — in which case the program will need
+	// to be recompiled. So errors here are expected, and are not fatal.
+	GLint did_link = GL_FALSE;
+	glGetProgramiv(shader_program_, GL_LINK_STATUS, &did_link);
+	if(glGetError() != GL_NO_ERROR || did_link != GL_TRUE) {
+		LOG("Discarding cached shader binary " << path);
+		return false;
+	}
+
+	return true;
+}
+
+void Shader::save_binary(const std::string &path) {
+	GLint did_link = GL_FALSE, length = 0;
+	test_gl(glGetProgramiv, shader_program_, GL_LINK_STATUS, &did_link);
+	test_gl(glGetProgramiv, shader_program_, GL_PROGRAM_BINARY_LENGTH, &length);
+	if(did_link != GL_TRUE || length <= 0) return;
+
+	std::vector<uint8_t> contents(sizeof(GLenum) + size_t(length));
+	GLenum format = 0;
+	test_gl(glGetProgramBinary, shader_program_, length, &length, &format, &contents[sizeof(GLenum)]);
+	std::memcpy(contents.data(), &format, sizeof(format));
+	contents.resize(sizeof(GLenum) + size_t(length));
+
+	// Write to a temporary file and then rename, so that a partially-written file is never
+	// visible to a later load.
+	std::lock_guard<std::mutex> lock_guard(binary_cache_mutex);
+	const std::string temporary_path = path + ".tmp";
+	FILE *const file = std::fopen(temporary_path.c_str(), "wb");
+	if(!file) return;
+	const bool did_write = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+	std::fclose(file);
+
+	if(did_write) {
+		std::rename(temporary_path.c_str(), path.c_str());
+	} else {
+		std::remove(temporary_path.c_str());
+	}
 }
 
 GLuint Shader::compile_shader(const std::string &source, GLenum type) {
@@ -61,6 +186,17 @@ Shader::Shader(const std::string &vertex_shader, const std::string &fragment_sha
 
 void Shader::init(const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<AttributeBinding> &attribute_bindings) {
 	shader_program_ = glCreateProgram();
+
+	// Use a cached binary if there is one; otherwise start again with a fresh program.
+	const std::string cache_path = binary_cache_path(vertex_shader, fragment_shader, attribute_bindings);
+	if(!cache_path.empty()) {
+		if(load_binary(cache_path)) return;
+
+		glDeleteProgram(shader_program_);
+		shader_program_ = glCreateProgram();
+		test_gl(glProgramParameteri, shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
 	const GLuint vertex = compile_shader(vertex_shader, GL_VERTEX_SHADER);
 	const GLuint fragment = compile_shader(fragment_shader, GL_FRAGMENT_SHADER);
 
@@ -104,6 +240,10 @@ void Shader::init(const std::string &vertex_shader, const std::string &fragment_
 		throw ProgramLinkageError;
 	}
 #endif
+
+	if(!cache_path.empty()) {
+		save_binary(cache_path);
+	}
 }
 
 Shader::~Shader() {
@@ -55,6 +55,16 @@ public:
 	Shader(const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<std::string> &binding_names);
 	~Shader();
 
+	/*!
+		Nominates a directory in which linked program binaries will be stored, keyed by their source,
+		attribute bindings and the identity of the OpenGL driver, so that subsequent constructions of
+		identical shaders — including in future sessions — can skip compilation and linkage.
+
+		If this is never called, or the driver doesn't support program binaries, shaders are always
+		compiled from source. This may be called from any thread, but affects only shaders constructed afterwards.
+	*/
+	static void set_binary_cache_directory(const std::string &directory);
+
 	/*!
 		Performs an @c glUseProgram to make this the active shader unless:
 			(i) it was the previous shader bound; and
@@ -120,6 +130,11 @@ private:
 	void init(const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<AttributeBinding> &attribute_bindings);
 
 	GLuint compile_shader(const std::string &source, GLenum type);
+
+	/// @returns The name of the file in the binary cache that would hold this program, or the empty string if there is no cache.
+	static std::string binary_cache_path(const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<AttributeBinding> &attribute_bindings);
+	bool load_binary(const std::string &path);
+	void save_binary(const std::string &path);
 	GLuint shader_program_;
 
 	void flush_functions() const;
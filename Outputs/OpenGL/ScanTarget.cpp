@@ -11,6 +11,7 @@
 #include "OpenGL.hpp"
 #include "Primitives/Rectangle.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <limits>
@@ -65,17 +66,101 @@ const GLenum formatForDepth(std::size_t depth) {
 	}
 }
 
+/*!
+	@returns @c true if persistently-mapped buffers are available, and it is possible to draw
+	instances from an arbitrary starting point within a buffer; @c false otherwise.
+*/
+bool supportsPersistentBuffers() {
+#ifdef GL_VERSION_4_4
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	if(major > 4 || (major == 4 && minor >= 4)) return true;
+
+	bool has_buffer_storage = false, has_base_instance = false;
+	GLint extension_count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &extension_count);
+	for(GLint c = 0; c < extension_count; ++c) {
+		const auto name = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, GLuint(c)));
+		if(!name) continue;
+		has_buffer_storage |= !strcmp(name, "GL_ARB_buffer_storage");
+		has_base_instance |= !strcmp(name, "GL_ARB_base_instance");
+	}
+	return has_buffer_storage && has_base_instance;
+#else
+	return false;
+#endif
+}
+
+/*!
+	Draws @c count instances of a four-vertex triangle strip, starting from instance @c first
+	of buffers that are @c size instances long, wrapping around at the end if necessary.
+
+	This may be called only if persistent buffers are supported.
+*/
+void drawInstancesFrom(size_t first, size_t count, size_t size) {
+#ifdef GL_VERSION_4_4
+	const size_t first_portion = std::min(count, size - first);
+	test_gl(glDrawArraysInstancedBaseInstance, GL_TRIANGLE_STRIP, 0, 4, GLsizei(first_portion), GLuint(first));
+	if(first_portion < count) {
+		test_gl(glDrawArraysInstancedBaseInstance, GL_TRIANGLE_STRIP, 0, 4, GLsizei(count - first_portion), 0);
+	}
+#else
+	assert(false);
+#endif
+}
+
+/// Folds @c word into @c hash; this is intended to be cheap rather than cryptographically sound.
+inline uint64_t hashWord(uint64_t hash, uint64_t word) {
+	hash = (hash ^ word) * 0x9e3779b97f4a7c15;
+	return hash ^ (hash >> 29);
+}
+
+/// Folds @c length bytes from @c data into @c hash, a word at a time where possible.
+uint64_t hashBytes(uint64_t hash, const uint8_t *data, size_t length) {
+	while(length >= 8) {
+		uint64_t word;
+		memcpy(&word, data, 8);
+		hash = hashWord(hash, word);
+		data += 8;
+		length -= 8;
+	}
+	while(length--) {
+		hash = hashWord(hash, *data++);
+	}
+	return hash;
+}
+
+/// The flags used to create and map persistent buffers.
+#ifdef GL_VERSION_4_4
+constexpr GLbitfield PersistentBufferFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+#endif
+
 }
 
-template <typename T> void ScanTarget::allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name) {
-	const auto buffer_size = array.size() * sizeof(array[0]);
+void *ScanTarget::allocate_buffer(size_t buffer_size, GLenum target, GLuint &buffer_name, GLuint *vertex_array_name) {
+	void *mapping = nullptr;
+
 	test_gl(glGenBuffers, 1, &buffer_name);
-	test_gl(glBindBuffer, GL_ARRAY_BUFFER, buffer_name);
-	test_gl(glBufferData, GL_ARRAY_BUFFER, GLsizeiptr(buffer_size), NULL, GL_STREAM_DRAW);
+	test_gl(glBindBuffer, target, buffer_name);
+#ifdef GL_VERSION_4_4
+	if(buffers_are_persistent_) {
+		test_gl(glBufferStorage, target, GLsizeiptr(buffer_size), NULL, PersistentBufferFlags);
+		mapping = glMapBufferRange(target, 0, GLsizeiptr(buffer_size), PersistentBufferFlags);
+		test_gl_error();
+	} else
+#endif
+	{
+		test_gl(glBufferData, target, GLsizeiptr(buffer_size), NULL, GL_STREAM_DRAW);
+	}
 
-	test_gl(glGenVertexArrays, 1, &vertex_array_name);
-	test_gl(glBindVertexArray, vertex_array_name);
-	test_gl(glBindBuffer, GL_ARRAY_BUFFER, buffer_name);
+	if(vertex_array_name) {
+		test_gl(glGenVertexArrays, 1, vertex_array_name);
+		test_gl(glBindVertexArray, *vertex_array_name);
+		test_gl(glBindBuffer, target, buffer_name);
+	}
+
+	return mapping;
 }
 
 ScanTarget::ScanTarget(GLuint target_framebuffer, float output_gamma) :
@@ -88,13 +173,37 @@ ScanTarget::ScanTarget(GLuint target_framebuffer, float output_gamma) :
 	read_pointers_.store(write_pointers_);
 	submit_pointers_.store(write_pointers_);
 
-	// Allocate space for the scans and lines.
-	allocate_buffer(scan_buffer_, scan_buffer_name_, scan_vertex_array_);
-	allocate_buffer(line_buffer_, line_buffer_name_, line_vertex_array_);
+	pending_read_pointers_ = write_pointers_;
+
+	// Allocate space for the scans, lines and, if possible, the write area. If persistent
+	// buffers are available then these are mapped now and stay that way, with the client
+	// writing straight into them.
+	buffers_are_persistent_ = supportsPersistentBuffers();
+	if(buffers_are_persistent_) {
+		scan_buffer_ = static_cast<Scan *>(allocate_buffer(ScanBufferSize * sizeof(Scan), GL_ARRAY_BUFFER, scan_buffer_name_, &scan_vertex_array_));
+		line_buffer_ = static_cast<Line *>(allocate_buffer(LineBufferHeight * sizeof(Line), GL_ARRAY_BUFFER, line_buffer_name_, &line_vertex_array_));
+
+		// The write area is sized for the largest possible input data type, so that it
+		// needn't be reallocated upon a change of type.
+		persistent_write_area_ = static_cast<uint8_t *>(allocate_buffer(WriteAreaWidth * WriteAreaHeight * 4, GL_PIXEL_UNPACK_BUFFER, write_area_buffer_name_, nullptr));
+		test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, 0);
+
+		if(!scan_buffer_ || !line_buffer_ || !persistent_write_area_) {
+			delete_buffers();
+			buffers_are_persistent_ = false;
+		}
+	}
 
-	// TODO: if this is OpenGL 4.4 or newer, use glBufferStorage rather than glBufferData
-	// and specify GL_MAP_PERSISTENT_BIT. Then map the buffer now, and let the client
-	// write straight into it.
+	// Failing that, use CPU-side storage and copy to the GPU upon each update.
+	if(!buffers_are_persistent_) {
+		allocate_buffer(ScanBufferSize * sizeof(Scan), GL_ARRAY_BUFFER, scan_buffer_name_, &scan_vertex_array_);
+		allocate_buffer(LineBufferHeight * sizeof(Line), GL_ARRAY_BUFFER, line_buffer_name_, &line_vertex_array_);
+
+		scan_buffer_storage_.resize(ScanBufferSize);
+		line_buffer_storage_.resize(LineBufferHeight);
+		scan_buffer_ = scan_buffer_storage_.data();
+		line_buffer_ = line_buffer_storage_.data();
+	}
 
 	test_gl(glGenTextures, 1, &write_area_texture_name_);
 
@@ -104,13 +213,27 @@ ScanTarget::ScanTarget(GLuint target_framebuffer, float output_gamma) :
 	// Establish initial state for the two atomic flags.
 	is_updating_.clear();
 	is_drawing_to_accumulation_buffer_.clear();
+	accumulation_is_stale_ = false;
 }
 
 ScanTarget::~ScanTarget() {
 	while(is_updating_.test_and_set());
-	glDeleteBuffers(1, &scan_buffer_name_);
+	delete_buffers();
 	glDeleteTextures(1, &write_area_texture_name_);
+}
+
+void ScanTarget::delete_buffers() {
+	// Deleting a buffer implicitly unmaps it.
+	glDeleteBuffers(1, &scan_buffer_name_);
+	glDeleteBuffers(1, &line_buffer_name_);
+	glDeleteBuffers(1, &write_area_buffer_name_);
 	glDeleteVertexArrays(1, &scan_vertex_array_);
+	glDeleteVertexArrays(1, &line_vertex_array_);
+	scan_buffer_name_ = line_buffer_name_ = write_area_buffer_name_ = 0;
+	scan_vertex_array_ = line_vertex_array_ = 0;
+	scan_buffer_ = nullptr;
+	line_buffer_ = nullptr;
+	persistent_write_area_ = nullptr;
 }
 
 void ScanTarget::set_target_framebuffer(GLuint target_framebuffer) {
@@ -120,6 +243,14 @@ void ScanTarget::set_target_framebuffer(GLuint target_framebuffer) {
 }
 
 void ScanTarget::set_modals(Modals modals) {
+	// Packed data is expanded as it is received, so the pipeline sees only the unpacked type.
+	// This is on the thread that calls begin_data and end_data, so happens outside of the lock.
+	unpacker_.set_modals(modals, WriteAreaWidth);
+	modals.input_data_type = Outputs::Display::unpacked_data_type(modals.input_data_type);
+
+	// Ensure that the current frame won't be considered a repeat of the previous.
+	frame_hash_ = hashWord(frame_hash_, ++modals_generation_);
+
 	// Don't change the modals while drawing is ongoing; a previous set might be
 	// in the process of being established.
 	while(is_updating_.test_and_set());
@@ -135,7 +266,7 @@ Outputs::Display::ScanTarget::Scan *ScanTarget::begin_scan() {
 	const auto read_pointers = read_pointers_.load();
 
 	// Advance the pointer.
-	const auto next_write_pointer = decltype(write_pointers_.scan_buffer)((write_pointers_.scan_buffer + 1) % scan_buffer_.size());
+	const auto next_write_pointer = decltype(write_pointers_.scan_buffer)((write_pointers_.scan_buffer + 1) % ScanBufferSize);
 
 	// Check whether that's too many.
 	if(next_write_pointer == read_pointers.scan_buffer) {
@@ -152,8 +283,24 @@ Outputs::Display::ScanTarget::Scan *ScanTarget::begin_scan() {
 	return &result->scan;
 }
 
+void ScanTarget::hash_scan(const Outputs::Display::ScanTarget::Scan &scan) {
+	// Data offsets are hashed prior to being made relative to the write area, and hence
+	// are independent of where in the write area this frame's data happens to fall.
+	for(const auto &end_point: scan.end_points) {
+		frame_hash_ = hashWord(frame_hash_,
+			uint64_t(end_point.x) |
+			(uint64_t(end_point.y) << 16) |
+			(uint64_t(end_point.data_offset) << 32) |
+			(uint64_t(uint16_t(end_point.composite_angle)) << 48));
+		frame_hash_ = hashWord(frame_hash_, end_point.cycles_since_end_of_horizontal_retrace);
+	}
+	frame_hash_ = hashWord(frame_hash_, scan.composite_amplitude);
+}
+
 void ScanTarget::end_scan() {
 	if(vended_scan_) {
+		hash_scan(vended_scan_->scan);
+
 		vended_scan_->data_y = TextureAddressGetY(vended_write_area_pointer_);
 		vended_scan_->line = write_pointers_.line;
 		vended_scan_->scan.end_points[0].data_offset += TextureAddressGetX(vended_write_area_pointer_);
@@ -175,7 +322,7 @@ void ScanTarget::end_scan() {
 
 uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignment) {
 	if(allocation_has_failed_) return nullptr;
-	if(!write_area_texture_.size()) {
+	if(!write_area_texture_) {
 		allocation_has_failed_ = true;
 		return nullptr;
 	}
@@ -211,6 +358,9 @@ uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignmen
 	// Everything checks out, note expectation of a future end_data and return the pointer.
 	data_is_allocated_ = true;
 	vended_write_area_pointer_ = write_pointers_.write_area = TextureAddress(aligned_start_x, output_y);
+	if(unpacker_.bits_per_pixel()) {
+		return unpacker_.packed_area();
+	}
 	return &write_area_texture_[size_t(write_pointers_.write_area) * data_type_size_];
 
 	// Note state at exit:
@@ -220,6 +370,15 @@ uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignmen
 void ScanTarget::end_data(size_t actual_length) {
 	if(allocation_has_failed_ || !data_is_allocated_) return;
 
+	// Expand packed data into the write area. If the pipeline hasn't yet caught up
+	// with a change in data type then the write area won't be of the expected size,
+	// in which case just leave it alone.
+	if(unpacker_.bits_per_pixel() && unpacker_.unpacked_size() == data_type_size_) {
+		unpacker_.unpack(&write_area_texture_[size_t(write_pointers_.write_area) * data_type_size_], actual_length);
+	}
+
+	frame_hash_ = hashBytes(frame_hash_, &write_area_texture_[size_t(write_pointers_.write_area) * data_type_size_], actual_length * data_type_size_);
+
 	// Bookend the start of the new data, to safeguard for precision errors in sampling.
 	memcpy(
 		&write_area_texture_[size_t(write_pointers_.write_area - 1) * data_type_size_],
@@ -246,6 +405,14 @@ void ScanTarget::will_change_owner() {
 }
 
 void ScanTarget::submit() {
+	// If this frame is being held back then don't submit anything yet; if allocation has
+	// failed then there's no prospect of it being identical to the previous, so just stop
+	// holding and throw it away.
+	if(is_holding_frame_) {
+		if(!allocation_has_failed_) return;
+		is_holding_frame_ = false;
+	}
+
 	if(allocation_has_failed_) {
 		// Reset all pointers to where they were; this also means
 		// the stencil won't be properly populated.
@@ -265,6 +432,36 @@ void ScanTarget::announce(Event event, bool is_visible, const Outputs::Display::
 	display_metrics_.announce_event(event);
 
 	if(event == ScanTarget::Event::EndVerticalRetrace) {
+		// Determine whether the frame just ended was a repeat of its predecessor. If so, and if it was
+		// held back, discard it by restoring the state as at the start of the frame.
+		const bool frame_did_repeat = frame_is_complete_ && !allocation_has_failed_ && frame_hash_ == previous_frame_hash_;
+		const bool did_skip_frame = is_holding_frame_ && frame_did_repeat;
+		if(did_skip_frame) {
+			write_pointers_ = held_frame_start_.write_pointers;
+			active_line_ = held_frame_start_.active_line;
+			provided_scans_ = held_frame_start_.provided_scans;
+		}
+		is_holding_frame_ = false;
+		display_metrics_.announce_frame(did_skip_frame);
+
+		repeated_frames_ = frame_did_repeat ? repeated_frames_ + 1 : 0;
+		if(accumulation_is_stale_.exchange(false)) {
+			repeated_frames_ = 0;
+		}
+		previous_frame_hash_ = frame_hash_;
+		frame_hash_ = 0;
+
+		// If the output seems to be static, submit everything up to now and begin holding back.
+		if(repeated_frames_ >= FramesBeforeSkipping) {
+			submit();
+			if(!allocation_has_failed_) {
+				held_frame_start_.write_pointers = write_pointers_;
+				held_frame_start_.active_line = active_line_;
+				held_frame_start_.provided_scans = provided_scans_;
+				is_holding_frame_ = true;
+			}
+		}
+
 		// The previous-frame-is-complete flag is subject to a two-slot queue because
 		// measurement for *this* frame needs to begin now, meaning that the previous
 		// result needs to be put somewhere. Setting frame_is_complete_ back to true
@@ -277,6 +474,11 @@ void ScanTarget::announce(Event event, bool is_visible, const Outputs::Display::
 	}
 
 	if(output_is_visible_ == is_visible) return;
+	frame_hash_ = hashWord(frame_hash_,
+		uint64_t(location.x) |
+		(uint64_t(location.y) << 16) |
+		(uint64_t(uint16_t(location.composite_angle)) << 32) |
+		(uint64_t(composite_amplitude) << 48));
 	if(is_visible) {
 		const auto read_pointers = read_pointers_.load();
 
@@ -349,7 +551,12 @@ void ScanTarget::setup_pipeline() {
 		// TODO: flush output.
 
 		data_type_size_ = data_type_size;
-		write_area_texture_.resize(2048*2048*data_type_size_);
+		if(buffers_are_persistent_) {
+			write_area_texture_ = persistent_write_area_;
+		} else {
+			write_area_storage_.resize(WriteAreaWidth*WriteAreaHeight*data_type_size_);
+			write_area_texture_ = write_area_storage_.data();
+		}
 
 		write_pointers_.scan_buffer = 0;
 		write_pointers_.write_area = 0;
@@ -366,7 +573,7 @@ void ScanTarget::setup_pipeline() {
 			qam_chroma_texture_.reset(new TextureTarget(LineBufferWidth, LineBufferHeight, QAMChromaTextureUnit, GL_NEAREST, false));
 		}
 
-		qam_separation_shader_ = qam_separation_shader();
+		qam_separation_shader_ = qam_separation_shader(modals_);
 		enable_vertex_attributes(ShaderType::QAMSeparation, *qam_separation_shader_);
 		set_uniforms(ShaderType::QAMSeparation, *qam_separation_shader_);
 		qam_separation_shader_->set_uniform("textureName", GLint(UnprocessedLineBufferTextureUnit - GL_TEXTURE0));
@@ -376,7 +583,7 @@ void ScanTarget::setup_pipeline() {
 	}
 
 	// Establish an output shader.
-	output_shader_ = conversion_shader();
+	output_shader_ = conversion_shader(modals_, output_gamma_);
 	enable_vertex_attributes(ShaderType::Conversion, *output_shader_);
 	set_uniforms(ShaderType::Conversion, *output_shader_);
 	output_shader_->set_uniform("origin", modals_.visible_area.origin.x, modals_.visible_area.origin.y);
@@ -385,7 +592,7 @@ void ScanTarget::setup_pipeline() {
 	output_shader_->set_uniform("qamTextureName", GLint(QAMChromaTextureUnit - GL_TEXTURE0));
 
 	// Establish an input shader.
-	input_shader_ = composition_shader();
+	input_shader_ = composition_shader(modals_);
 	test_gl(glBindVertexArray, scan_vertex_array_);
 	test_gl(glBindBuffer, GL_ARRAY_BUFFER, scan_buffer_name_);
 	enable_vertex_attributes(ShaderType::Composition, *input_shader_);
@@ -393,6 +600,22 @@ void ScanTarget::setup_pipeline() {
 	input_shader_->set_uniform("textureName", GLint(SourceDataTextureUnit - GL_TEXTURE0));
 }
 
+void ScanTarget::precompile_shaders() {
+	while(is_updating_.test_and_set());
+	Modals modals = modals_;
+	is_updating_.clear();
+
+	// The composition shader doesn't depend on display type.
+	composition_shader(modals);
+	for(const auto display_type: {DisplayType::RGB, DisplayType::SVideo, DisplayType::CompositeColour, DisplayType::CompositeMonochrome}) {
+		modals.display_type = display_type;
+		conversion_shader(modals, output_gamma_);
+		if(display_type == DisplayType::CompositeColour || display_type == DisplayType::SVideo) {
+			qam_separation_shader(modals);
+		}
+	}
+}
+
 Outputs::Display::Metrics &ScanTarget::display_metrics() {
 	return display_metrics_;
 }
@@ -411,7 +634,13 @@ void ScanTarget::update(int output_width, int output_height) {
 				false);
 			return;
 		}
+		glDeleteSync(fence_);
 		fence_ = nullptr;
+
+		// The GPU is now finished with everything previously submitted.
+		if(buffers_are_persistent_) {
+			read_pointers_.store(pending_read_pointers_);
+		}
 	}
 	display_metrics_.announce_draw_status(
 		lines_submitted_,
@@ -437,11 +666,12 @@ void ScanTarget::update(int output_width, int output_height) {
 	const auto read_pointers = read_pointers_.load();
 
 	// Determine how many lines are about to be submitted.
-	lines_submitted_ = (read_pointers.line + line_buffer_.size() - submit_pointers.line) % line_buffer_.size();
+	lines_submitted_ = (read_pointers.line + LineBufferHeight - submit_pointers.line) % LineBufferHeight;
 
-	// Submit scans; only the new ones need to be communicated.
-	size_t new_scans = (submit_pointers.scan_buffer + scan_buffer_.size() - read_pointers.scan_buffer) % scan_buffer_.size();
-	if(new_scans) {
+	// Submit scans; only the new ones need to be communicated, and then only if they
+	// aren't already in GPU-visible memory.
+	size_t new_scans = (submit_pointers.scan_buffer + ScanBufferSize - read_pointers.scan_buffer) % ScanBufferSize;
+	if(new_scans && !buffers_are_persistent_) {
 		test_gl(glBindBuffer, GL_ARRAY_BUFFER, scan_buffer_name_);
 
 		// Map only the required portion of the buffer.
@@ -454,7 +684,7 @@ void ScanTarget::update(int output_width, int output_height) {
 		if(read_pointers.scan_buffer < submit_pointers.scan_buffer) {
 			memcpy(destination, &scan_buffer_[read_pointers.scan_buffer], new_scans_size);
 		} else {
-			const size_t first_portion_length = (scan_buffer_.size() - read_pointers.scan_buffer) * sizeof(Scan);
+			const size_t first_portion_length = (ScanBufferSize - read_pointers.scan_buffer) * sizeof(Scan);
 			memcpy(destination, &scan_buffer_[read_pointers.scan_buffer], first_portion_length);
 			memcpy(&destination[first_portion_length], &scan_buffer_[0], new_scans_size - first_portion_length);
 		}
@@ -489,6 +719,17 @@ void ScanTarget::update(int output_width, int output_height) {
 			texture_exists_ = true;
 		}
 
+		// If the write area is in a pixel buffer then the upload is a GPU-side copy from
+		// that, with source addresses being offsets into the buffer.
+		if(buffers_are_persistent_) {
+			test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, write_area_buffer_name_);
+		}
+		const auto source = [this] (uint16_t y) -> const GLvoid * {
+			const size_t offset = size_t(TextureAddress(0, y)) * data_type_size_;
+			if(buffers_are_persistent_) return reinterpret_cast<const GLvoid *>(offset);
+			return &write_area_texture_[offset];
+		};
+
 		const auto start_y = TextureAddressGetY(read_pointers.write_area);
 		const auto end_y = TextureAddressGetY(submit_pointers.write_area);
 		if(end_y >= start_y) {
@@ -500,7 +741,7 @@ void ScanTarget::update(int output_width, int output_height) {
 				1 + end_y - start_y,
 				formatForDepth(data_type_size_),
 				GL_UNSIGNED_BYTE,
-				&write_area_texture_[size_t(TextureAddress(0, start_y)) * data_type_size_]);
+				source(start_y));
 		} else {
 			// The circular buffer wrapped around; submit the data from the read pointer to the end of
 			// the buffer and from the start of the buffer to the submit pointer.
@@ -511,7 +752,7 @@ void ScanTarget::update(int output_width, int output_height) {
 				1 + end_y,
 				formatForDepth(data_type_size_),
 				GL_UNSIGNED_BYTE,
-				&write_area_texture_[0]);
+				source(0));
 			test_gl(glTexSubImage2D,
 				GL_TEXTURE_2D, 0,
 				0, start_y,
@@ -519,7 +760,11 @@ void ScanTarget::update(int output_width, int output_height) {
 				WriteAreaHeight - start_y,
 				formatForDepth(data_type_size_),
 				GL_UNSIGNED_BYTE,
-				&write_area_texture_[size_t(TextureAddress(0, start_y)) * data_type_size_]);
+				source(start_y));
+		}
+
+		if(buffers_are_persistent_) {
+			test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, 0);
 		}
 	}
 
@@ -528,7 +773,7 @@ void ScanTarget::update(int output_width, int output_height) {
 		unprocessed_line_texture_.bind_framebuffer();
 
 		// Clear newly-touched lines; that is everything from (read+1) to submit.
-		const uint16_t first_line_to_clear = (read_pointers.line+1)%line_buffer_.size();
+		const uint16_t first_line_to_clear = (read_pointers.line+1)%LineBufferHeight;
 		const uint16_t final_line_to_clear = submit_pointers.line;
 		if(first_line_to_clear != final_line_to_clear) {
 			test_gl(glEnable, GL_SCISSOR_TEST);
@@ -558,7 +803,11 @@ void ScanTarget::update(int output_width, int output_height) {
 		// Apply new spans. They definitely always go to the first buffer.
 		test_gl(glBindVertexArray, scan_vertex_array_);
 		input_shader_->bind();
-		test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(new_scans));
+		if(buffers_are_persistent_) {
+			drawInstancesFrom(read_pointers.scan_buffer, new_scans, ScanBufferSize);
+		} else {
+			test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(new_scans));
+		}
 	}
 
 	// Logic for reducing resolution: start doing so if the metrics object reports that
@@ -613,6 +862,9 @@ void ScanTarget::update(int output_width, int output_height) {
 
 	if(did_setup_pipeline || did_create_accumulation_texture) {
 		set_sampling_window(proportional_width, framebuffer_height, *output_shader_);
+
+		// The accumulation buffer will need to be redrawn in full before frames can be skipped again.
+		accumulation_is_stale_ = true;
 	}
 
 	// Figure out how many new lines are ready.
@@ -638,6 +890,15 @@ void ScanTarget::update(int output_width, int output_height) {
 		// Prepare to upload data that will consitute lines.
 		test_gl(glBindBuffer, GL_ARRAY_BUFFER, line_buffer_name_);
 
+		// Lines are drawn from the start of the buffer if they were uploaded, or else from wherever they are.
+		const auto draw_lines = [this] (uint16_t start_line, size_t lines) {
+			if(buffers_are_persistent_) {
+				drawInstancesFrom(start_line, lines, LineBufferHeight);
+			} else {
+				test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(lines));
+			}
+		};
+
 		// Divide spans by which frame they're in.
 		uint16_t start_line = read_pointers.line;
 		while(new_lines) {
@@ -665,9 +926,11 @@ void ScanTarget::update(int output_width, int output_height) {
 				}
 			}
 
-			// Upload.
+			// Upload, if necessary.
 			const auto buffer_size = lines * sizeof(Line);
-			if(!end_line || end_line > start_line) {
+			if(buffers_are_persistent_) {
+				// Nothing to do; the lines are already in GPU-visible memory.
+			} else if(!end_line || end_line > start_line) {
 				test_gl(glBufferSubData, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), &line_buffer_[start_line]);
 			} else {
 				uint8_t *destination = static_cast<uint8_t *>(
@@ -676,7 +939,7 @@ void ScanTarget::update(int output_width, int output_height) {
 				assert(destination);
 				test_gl_error();
 
-				const size_t buffer_length = line_buffer_.size() * sizeof(Line);
+				const size_t buffer_length = LineBufferHeight * sizeof(Line);
 				const size_t start_position = start_line * sizeof(Line);
 				memcpy(&destination[0], &line_buffer_[start_line], buffer_length - start_position);
 				memcpy(&destination[buffer_length - start_position], &line_buffer_[0], end_line * sizeof(Line));
@@ -694,7 +957,7 @@ void ScanTarget::update(int output_width, int output_height) {
 
 				test_gl(glDisable, GL_BLEND);
 				test_gl(glDisable, GL_STENCIL_TEST);
-				test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(lines));
+				draw_lines(start_line, lines);
 
 				accumulation_texture_->bind_framebuffer();
 				output_shader_->bind();
@@ -703,7 +966,7 @@ void ScanTarget::update(int output_width, int output_height) {
 			}
 
 			// Render to the output.
-			test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(lines));
+			draw_lines(start_line, lines);
 
 			start_line = end_line;
 			new_lines -= lines;
@@ -718,8 +981,13 @@ void ScanTarget::update(int output_width, int output_height) {
 	is_drawing_to_accumulation_buffer_.clear();
 
 	// All data now having been spooled to the GPU, update the read pointers to
-	// the submit pointer location.
-	read_pointers_.store(submit_pointers);
+	// the submit pointer location. If the GPU is reading directly from the
+	// client's buffers then wait until the fence below has been passed.
+	if(buffers_are_persistent_) {
+		pending_read_pointers_ = submit_pointers;
+	} else {
+		read_pointers_.store(submit_pointers);
+	}
 
 	// Grab a fence sync object to avoid busy waiting upon the next extry into this
 	// function, and reset the is_updating_ flag.
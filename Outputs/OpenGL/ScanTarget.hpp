@@ -11,6 +11,7 @@
 
 #include "../Log.hpp"
 #include "../DisplayMetrics.hpp"
+#include "../PixelUnpacker.hpp"
 #include "../ScanTarget.hpp"
 
 #include "OpenGL.hpp"
@@ -52,6 +53,15 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		/*! @returns The DisplayMetrics object that this ScanTarget has been providing with announcements and draw overages. */
 		Metrics &display_metrics();
 
+		/*!
+			Compiles, and then discards, all shaders that would be needed to process the current
+			modals under each possible display type; this primes the shader binary cache, if one
+			has been set, so that later changes of display type don't need to wait for compilation.
+
+			This may be called on any thread that has a current OpenGL context.
+		*/
+		void precompile_shaders();
+
 	private:
 #ifndef NDEBUG
 		struct OpenGLVersionDumper {
@@ -68,6 +78,8 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		static constexpr int LineBufferWidth = 2048;
 		static constexpr int LineBufferHeight = 2048;
 
+		static constexpr int ScanBufferSize = 3072;
+
 		GLuint target_framebuffer_;
 		const float output_gamma_;
 
@@ -123,8 +135,8 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		/// A pointer to the first thing not yet submitted for display.
 		std::atomic<PointerSet> read_pointers_;
 
-		// Maintains a buffer of the most recent 3072 scans.
-		std::array<Scan, 3072> scan_buffer_;
+		// Maintains a buffer of the most recent ScanBufferSize scans.
+		Scan *scan_buffer_ = nullptr;
 
 		// Maintains a list of composite scan buffer coordinates; the Line struct
 		// is transported to the GPU in its entirety; the LineMetadatas live in CPU
@@ -142,9 +154,19 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 			bool is_first_in_frame;
 			bool previous_frame_was_complete;
 		};
-		std::array<Line, LineBufferHeight> line_buffer_;
+		Line *line_buffer_ = nullptr;
 		std::array<LineMetadata, LineBufferHeight> line_metadata_buffer_;
 
+		// If persistently-mapped buffers are available then scan_buffer_, line_buffer_ and
+		// write_area_texture_ point directly into GPU-visible memory, so that no copying is
+		// necessary upon submission. Otherwise they point into the following, and the
+		// relevant portions are copied to the GPU in each update.
+		std::vector<Scan> scan_buffer_storage_;
+		std::vector<Line> line_buffer_storage_;
+		std::vector<uint8_t> write_area_storage_;
+		uint8_t *persistent_write_area_ = nullptr;
+		bool buffers_are_persistent_ = false;
+
 		// Contains the first composition of scans into lines;
 		// they're accumulated prior to output to allow for continuous
 		// application of any necessary conversions — e.g. composite processing.
@@ -167,17 +189,48 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		bool frame_is_complete_ = true;
 		bool previous_frame_was_complete_ = true;
 
+		// Repeated frame detection: a hash is kept of all scan geometry and pixel data for the frame
+		// currently being received. Once enough consecutive frames have been identical that the
+		// accumulation buffer will have fully converged, each subsequent frame is held back from
+		// submission until it ends, then discarded if it proved to be a repeat.
+		static constexpr int FramesBeforeSkipping = 8;
+		uint64_t frame_hash_ = 0;
+		uint64_t previous_frame_hash_ = 0;
+		uint64_t modals_generation_ = 0;
+		int repeated_frames_ = 0;
+		bool is_holding_frame_ = false;
+		struct {
+			PointerSet write_pointers;
+			Line *active_line = nullptr;
+			int provided_scans = 0;
+		} held_frame_start_;
+		void hash_scan(const Outputs::Display::ScanTarget::Scan &scan);
+
+		// Set by update if the accumulation buffer has been recreated or the pipeline has
+		// changed, indicating that frames can't be skipped until it has been redrawn.
+		std::atomic<bool> accumulation_is_stale_;
+
 		// OpenGL storage handles for buffer data.
 		GLuint scan_buffer_name_ = 0, scan_vertex_array_ = 0;
 		GLuint line_buffer_name_ = 0, line_vertex_array_ = 0;
 
-		template <typename T> void allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name);
-		template <typename T> void patch_buffer(const T &array, GLuint target, uint16_t submit_pointer, uint16_t read_pointer);
+		GLuint write_area_buffer_name_ = 0;
+
+		/*!
+			Creates a buffer of @c buffer_size bytes and an associated vertex array. If buffers are
+			persistent then the buffer is mapped and @returns the mapped address; otherwise @returns nullptr.
+		*/
+		void *allocate_buffer(size_t buffer_size, GLenum target, GLuint &buffer_name, GLuint *vertex_array_name);
+		void delete_buffers();
 
 		// Uses a texture to vend write areas.
-		std::vector<uint8_t> write_area_texture_;
+		uint8_t *write_area_texture_ = nullptr;
 		size_t data_type_size_ = 0;
 
+		// If the input data type is packed, write areas are vended by the unpacker
+		// instead, and expanded into write_area_texture_ upon end_data.
+		PixelUnpacker unpacker_;
+
 		GLuint write_area_texture_name_ = 0;
 		bool texture_exists_ = false;
 
@@ -207,9 +260,14 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		*/
 		static void enable_vertex_attributes(ShaderType type, Shader &target);
 		void set_uniforms(ShaderType type, Shader &target) const;
-		std::vector<std::string> bindings(ShaderType type) const;
+		static std::vector<std::string> bindings(ShaderType type);
 
 		GLsync fence_ = nullptr;
+
+		// With persistent buffers the GPU reads directly from the regions most recently submitted,
+		// so they can be returned to the writer only once fence_ has been passed; until
+		// then the pointers that will be released are kept here.
+		PointerSet pending_read_pointers_;
 		std::atomic_flag is_updating_;
 		std::atomic_flag is_drawing_to_accumulation_buffer_;
 
@@ -223,22 +281,22 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 			normalising the data into one of four forms: RGB, 8-bit luminance,
 			phase-linked luminance or luminance+phase offset.
 		*/
-		std::unique_ptr<Shader> composition_shader() const;
+		static std::unique_ptr<Shader> composition_shader(const Modals &modals);
 		/*!
 			Produces a shader that reads from a composition buffer and converts to host
 			output RGB, decoding composite or S-Video as necessary.
 		*/
-		std::unique_ptr<Shader> conversion_shader() const;
+		static std::unique_ptr<Shader> conversion_shader(const Modals &modals, float output_gamma);
 		/*!
 			Produces a shader that writes separated but not-yet filtered QAM components
 			from the unprocessed line texture to the QAM chroma texture, at a fixed
 			size of four samples per colour clock, point sampled.
 		*/
-		std::unique_ptr<Shader> qam_separation_shader() const;
+		static std::unique_ptr<Shader> qam_separation_shader(const Modals &modals);
 
 		void set_sampling_window(int output_Width, int output_height, Shader &target);
 
-		std::string sampling_function() const;
+		static std::string sampling_function(const Modals &modals);
 
 		/*!
 			@returns true if the current display type is a 'soft' one, i.e. one in which
@@ -159,7 +159,7 @@ void ScanTarget::enable_vertex_attributes(ShaderType type, Shader &target) {
 #undef rt_offset_of
 }
 
-std::vector<std::string> ScanTarget::bindings(ShaderType type) const {
+std::vector<std::string> ScanTarget::bindings(ShaderType type) {
 	switch(type) {
 		case ShaderType::Composition: return {
 			"startDataX",
@@ -185,10 +185,10 @@ std::vector<std::string> ScanTarget::bindings(ShaderType type) const {
 
 // MARK: - Shader code.
 
-std::string ScanTarget::sampling_function() const {
+std::string ScanTarget::sampling_function(const Modals &modals) {
 	std::string fragment_shader;
 
-	if(modals_.display_type == DisplayType::SVideo) {
+	if(modals.display_type == DisplayType::SVideo) {
 		fragment_shader +=
 			"vec2 svideo_sample(vec2 coordinate, float angle) {";
 	} else {
@@ -196,10 +196,13 @@ std::string ScanTarget::sampling_function() const {
 			"float composite_sample(vec2 coordinate, float angle) {";
 	}
 
-	const bool is_svideo = modals_.display_type == DisplayType::SVideo;
-	switch(modals_.input_data_type) {
+	const bool is_svideo = modals.display_type == DisplayType::SVideo;
+	switch(modals.input_data_type) {
 		case InputDataType::Luminance1:
 		case InputDataType::Luminance8:
+		case InputDataType::PackedLuminance1:
+		case InputDataType::PackedLuminance2:
+		case InputDataType::PackedLuminance4:
 			// Easy, just copy across.
 			fragment_shader +=
 				is_svideo ?
@@ -234,6 +237,9 @@ std::string ScanTarget::sampling_function() const {
 		case InputDataType::Red2Green2Blue2:
 		case InputDataType::Red4Green4Blue4:
 		case InputDataType::Red8Green8Blue8:
+		case InputDataType::PackedPalette1:
+		case InputDataType::PackedPalette2:
+		case InputDataType::PackedPalette4:
 			fragment_shader +=
 				"vec3 colour = rgbToLumaChroma * textureLod(textureName, coordinate, 0).rgb;"
 				"vec2 quadrature = vec2(cos(angle), sin(angle));";
@@ -250,7 +256,7 @@ std::string ScanTarget::sampling_function() const {
 	return fragment_shader;
 }
 
-std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
+std::unique_ptr<Shader> ScanTarget::conversion_shader(const Modals &modals, float output_gamma) {
 	// Compose a vertex shader. If the display type is RGB, generate just the proper
 	// geometry position, plus a solitary textureCoordinate.
 	//
@@ -297,7 +303,7 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 
 		"out vec4 fragColour;";
 
-	if(modals_.display_type != DisplayType::RGB) {
+	if(modals.display_type != DisplayType::RGB) {
 		vertex_shader +=
 			"out float compositeAngle;"
 			"out float compositeAmplitude;"
@@ -312,7 +318,7 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 			"uniform vec4 compositeAngleOffsets;";
 	}
 
-	if(modals_.display_type == DisplayType::SVideo || modals_.display_type == DisplayType::CompositeColour) {
+	if(modals.display_type == DisplayType::SVideo || modals.display_type == DisplayType::CompositeColour) {
 		vertex_shader += "out vec2 qamTextureCoordinates[4];";
 		fragment_shader += "in vec2 qamTextureCoordinates[4];";
 	}
@@ -328,7 +334,7 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 			"gl_Position = vec4(eyePosition, 0.0, 1.0);";
 
 	// For everything other than RGB, calculate the two composite outputs.
-	if(modals_.display_type != DisplayType::RGB) {
+	if(modals.display_type != DisplayType::RGB) {
 		vertex_shader +=
 			"compositeAngle = (mix(startCompositeAngle, endCompositeAngle, lateral) / 32.0) * 3.141592654;"
 			"compositeAmplitude = lineCompositeAmplitude / 255.0;"
@@ -342,7 +348,7 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 		"textureCoordinates[2] = vec2(centreClock + textureCoordinateOffsets[2], lineY + 0.5) / textureSize(textureName, 0);"
 		"textureCoordinates[3] = vec2(centreClock + textureCoordinateOffsets[3], lineY + 0.5) / textureSize(textureName, 0);";
 
-	if((modals_.display_type == DisplayType::SVideo) || (modals_.display_type == DisplayType::CompositeColour)) {
+	if((modals.display_type == DisplayType::SVideo) || (modals.display_type == DisplayType::CompositeColour)) {
 		vertex_shader +=
 			"float centreCompositeAngle = abs(mix(startCompositeAngle, endCompositeAngle, lateral)) * 4.0 / 64.0;"
 			"centreCompositeAngle = floor(centreCompositeAngle);"
@@ -356,19 +362,19 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 
 	// Compose a fragment shader.
 
-	if(modals_.display_type != DisplayType::RGB) {
+	if(modals.display_type != DisplayType::RGB) {
 		fragment_shader +=
 			"uniform mat3 lumaChromaToRGB;"
 			"uniform mat3 rgbToLumaChroma;";
 
-		fragment_shader += sampling_function();
+		fragment_shader += sampling_function(modals);
 	}
 
 	fragment_shader +=
 		"void main(void) {"
 			"vec3 fragColour3;";
 
-	switch(modals_.display_type) {
+	switch(modals.display_type) {
 		case DisplayType::CompositeColour:
 			fragment_shader +=
 				"vec4 angles = compositeAngle + compositeAngleOffsets;"
@@ -456,13 +462,13 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 	}
 
 	// Apply a brightness adjustment if requested.
-	if(fabs(modals_.brightness - 1.0f) > 0.05f) {
-		fragment_shader += "fragColour3 = fragColour3 * " + std::to_string(modals_.brightness) + ";";
+	if(fabs(modals.brightness - 1.0f) > 0.05f) {
+		fragment_shader += "fragColour3 = fragColour3 * " + std::to_string(modals.brightness) + ";";
 	}
 
 	// Apply a gamma correction if required.
-	if(fabs(output_gamma_ - modals_.intended_gamma) > 0.05f) {
-		const float gamma_ratio = output_gamma_ / modals_.intended_gamma;
+	if(fabs(output_gamma - modals.intended_gamma) > 0.05f) {
+		const float gamma_ratio = output_gamma / modals.intended_gamma;
 		fragment_shader += "fragColour3 = pow(fragColour3, vec3(" + std::to_string(gamma_ratio) + "));";
 	}
 
@@ -477,7 +483,7 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 	));
 }
 
-std::unique_ptr<Shader> ScanTarget::composition_shader() const {
+std::unique_ptr<Shader> ScanTarget::composition_shader(const Modals &modals) {
 	const std::string vertex_shader =
 		"#version 150\n"
 
@@ -512,18 +518,24 @@ std::unique_ptr<Shader> ScanTarget::composition_shader() const {
 
 		"void main(void) {";
 
-	switch(modals_.input_data_type) {
+	switch(modals.input_data_type) {
 		case InputDataType::Luminance1:
 			fragment_shader += "fragColour = textureLod(textureName, textureCoordinate, 0).rrrr;";
 		break;
 
 		case InputDataType::Luminance8:
+		case InputDataType::PackedLuminance1:
+		case InputDataType::PackedLuminance2:
+		case InputDataType::PackedLuminance4:
 			fragment_shader += "fragColour = textureLod(textureName, textureCoordinate, 0).rrrr / vec4(255.0);";
 		break;
 
 		case InputDataType::PhaseLinkedLuminance8:
 		case InputDataType::Luminance8Phase8:
 		case InputDataType::Red8Green8Blue8:
+		case InputDataType::PackedPalette1:
+		case InputDataType::PackedPalette2:
+		case InputDataType::PackedPalette4:
 			fragment_shader += "fragColour = textureLod(textureName, textureCoordinate, 0) / vec4(255.0);";
 		break;
 
@@ -551,8 +563,8 @@ std::unique_ptr<Shader> ScanTarget::composition_shader() const {
 	));
 }
 
-std::unique_ptr<Shader> ScanTarget::qam_separation_shader() const {
-	const bool is_svideo = modals_.display_type == DisplayType::SVideo;
+std::unique_ptr<Shader> ScanTarget::qam_separation_shader(const Modals &modals) {
+	const bool is_svideo = modals.display_type == DisplayType::SVideo;
 
 	// Sets up texture coordinates to run between startClock and endClock, mapping to
 	// coordinates that correlate with four times the absolute value of the composite angle.
@@ -625,10 +637,10 @@ std::unique_ptr<Shader> ScanTarget::qam_separation_shader() const {
 	vertex_shader += "}";
 
 	fragment_shader +=
-		sampling_function() +
+		sampling_function(modals) +
 		"void main(void) {";
 
-	if(modals_.display_type == DisplayType::SVideo) {
+	if(modals.display_type == DisplayType::SVideo) {
 		fragment_shader +=
 			"fragColour = vec4(svideo_sample(textureCoordinate, compositeAngle).rgg * vec3(1.0, cos(compositeAngle), sin(compositeAngle)), 1.0);";
 	} else {
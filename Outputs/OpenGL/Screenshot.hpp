@@ -11,6 +11,9 @@
 
 #include "OpenGL.hpp"
 
+#include <cstring>
+#include <vector>
+
 namespace Outputs {
 namespace Display {
 namespace OpenGL {
@@ -50,6 +53,18 @@ struct Screenshot {
 		}
 	}
 
+	/*!
+		Constructs a screenshot from @c width by @c height pixels of RGBA data, supplied in
+		OpenGL's bottom-to-top order as per a @c glReadPixels.
+	*/
+	Screenshot(const uint8_t *data, int width, int height) : width(width), height(height) {
+		const size_t line_size = size_t(width * 4);
+		pixel_data.resize(line_size * size_t(height));
+		for(size_t y = 0; y < size_t(height); ++y) {
+			memcpy(&pixel_data[y * line_size], &data[(size_t(height - 1) - y) * line_size], line_size);
+		}
+	}
+
 	std::vector<uint8_t> pixel_data;
 	int width, height;
 };
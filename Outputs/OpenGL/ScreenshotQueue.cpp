@@ -0,0 +1,118 @@
+//
+//  ScreenshotQueue.cpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#include "ScreenshotQueue.hpp"
+
+#include <algorithm>
+
+using namespace Outputs::Display::OpenGL;
+
+ScreenshotQueue::ScreenshotQueue() {
+	for(auto &capture: captures_) {
+		capture.is_encoded = false;
+		test_gl(glGenBuffers, 1, &capture.buffer);
+	}
+}
+
+ScreenshotQueue::~ScreenshotQueue() {
+	// Complete any captures that are still in flight; blocking is acceptable at this point.
+	for(auto &capture: captures_) {
+		if(capture.state == Capture::State::Reading) {
+			glClientWaitSync(capture.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+		}
+	}
+	update();
+	encoder_.flush();
+	update();
+
+	for(auto &capture: captures_) {
+		glDeleteBuffers(1, &capture.buffer);
+	}
+}
+
+bool ScreenshotQueue::request(int aspect_width, int aspect_height, Receiver receiver) {
+	const auto capture = std::find_if(captures_.begin(), captures_.end(), [] (const Capture &candidate) {
+		return candidate.state == Capture::State::Free;
+	});
+	if(capture == captures_.end()) return false;
+
+	// Get the current viewport to establish framebuffer size. Then determine how wide the
+	// centre portion of that would be, allowing for the requested aspect ratio.
+	GLint dimensions[4];
+	glGetIntegerv(GL_VIEWPORT, dimensions);
+
+	capture->height = int(dimensions[3]);
+	capture->width = std::min((capture->height * aspect_width) / aspect_height, int(dimensions[2]));
+	capture->receiver = receiver;
+
+	// Resize the pixel buffer if necessary.
+	const size_t buffer_size = size_t(capture->width * capture->height * 4);
+	test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, capture->buffer);
+	if(buffer_size != capture->buffer_size) {
+		test_gl(glBufferData, GL_PIXEL_PACK_BUFFER, GLsizeiptr(buffer_size), nullptr, GL_STREAM_READ);
+		capture->buffer_size = buffer_size;
+	}
+
+	// Queue up a read into the buffer, temporarily setting single-byte alignment, and
+	// get a fence with which to tell when that's complete.
+	GLint prior_alignment;
+	glGetIntegerv(GL_PACK_ALIGNMENT, &prior_alignment);
+	test_gl(glPixelStorei, GL_PACK_ALIGNMENT, 1);
+	test_gl(glReadPixels, (dimensions[2] - GLint(capture->width)) >> 1, 0, GLint(capture->width), GLint(capture->height), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	test_gl(glPixelStorei, GL_PACK_ALIGNMENT, prior_alignment);
+	test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, 0);
+
+	capture->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	capture->state = Capture::State::Reading;
+	return true;
+}
+
+void ScreenshotQueue::update() {
+	for(auto &capture: captures_) {
+		switch(capture.state) {
+			case Capture::State::Free: break;
+
+			case Capture::State::Reading: {
+				// Don't wait for the GPU; if the read isn't complete yet then it'll be caught next time.
+				const auto status = glClientWaitSync(capture.fence, 0, 0);
+				if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+				glDeleteSync(capture.fence);
+				capture.fence = nullptr;
+
+				// Map the buffer and pass it to the encoder, which will signal when it's done
+				// so that the buffer can be unmapped here.
+				test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, capture.buffer);
+				const auto data = static_cast<const uint8_t *>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, GLsizeiptr(capture.buffer_size), GL_MAP_READ_BIT));
+				test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, 0);
+
+				if(!data) {
+					capture.state = Capture::State::Free;
+					break;
+				}
+
+				capture.state = Capture::State::Encoding;
+				Capture *const target = &capture;
+				encoder_.enqueue([target, data] {
+					target->receiver(Screenshot(data, target->width, target->height));
+					target->is_encoded = true;
+				});
+			} break;
+
+			case Capture::State::Encoding:
+				if(!capture.is_encoded) break;
+
+				test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, capture.buffer);
+				test_gl(glUnmapBuffer, GL_PIXEL_PACK_BUFFER);
+				test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, 0);
+
+				capture.receiver = nullptr;
+				capture.is_encoded = false;
+				capture.state = Capture::State::Free;
+			break;
+		}
+	}
+}
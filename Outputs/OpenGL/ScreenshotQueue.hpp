@@ -0,0 +1,84 @@
+//
+//  ScreenshotQueue.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef ScreenshotQueue_hpp
+#define ScreenshotQueue_hpp
+
+#include "OpenGL.hpp"
+#include "Screenshot.hpp"
+
+#include "../../Concurrency/AsyncTaskQueue.hpp"
+
+#include <array>
+#include <atomic>
+#include <functional>
+
+namespace Outputs {
+namespace Display {
+namespace OpenGL {
+
+/*!
+	Captures screenshots without stalling either the GPU or the caller.
+
+	A capture is requested on one frame, at which point a read of the centre portion of the
+	currently-bound framebuffer into a pixel buffer is queued. Once the GPU has completed that
+	read, usually a frame or two later, the pixel buffer is mapped and the result is assembled
+	into a Screenshot and passed to its receiver on a background thread.
+
+	All calls should be made on the thread that owns the OpenGL context in which the queue was created.
+*/
+class ScreenshotQueue {
+	public:
+		using Receiver = std::function<void(const Screenshot &)>;
+
+		ScreenshotQueue();
+		~ScreenshotQueue();
+
+		/*!
+			Begins capture of the currently-bound framebuffer, cropped to the aspect ratio
+			@c aspect_width:aspect_height.
+
+			@param receiver The function that will be called, on a background thread, with the completed Screenshot.
+			@returns @c true if the capture was begun; @c false if there are already too many captures in flight.
+		*/
+		bool request(int aspect_width, int aspect_height, Receiver receiver);
+
+		/*!
+			Checks for completed captures, dispatching any for encoding and recycling
+			the pixel buffers of those that have been encoded. This should be called once a frame.
+		*/
+		void update();
+
+	private:
+		struct Capture {
+			enum class State {
+				Free,
+				Reading,
+				Encoding
+			} state = State::Free;
+
+			GLuint buffer = 0;
+			size_t buffer_size = 0;
+			GLsync fence = nullptr;
+			int width = 0, height = 0;
+			Receiver receiver;
+
+			/// Set by the encoding thread once it no longer needs the mapped buffer.
+			std::atomic<bool> is_encoded;
+		};
+
+		// Three captures allow one to be in flight on the GPU, one to be
+		// with the encoder and one to be newly requested.
+		std::array<Capture, 3> captures_;
+		Concurrency::AsyncTaskQueue encoder_;
+};
+
+}
+}
+}
+
+#endif /* ScreenshotQueue_hpp */
@@ -0,0 +1,59 @@
+//
+//  PixelUnpacker.cpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#include "PixelUnpacker.hpp"
+
+#include <cstring>
+
+using namespace Outputs::Display;
+
+void PixelUnpacker::set_modals(const ScanTarget::Modals &modals, size_t maximum_length) {
+	bits_per_pixel_ = bits_per_packed_pixel(modals.input_data_type);
+	if(!bits_per_pixel_) {
+		packed_area_.clear();
+		expansion_table_.clear();
+		return;
+	}
+
+	const auto unpacked_type = unpacked_data_type(modals.input_data_type);
+	const int pixels_per_byte = 8 / bits_per_pixel_;
+	const int value_mask = (1 << bits_per_pixel_) - 1;
+	unpacked_size_ = size_for_data_type(unpacked_type);
+
+	const size_t entry_size = size_t(pixels_per_byte) * unpacked_size_;
+	expansion_table_.resize(256 * entry_size);
+	for(int byte = 0; byte < 256; ++byte) {
+		uint8_t *const entry = &expansion_table_[size_t(byte) * entry_size];
+		for(int pixel = 0; pixel < pixels_per_byte; ++pixel) {
+			const int value = (byte >> (8 - (pixel + 1) * bits_per_pixel_)) & value_mask;
+			if(unpacked_type == InputDataType::Luminance8) {
+				entry[pixel] = uint8_t((value * 255) / value_mask);
+			} else {
+				memcpy(&entry[size_t(pixel) * unpacked_size_], &modals.input_data_tweaks.palette[value], unpacked_size_);
+			}
+		}
+	}
+
+	packed_area_.resize(maximum_length);
+}
+
+void PixelUnpacker::unpack(uint8_t *target, size_t length) const {
+	const size_t pixels_per_byte = size_t(8 / bits_per_pixel_);
+	const size_t entry_size = pixels_per_byte * unpacked_size_;
+
+	const size_t whole_bytes = length / pixels_per_byte;
+	const uint8_t *source = packed_area_.data();
+	for(size_t c = 0; c < whole_bytes; ++c) {
+		memcpy(target, &expansion_table_[size_t(source[c]) * entry_size], entry_size);
+		target += entry_size;
+	}
+
+	const size_t remainder = (length % pixels_per_byte) * unpacked_size_;
+	if(remainder) {
+		memcpy(target, &expansion_table_[size_t(source[whole_bytes]) * entry_size], remainder);
+	}
+}
@@ -0,0 +1,62 @@
+//
+//  PixelUnpacker.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef PixelUnpacker_hpp
+#define PixelUnpacker_hpp
+
+#include "ScanTarget.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Outputs {
+namespace Display {
+
+/*!
+	Assists a scan target in accepting packed input data types: it vends storage for a single
+	packed write area, and expands that into the corresponding unpacked type, as per
+	@c unpacked_data_type, via a lookup table.
+*/
+class PixelUnpacker {
+	public:
+		/*!
+			Prepares to unpack the input data type described by @c modals, if it is packed, into
+			write areas of up to @c maximum_length pixels.
+		*/
+		void set_modals(const ScanTarget::Modals &modals, size_t maximum_length);
+
+		/// @returns The number of bits per packed pixel, or 0 if the current input data type isn't packed.
+		int bits_per_pixel() const {
+			return bits_per_pixel_;
+		}
+
+		/// @returns The size of each unpacked pixel, in bytes.
+		size_t unpacked_size() const {
+			return unpacked_size_;
+		}
+
+		/// @returns Storage for a packed write area.
+		uint8_t *packed_area() {
+			return packed_area_.data();
+		}
+
+		/// Expands @c length pixels from the packed write area into @c target.
+		void unpack(uint8_t *target, size_t length) const;
+
+	private:
+		int bits_per_pixel_ = 0;
+		size_t unpacked_size_ = 0;
+		std::vector<uint8_t> packed_area_;
+
+		// Each of the table's 256 entries holds the unpacked form of that byte value.
+		std::vector<uint8_t> expansion_table_;
+};
+
+}
+}
+
+#endif /* PixelUnpacker_hpp */
@@ -60,6 +60,10 @@ enum class InputDataType {
 	Luminance1,				// 1 byte/pixel; any bit set => white; no bits set => black.
 	Luminance8,				// 1 byte/pixel; linear scale.
 
+	PackedLuminance1,		// 8 pixels/byte; set => white; clear => black.
+	PackedLuminance2,		// 4 pixels/byte; linear scale.
+	PackedLuminance4,		// 2 pixels/byte; linear scale.
+
 	PhaseLinkedLuminance8,	// 4 bytes/pixel; each byte is an individual 8-bit luminance
 							// value and which value is output is a function of
 							// colour subcarrier phase — byte 0 defines the first quarter
@@ -82,10 +86,62 @@ enum class InputDataType {
 	Red2Green2Blue2,		// 1 byte/pixel; bits 0 and 1 are blue, bits 2 and 3 are green, bits 4 and 5 are blue.
 	Red4Green4Blue4,		// 2 bytes/pixel; first nibble is red, second is green, third is blue.
 	Red8Green8Blue8,		// 4 bytes/pixel; first is red, second is green, third is blue, fourth is vacant.
+
+	// The palette types index Modals::InputDataTweaks::palette and can feed an RGB
+	// pipeline in the same manner as the RGB types.
+
+	PackedPalette1,			// 8 pixels/byte.
+	PackedPalette2,			// 4 pixels/byte.
+	PackedPalette4,			// 2 pixels/byte.
+
+	// All packed types store their leftmost pixel in the most significant bits of
+	// each byte, so that most bitmapped video memory can be copied directly. If the
+	// number of pixels written isn't a multiple of the pixels per byte, the final
+	// byte is only partially used.
 };
 
-inline size_t size_for_data_type(InputDataType data_type) {
+/// @returns The number of bits each pixel occupies if @c data_type is a packed type; 0 otherwise.
+inline int bits_per_packed_pixel(InputDataType data_type) {
+	switch(data_type) {
+		case InputDataType::PackedLuminance1:
+		case InputDataType::PackedPalette1:
+			return 1;
+
+		case InputDataType::PackedLuminance2:
+		case InputDataType::PackedPalette2:
+			return 2;
+
+		case InputDataType::PackedLuminance4:
+		case InputDataType::PackedPalette4:
+			return 4;
+
+		default:
+			return 0;
+	}
+}
+
+/// @returns The type that a scan target will expand @c data_type to if it is a packed type;
+/// @c data_type itself otherwise.
+inline InputDataType unpacked_data_type(InputDataType data_type) {
 	switch(data_type) {
+		case InputDataType::PackedLuminance1:
+		case InputDataType::PackedLuminance2:
+		case InputDataType::PackedLuminance4:
+			return InputDataType::Luminance8;
+
+		case InputDataType::PackedPalette1:
+		case InputDataType::PackedPalette2:
+		case InputDataType::PackedPalette4:
+			return InputDataType::Red8Green8Blue8;
+
+		default:
+			return data_type;
+	}
+}
+
+/// @returns The number of bytes per pixel of @c data_type; for packed types this is the size of the unpacked equivalent.
+inline size_t size_for_data_type(InputDataType data_type) {
+	switch(unpacked_data_type(data_type)) {
 		case InputDataType::Luminance1:
 		case InputDataType::Luminance8:
 		case InputDataType::Red1Green1Blue1:
@@ -110,6 +166,9 @@ inline DisplayType natural_display_type_for_data_type(InputDataType data_type) {
 		default:
 		case InputDataType::Luminance1:
 		case InputDataType::Luminance8:
+		case InputDataType::PackedLuminance1:
+		case InputDataType::PackedLuminance2:
+		case InputDataType::PackedLuminance4:
 		case InputDataType::PhaseLinkedLuminance8:
 			return DisplayType::CompositeColour;
 
@@ -117,6 +176,9 @@ inline DisplayType natural_display_type_for_data_type(InputDataType data_type) {
 		case InputDataType::Red2Green2Blue2:
 		case InputDataType::Red4Green4Blue4:
 		case InputDataType::Red8Green8Blue8:
+		case InputDataType::PackedPalette1:
+		case InputDataType::PackedPalette2:
+		case InputDataType::PackedPalette4:
 			return DisplayType::RGB;
 
 		case InputDataType::Luminance8Phase8:
@@ -151,6 +213,11 @@ struct ScanTarget {
 				/// to add to phase before indexing the supplied luminances.
 				float phase_linked_luminance_offset = 0.0f;
 
+				/// If using one of the PackedPalette data types, supplies the colours that pixel values
+				/// index. Each entry is a single Red8Green8Blue8 pixel, i.e. its bytes are red, green,
+				/// blue and vacant in memory order.
+				uint32_t palette[16] = {};
+
 			} input_data_tweaks;
 
 			/// Describes the type of display that the data is being shown on.
@@ -258,6 +325,9 @@ struct ScanTarget {
 		///
 		/// Calls will be paired off with calls to @c end_data.
 		///
+		/// If the input data type is packed then the storage returned is for the packed form,
+		/// and @c required_length and @c required_alignment remain measured in pixels.
+		///
 		/// @returns a pointer to the allocated space if any was available; @c nullptr otherwise.
 		virtual uint8_t *begin_data(size_t required_length, size_t required_alignment = 1) = 0;
 
@@ -0,0 +1,361 @@
+//
+//  ScanTarget.cpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#include "ScanTarget.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Outputs::Display::SharedMemory;
+
+namespace {
+
+int write_area_sub(int a, int b) {
+	return (a - b) & 0x3fffff;
+}
+
+bool operator ==(const PointerSet &lhs, const PointerSet &rhs) {
+	return lhs.write_area == rhs.write_area && lhs.scan_buffer == rhs.scan_buffer && lhs.line == rhs.line;
+}
+
+}
+
+// MARK: - ScanTarget.
+
+ScanTarget::ScanTarget(const std::string &name) : name_(name) {
+	// Replace any segment left over from a previous producer of the same name.
+	shm_unlink(name.c_str());
+	const int file = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+	if(file < 0) throw Error::CantCreate;
+
+	if(ftruncate(file, sizeof(Segment)) < 0) {
+		close(file);
+		shm_unlink(name.c_str());
+		throw Error::CantCreate;
+	}
+
+	void *const mapping = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+	// The mapping holds its own reference to the segment.
+	close(file);
+
+	if(mapping == MAP_FAILED) {
+		shm_unlink(name.c_str());
+		throw Error::CantCreate;
+	}
+	segment_ = new (mapping) Segment;
+
+	// Pointers are exchanged with a separate process, so no lock can be involved.
+	if(!segment_->submit_pointers.is_lock_free() || !segment_->modals_sequence.is_lock_free()) {
+		munmap(mapping, sizeof(Segment));
+		shm_unlink(name.c_str());
+		throw Error::NotLockFree;
+	}
+
+	// Ensure proper initialisation of the atomics.
+	segment_->modals_sequence.store(0);
+	segment_->read_pointers.store(write_pointers_);
+	segment_->submit_pointers.store(write_pointers_);
+}
+
+ScanTarget::~ScanTarget() {
+	munmap(segment_, sizeof(Segment));
+	shm_unlink(name_.c_str());
+}
+
+const std::string &ScanTarget::name() const {
+	return name_;
+}
+
+void ScanTarget::set_modals(Modals modals) {
+	// Packed data is expanded as it is received, so the consumer sees only the unpacked type.
+	unpacker_.set_modals(modals, WriteAreaWidth);
+	modals.input_data_type = Outputs::Display::unpacked_data_type(modals.input_data_type);
+	data_type_size_ = Outputs::Display::size_for_data_type(modals.input_data_type);
+
+	// Publish the new modals; the sequence number is odd while they're being written.
+	const uint32_t sequence = segment_->modals_sequence.load(std::memory_order_relaxed);
+	segment_->modals_sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	segment_->modals = modals;
+	segment_->modals_sequence.store(sequence + 2, std::memory_order_release);
+
+	// Anything not yet submitted was produced under the old modals, so shouldn't be submitted.
+	allocation_has_failed_ = true;
+}
+
+Outputs::Display::ScanTarget::Scan *ScanTarget::begin_scan() {
+	if(allocation_has_failed_) return nullptr;
+
+	const auto result = &segment_->scans[write_pointers_.scan_buffer];
+	const auto read_pointers = segment_->read_pointers.load();
+
+	// Advance the pointer.
+	const auto next_write_pointer = decltype(write_pointers_.scan_buffer)((write_pointers_.scan_buffer + 1) % ScanBufferSize);
+
+	// Check whether that's too many.
+	if(next_write_pointer == read_pointers.scan_buffer) {
+		allocation_has_failed_ = true;
+		return nullptr;
+	}
+	write_pointers_.scan_buffer = next_write_pointer;
+	++provided_scans_;
+
+	vended_scan_ = result;
+	return &result->scan;
+}
+
+void ScanTarget::end_scan() {
+	if(vended_scan_) {
+		vended_scan_->data_y = write_area_y(vended_write_area_pointer_);
+		vended_scan_->line = write_pointers_.line;
+		vended_scan_->scan.end_points[0].data_offset += write_area_x(vended_write_area_pointer_);
+		vended_scan_->scan.end_points[1].data_offset += write_area_x(vended_write_area_pointer_);
+	}
+	vended_scan_ = nullptr;
+}
+
+uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignment) {
+	if(allocation_has_failed_) return nullptr;
+	if(!data_type_size_) {
+		allocation_has_failed_ = true;
+		return nullptr;
+	}
+
+	// Determine where the proposed write area would start and end.
+	uint16_t output_y = write_area_y(write_pointers_.write_area);
+
+	uint16_t aligned_start_x = write_area_x(write_pointers_.write_area & 0xffff) + 1;
+	aligned_start_x += uint16_t((required_alignment - aligned_start_x%required_alignment)%required_alignment);
+
+	uint16_t end_x = aligned_start_x + uint16_t(1 + required_length);
+
+	if(end_x > WriteAreaWidth) {
+		output_y = (output_y + 1) % WriteAreaHeight;
+		aligned_start_x = uint16_t(required_alignment);
+		end_x = aligned_start_x + uint16_t(1 + required_length);
+	}
+
+	// Check whether that steps over the read pointer.
+	const auto end_address = write_area_address(end_x, output_y);
+	const auto read_pointers = segment_->read_pointers.load();
+
+	const auto end_distance = write_area_sub(end_address, read_pointers.write_area);
+	const auto previous_distance = write_area_sub(write_pointers_.write_area, read_pointers.write_area);
+
+	// If allocating this would somehow make the write pointer back away from the read pointer,
+	// there must not be enough space left.
+	if(end_distance < previous_distance) {
+		allocation_has_failed_ = true;
+		return nullptr;
+	}
+
+	// Everything checks out, note expectation of a future end_data and return the pointer.
+	data_is_allocated_ = true;
+	vended_write_area_pointer_ = write_pointers_.write_area = write_area_address(aligned_start_x, output_y);
+	if(unpacker_.bits_per_pixel()) {
+		return unpacker_.packed_area();
+	}
+	return &segment_->write_area[size_t(write_pointers_.write_area) * data_type_size_];
+}
+
+void ScanTarget::end_data(size_t actual_length) {
+	if(allocation_has_failed_ || !data_is_allocated_) return;
+
+	uint8_t *const write_area = segment_->write_area;
+	if(unpacker_.bits_per_pixel()) {
+		unpacker_.unpack(&write_area[size_t(write_pointers_.write_area) * data_type_size_], actual_length);
+	}
+
+	// Bookend the start of the new data, to safeguard for precision errors in sampling.
+	memcpy(
+		&write_area[size_t(write_pointers_.write_area - 1) * data_type_size_],
+		&write_area[size_t(write_pointers_.write_area) * data_type_size_],
+		data_type_size_);
+
+	// The write area was allocated in the knowledge that there's sufficient
+	// distance left on the current line, so there's no need to worry about carry.
+	write_pointers_.write_area += actual_length + 1;
+
+	// Also bookend the end.
+	memcpy(
+		&write_area[size_t(write_pointers_.write_area - 1) * data_type_size_],
+		&write_area[size_t(write_pointers_.write_area - 2) * data_type_size_],
+		data_type_size_);
+
+	// Record that no further end_data calls are expected.
+	data_is_allocated_ = false;
+}
+
+void ScanTarget::will_change_owner() {
+	allocation_has_failed_ = true;
+	vended_scan_ = nullptr;
+}
+
+void ScanTarget::submit() {
+	if(allocation_has_failed_) {
+		// Reset all pointers to where they were.
+		write_pointers_ = segment_->submit_pointers.load();
+		frame_is_complete_ = false;
+	} else {
+		// Advance submit pointer.
+		segment_->submit_pointers.store(write_pointers_);
+	}
+
+	// Continue defaulting to a failed allocation for as long as there isn't a line available.
+	allocation_has_failed_ = line_allocation_has_failed_;
+}
+
+void ScanTarget::announce(Event event, bool is_visible, const Outputs::Display::ScanTarget::Scan::EndPoint &location, uint8_t composite_amplitude) {
+	if(event == ScanTarget::Event::EndVerticalRetrace) {
+		// As per the OpenGL scan target, the previous-frame-is-complete flag is subject to a two-slot
+		// queue because measurement for *this* frame needs to begin now.
+		is_first_in_frame_ = true;
+		previous_frame_was_complete_ = frame_is_complete_;
+		frame_is_complete_ = true;
+	}
+
+	if(output_is_visible_ == is_visible) return;
+	if(is_visible) {
+		const auto read_pointers = segment_->read_pointers.load();
+
+		// Commit the most recent line only if any scans fell on it.
+		// Otherwise there's no point outputting it, it'll contribute nothing.
+		if(provided_scans_) {
+			// Store metadata if concluding a previous line.
+			if(active_line_) {
+				active_line_->is_first_in_frame = is_first_in_frame_;
+				active_line_->previous_frame_was_complete = previous_frame_was_complete_;
+				is_first_in_frame_ = false;
+			}
+
+			// Attempt to allocate a new line; note allocation failure if necessary.
+			const auto next_line = uint16_t((write_pointers_.line + 1) % LineBufferHeight);
+			if(next_line == read_pointers.line) {
+				line_allocation_has_failed_ = allocation_has_failed_ = true;
+				active_line_ = nullptr;
+			} else {
+				line_allocation_has_failed_ = false;
+				write_pointers_.line = next_line;
+				active_line_ = &segment_->lines[size_t(write_pointers_.line)];
+			}
+			provided_scans_ = 0;
+		} else {
+			// Just check whether a new line is available now, if waiting.
+			if(line_allocation_has_failed_) {
+				const auto next_line = uint16_t((write_pointers_.line + 1) % LineBufferHeight);
+				if(next_line != read_pointers.line) {
+					line_allocation_has_failed_ = false;
+					write_pointers_.line = next_line;
+					active_line_ = &segment_->lines[size_t(write_pointers_.line)];
+				}
+			}
+		}
+
+		if(active_line_) {
+			active_line_->end_points[0].x = location.x;
+			active_line_->end_points[0].y = location.y;
+			active_line_->end_points[0].cycles_since_end_of_horizontal_retrace = location.cycles_since_end_of_horizontal_retrace;
+			active_line_->end_points[0].composite_angle = location.composite_angle;
+			active_line_->line = write_pointers_.line;
+			active_line_->composite_amplitude = composite_amplitude;
+		}
+	} else {
+		if(active_line_) {
+			active_line_->end_points[1].x = location.x;
+			active_line_->end_points[1].y = location.y;
+			active_line_->end_points[1].cycles_since_end_of_horizontal_retrace = location.cycles_since_end_of_horizontal_retrace;
+			active_line_->end_points[1].composite_angle = location.composite_angle;
+		}
+	}
+	output_is_visible_ = is_visible;
+}
+
+// MARK: - Reader.
+
+Reader::Reader(const std::string &name) {
+	const int file = shm_open(name.c_str(), O_RDWR, 0);
+	if(file < 0) throw Error::CantOpen;
+
+	struct stat file_stats;
+	if(fstat(file, &file_stats) < 0) {
+		close(file);
+		throw Error::CantOpen;
+	}
+	if(size_t(file_stats.st_size) != sizeof(Segment)) {
+		close(file);
+		throw Error::IncompatibleVersion;
+	}
+
+	void *const mapping = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	close(file);
+	if(mapping == MAP_FAILED) throw Error::CantOpen;
+
+	segment_ = static_cast<Segment *>(mapping);
+	if(segment_->version != SegmentVersion) {
+		munmap(mapping, sizeof(Segment));
+		throw Error::IncompatibleVersion;
+	}
+}
+
+Reader::~Reader() {
+	munmap(segment_, sizeof(Segment));
+}
+
+bool Reader::read(const std::function<void(const Submission &)> &receiver) {
+	const auto submit_pointers = segment_->submit_pointers.load();
+
+	// Check for new modals, retrying if the producer is partway through changing them. If they have
+	// changed then everything up to now may have been produced under the old, so is discarded.
+	uint32_t sequence = segment_->modals_sequence.load(std::memory_order_acquire);
+	if(sequence != modals_sequence_) {
+		Outputs::Display::ScanTarget::Modals modals;
+		while(true) {
+			if(!(sequence & 1)) {
+				modals = segment_->modals;
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if(segment_->modals_sequence.load(std::memory_order_relaxed) == sequence) break;
+			}
+			sequence = segment_->modals_sequence.load(std::memory_order_acquire);
+		}
+
+		modals_ = modals;
+		modals_sequence_ = sequence;
+		data_type_size_ = Outputs::Display::size_for_data_type(modals_.input_data_type);
+
+		// Reload the submit pointers: those loaded above may predate submissions that were made under
+		// the old modals but published before the new ones.
+		segment_->read_pointers.store(segment_->submit_pointers.load());
+		return false;
+	}
+
+	// Nothing can be interpreted until modals have been supplied.
+	const auto read_pointers = segment_->read_pointers.load();
+	if(!data_type_size_ || read_pointers == submit_pointers) {
+		segment_->read_pointers.store(submit_pointers);
+		return false;
+	}
+
+	receiver({
+		modals_,
+		data_type_size_,
+		read_pointers,
+		submit_pointers,
+		segment_->scans,
+		segment_->lines,
+		segment_->write_area
+	});
+
+	// Release everything just processed to the producer.
+	segment_->read_pointers.store(submit_pointers);
+	return true;
+}
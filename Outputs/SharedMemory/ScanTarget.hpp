@@ -0,0 +1,240 @@
+//
+//  ScanTarget.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef SharedMemory_ScanTarget_hpp
+#define SharedMemory_ScanTarget_hpp
+
+#include "../ScanTarget.hpp"
+#include "../PixelUnpacker.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace Outputs {
+namespace Display {
+namespace SharedMemory {
+
+/*
+	A shared-memory scan target places everything it vends in a POSIX shared-memory segment,
+	so that another process can decode and present the output without any copying.
+
+	As per the OpenGL scan target, the segment contains three ring buffers: scans, lines and
+	a write-area texture. The producer advances a set of submit pointers once each atomic set
+	of data is complete; the consumer processes everything between its read pointers and the
+	submit pointers, then advances its read pointers to release that space to the producer.
+	Each set of pointers fits into 64 bits so that the two processes can exchange them via
+	lock-free atomics.
+*/
+
+constexpr int WriteAreaWidth = 2048;
+constexpr int WriteAreaHeight = 2048;
+constexpr int LineBufferHeight = 2048;
+constexpr int ScanBufferSize = 3072;
+
+/// The maximum size of an unpacked pixel, which dictates the size of the write area.
+constexpr int MaximumDataTypeSize = 4;
+
+/// Identifies the layout below; a consumer will decline to open segments with any other version.
+constexpr uint32_t SegmentVersion = 1;
+
+/// @returns The index within the write area, in pixels, of (@c x, @c y).
+constexpr int write_area_address(int x, int y) {
+	return (y << 11) | x;
+}
+constexpr uint16_t write_area_y(int address) {
+	return uint16_t(address >> 11);
+}
+constexpr uint16_t write_area_x(int address) {
+	return uint16_t(address & 0x7ff);
+}
+
+/// Extends the definition of a Scan to locate its data and line.
+struct Scan {
+	Outputs::Display::ScanTarget::Scan scan;
+
+	/// Stores the y coordinate that this scan's data is at, within the write area. The x coordinates
+	/// are applied to the scan's data offsets.
+	uint16_t data_y;
+	/// Stores the index of the line this scan falls upon.
+	uint16_t line;
+};
+
+/// Describes a single line, i.e. the extent of a period of visible output.
+struct Line {
+	struct EndPoint {
+		uint16_t x, y;
+		uint16_t cycles_since_end_of_horizontal_retrace;
+		int16_t composite_angle;
+	} end_points[2];
+	uint16_t line;
+	uint8_t composite_amplitude;
+
+	bool is_first_in_frame;
+	bool previous_frame_was_complete;
+};
+
+struct PointerSet {
+	// This constructor is here to appease GCC's interpretation of
+	// an ambiguity in the C++ standard; cf. https://stackoverflow.com/questions/17430377
+	PointerSet() noexcept {}
+
+	int write_area = 0;
+	uint16_t scan_buffer = 0;
+	uint16_t line = 0;
+};
+
+/// Describes the entire contents of a shared-memory segment.
+struct Segment {
+	uint32_t version = SegmentVersion;
+
+	/// Modals are guarded by a sequence number, which is odd while they are being modified.
+	std::atomic<uint32_t> modals_sequence;
+	Outputs::Display::ScanTarget::Modals modals;
+
+	/// A pointer to the final thing currently cleared for submission; modified only by the producer.
+	std::atomic<PointerSet> submit_pointers;
+
+	/// A pointer to the first thing not yet processed for display; modified only by the consumer.
+	std::atomic<PointerSet> read_pointers;
+
+	Scan scans[ScanBufferSize];
+	Line lines[LineBufferHeight];
+	uint8_t write_area[WriteAreaWidth * WriteAreaHeight * MaximumDataTypeSize];
+};
+
+/*!
+	Provides a ScanTarget that creates and populates a shared-memory segment, for
+	consumption by a @c Reader in the same or another process.
+*/
+class ScanTarget: public Outputs::Display::ScanTarget {
+	public:
+		enum class Error {
+			/// The shared-memory segment couldn't be created or mapped.
+			CantCreate,
+			/// This platform can't exchange pointers between processes without a lock.
+			NotLockFree
+		};
+
+		/*!
+			Creates the shared-memory segment @c name, which should begin with a slash, replacing any
+			existing segment of that name.
+
+			@throws Error::CantCreate or Error::NotLockFree if the segment can't be created.
+		*/
+		ScanTarget(const std::string &name);
+
+		/// Unmaps and removes the shared-memory segment.
+		~ScanTarget();
+
+		/// @returns The name of the shared-memory segment.
+		const std::string &name() const;
+
+	private:
+		// Outputs::Display::ScanTarget overrides.
+		void set_modals(Modals) override;
+		Outputs::Display::ScanTarget::Scan *begin_scan() override;
+		void end_scan() override;
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) override;
+		void end_data(size_t actual_length) override;
+		void submit() override;
+		void announce(Event event, bool is_visible, const Outputs::Display::ScanTarget::Scan::EndPoint &location, uint8_t composite_amplitude) override;
+		void will_change_owner() override;
+
+		const std::string name_;
+		Segment *segment_ = nullptr;
+
+		/// A pointer to the next thing that should be provided to the caller for data.
+		PointerSet write_pointers_;
+
+		// If the input data type is packed, write areas are vended by the unpacker
+		// instead, and expanded into the write area upon end_data.
+		PixelUnpacker unpacker_;
+		size_t data_type_size_ = 0;
+
+		// Ephemeral state that helps in line composition.
+		Line *active_line_ = nullptr;
+		int provided_scans_ = 0;
+		bool is_first_in_frame_ = true;
+		bool frame_is_complete_ = true;
+		bool previous_frame_was_complete_ = true;
+		bool output_is_visible_ = false;
+
+		// Ephemeral information for the begin/end functions.
+		SharedMemory::Scan *vended_scan_ = nullptr;
+		int vended_write_area_pointer_ = 0;
+
+		// Track allocation failures.
+		bool data_is_allocated_ = false;
+		bool allocation_has_failed_ = false;
+		bool line_allocation_has_failed_ = false;
+};
+
+/*!
+	Maps a shared-memory segment created by a @c ScanTarget, providing direct access
+	to each newly-submitted set of scans, lines and data.
+*/
+class Reader {
+	public:
+		enum class Error {
+			/// The shared-memory segment couldn't be opened or mapped.
+			CantOpen,
+			/// The segment isn't of the layout expected.
+			IncompatibleVersion
+		};
+
+		/*!
+			Maps the existing shared-memory segment @c name.
+
+			@throws Error::CantOpen or Error::IncompatibleVersion if the segment can't be used.
+		*/
+		Reader(const std::string &name);
+		~Reader();
+
+		/*!
+			Describes everything submitted since the previous call to @c read. Scans, lines and write
+			area rows are all ring buffers, so the ranges below may wrap around.
+
+			Newly-touched lines run from the one after @c begin.line to @c end.line inclusive;
+			new scans from @c begin.scan_buffer up to but excluding @c end.scan_buffer; and new
+			rows of the write area from that containing @c begin.write_area to that containing
+			@c end.write_area.
+		*/
+		struct Submission {
+			const Outputs::Display::ScanTarget::Modals &modals;
+			size_t data_type_size;
+
+			PointerSet begin, end;
+
+			const Scan *scans;
+			const Line *lines;
+			const uint8_t *write_area;
+		};
+
+		/*!
+			Calls @c receiver with everything that has been submitted since the previous call, unless nothing has,
+			then releases it to the producer. If the modals have changed then anything submitted beforehand is
+			discarded.
+
+			@returns @c true if @c receiver was called; @c false otherwise.
+		*/
+		bool read(const std::function<void(const Submission &)> &receiver);
+
+	private:
+		Segment *segment_ = nullptr;
+
+		Outputs::Display::ScanTarget::Modals modals_;
+		uint32_t modals_sequence_ = 0;
+		size_t data_type_size_ = 0;
+};
+
+}
+}
+}
+
+#endif /* SharedMemory_ScanTarget_hpp */
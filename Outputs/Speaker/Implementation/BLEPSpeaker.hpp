@@ -0,0 +1,235 @@
+//
+//  BLEPSpeaker.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef BLEPSpeaker_hpp
+#define BLEPSpeaker_hpp
+
+#include "../Speaker.hpp"
+#include "TransitionSource.hpp"
+#include "../../../ClockReceiver/ClockReceiver.hpp"
+#include "../../../Concurrency/AsyncTaskQueue.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+namespace Outputs {
+namespace Speaker {
+
+/*!
+	The band-limited step speaker expects an Outputs::Speaker::TransitionSource-derived
+	template class, and uses the instance supplied to its constructor as a source of level
+	changes. Each change is rendered directly at the output rate as a band-limited step, so
+	no work is done per input cycle and no filtering is applied at the input rate.
+
+	Its interface otherwise matches that of LowpassSpeaker, so the two are interchangeable
+	for any source that implements get_transitions.
+*/
+template <typename T> class BLEPSpeaker: public Speaker, private TransitionSource::Receiver {
+	public:
+		BLEPSpeaker(T &transition_source) : transition_source_(transition_source), accumulator_(AccumulatorLength + Taps + 1) {
+			transition_source.set_sample_volume_range(32767);
+		}
+
+		// Implemented as per Speaker. The cost of this speaker is dominated by the number of
+		// transitions rather than by the output rate, so the best available quality is preferred.
+		float get_ideal_clock_rate_in_range(float minimum, float maximum) {
+			return maximum;
+		}
+
+		// Implemented as per Speaker.
+		void set_output_rate(float cycles_per_second, int buffer_size) {
+			std::lock_guard<std::mutex> lock_guard(filter_parameters_mutex_);
+			filter_parameters_.output_cycles_per_second = cycles_per_second;
+			filter_parameters_.parameters_are_dirty = true;
+			output_buffer_.resize(std::size_t(buffer_size));
+		}
+
+		/*!
+			Sets the clock rate of the input audio.
+		*/
+		void set_input_rate(float cycles_per_second) {
+			std::lock_guard<std::mutex> lock_guard(filter_parameters_mutex_);
+			filter_parameters_.input_cycles_per_second = cycles_per_second;
+			filter_parameters_.parameters_are_dirty = true;
+			filter_parameters_.input_rate_changed = true;
+		}
+
+		/*!
+			Allows a cut-off frequency to be specified for audio, as per LowpassSpeaker;
+			this is applied by the shape of the steps rather than by a separate filter.
+		*/
+		void set_high_frequency_cutoff(float high_frequency) {
+			std::lock_guard<std::mutex> lock_guard(filter_parameters_mutex_);
+			filter_parameters_.high_frequency_cutoff = high_frequency;
+			filter_parameters_.parameters_are_dirty = true;
+		}
+
+		/*!
+			Schedules an advancement by the number of cycles specified on the provided queue.
+			The speaker will advance by obtaining transitions from the source supplied at construction,
+			rendering them and passing the result on to the speaker's delegate if there is one.
+		*/
+		void run_for(Concurrency::DeferringAsyncTaskQueue &queue, const Cycles cycles) {
+			queue.defer([this, cycles] {
+				run_for(cycles);
+			});
+		}
+
+	private:
+		// Each step is spread over Taps output samples, and is positioned to an accuracy
+		// of 1/Phases of an output sample. Kernels are fixed point, summing to 1 << KernelBits,
+		// so that the integral of each step is exact.
+		static const int Taps = 32;
+		static const int Phases = 64;
+		static const int KernelBits = 15;
+
+		// The number of output samples that may be accumulated before being passed to the output buffer.
+		static const int AccumulatorLength = 512;
+
+		void run_for(const Cycles cycles) {
+			if(!delegate_) return;
+
+			std::size_t cycles_remaining = size_t(cycles.as_int());
+			if(!cycles_remaining) return;
+
+			FilterParameters filter_parameters;
+			{
+				std::lock_guard<std::mutex> lock_guard(filter_parameters_mutex_);
+				filter_parameters = filter_parameters_;
+				filter_parameters_.parameters_are_dirty = false;
+				filter_parameters_.input_rate_changed = false;
+			}
+			if(filter_parameters.parameters_are_dirty) update_kernels(filter_parameters);
+			if(filter_parameters.input_rate_changed) {
+				delegate_->speaker_did_change_input_clock(this);
+			}
+			if(output_buffer_.empty() || samples_per_cycle_ <= 0.0) return;
+
+			while(cycles_remaining) {
+				// Run the source for as long as the accumulator has room for, then
+				// pass on whatever samples can no longer be affected by future steps.
+				const double room = double(AccumulatorLength) - time_;
+				const std::size_t cycles_to_run = std::max(std::size_t(1), std::min(cycles_remaining, std::size_t(room / samples_per_cycle_)));
+
+				run_start_ = time_;
+				transition_source_.get_transitions(cycles_to_run, *this);
+				time_ += double(cycles_to_run) * samples_per_cycle_;
+				cycles_remaining -= cycles_to_run;
+
+				output_complete_samples();
+			}
+		}
+
+		void set_level(std::size_t offset, std::int16_t level) override {
+			if(level == level_) return;
+
+			const double time = run_start_ + double(offset) * samples_per_cycle_;
+			const std::size_t index = std::size_t(time);
+			const int phase = std::min(int((time - double(index)) * Phases), Phases - 1);
+			const int64_t delta = int64_t(level) - int64_t(level_);
+			level_ = level;
+
+			const int32_t *const kernel = &kernels_[size_t(phase * Taps)];
+			int64_t *const target = &accumulator_[index];
+			for(int c = 0; c < Taps; ++c) {
+				target[c] += delta * kernel[c];
+			}
+		}
+
+		void output_complete_samples() {
+			// No step can now begin before time_, so all samples before it are final.
+			const std::size_t complete_samples = std::size_t(time_);
+			if(!complete_samples) return;
+
+			for(std::size_t c = 0; c < complete_samples; ++c) {
+				integral_ += accumulator_[c];
+				const int64_t sample = (integral_ + (1 << (KernelBits - 1))) >> KernelBits;
+				output_buffer_[output_buffer_pointer_] = int16_t(std::max(int64_t(-32768), std::min(int64_t(32767), sample)));
+				++output_buffer_pointer_;
+
+				if(output_buffer_pointer_ == output_buffer_.size()) {
+					output_buffer_pointer_ = 0;
+					delegate_->speaker_did_complete_samples(this, output_buffer_);
+				}
+			}
+
+			// Move the tails of any steps in progress to the front of the accumulator.
+			std::copy(accumulator_.begin() + std::ptrdiff_t(complete_samples), accumulator_.begin() + std::ptrdiff_t(complete_samples + Taps + 1), accumulator_.begin());
+			std::fill(accumulator_.begin() + Taps + 1, accumulator_.begin() + std::ptrdiff_t(complete_samples + Taps + 1), 0);
+			time_ -= double(complete_samples);
+		}
+
+		T &transition_source_;
+
+		double samples_per_cycle_ = 0.0;
+		double time_ = 0.0, run_start_ = 0.0;
+		int16_t level_ = 0;
+		int64_t integral_ = 0;
+
+		std::vector<int32_t> kernels_;
+		std::vector<int64_t> accumulator_;
+
+		std::size_t output_buffer_pointer_ = 0;
+		std::vector<int16_t> output_buffer_;
+
+		std::mutex filter_parameters_mutex_;
+		struct FilterParameters {
+			float input_cycles_per_second = 0.0f;
+			float output_cycles_per_second = 0.0f;
+			float high_frequency_cutoff = -1.0;
+
+			bool parameters_are_dirty = true;
+			bool input_rate_changed = false;
+		} filter_parameters_;
+
+		void update_kernels(const FilterParameters &filter_parameters) {
+			output_buffer_pointer_ = 0;
+			samples_per_cycle_ = (filter_parameters.input_cycles_per_second > 0.0f) ?
+				double(filter_parameters.output_cycles_per_second) / double(filter_parameters.input_cycles_per_second) : 0.0;
+
+			// Leave a little room below the Nyquist frequency for the kernel to roll off in.
+			float high_pass_frequency = filter_parameters.output_cycles_per_second * 0.45f;
+			if(filter_parameters.high_frequency_cutoff > 0.0) {
+				high_pass_frequency = std::min(filter_parameters.high_frequency_cutoff, high_pass_frequency);
+			}
+			const double cutoff = (filter_parameters.output_cycles_per_second > 0.0f) ?
+				double(high_pass_frequency) / double(filter_parameters.output_cycles_per_second) : 0.5;
+
+			// Build a Blackman-windowed sinc for each phase, centred Taps/2 samples after the start of the
+			// step so that no part of it precedes the step; normalise each to sum exactly to 1 << KernelBits.
+			const double pi = 3.141592653589793;
+			kernels_.resize(size_t(Taps * Phases));
+			for(int phase = 0; phase < Phases; ++phase) {
+				double kernel[Taps];
+				double sum = 0.0;
+				for(int tap = 0; tap < Taps; ++tap) {
+					const double position = double(tap) - double(phase) / double(Phases);
+					const double x = position - double(Taps / 2);
+					const double sinc = (x == 0.0) ? 1.0 : sin(2.0 * pi * cutoff * x) / (2.0 * pi * cutoff * x);
+					const double window_position = std::max(0.0, position / double(Taps));
+					const double window = 0.42 - 0.5 * cos(2.0 * pi * window_position) + 0.08 * cos(4.0 * pi * window_position);
+					kernel[tap] = sinc * window;
+					sum += kernel[tap];
+				}
+
+				int32_t *const target = &kernels_[size_t(phase * Taps)];
+				int32_t total = 0;
+				for(int tap = 0; tap < Taps; ++tap) {
+					target[tap] = int32_t(round(kernel[tap] * double(1 << KernelBits) / sum));
+					total += target[tap];
+				}
+				target[Taps / 2] += (1 << KernelBits) - total;
+			}
+		}
+};
+
+}
+}
+
+#endif /* BLEPSpeaker_hpp */
@@ -11,8 +11,17 @@
 
 #include "SampleSource.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstring>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace Outputs {
 namespace Speaker {
@@ -33,13 +42,24 @@ template <typename... T> class CompoundSource:
 		}
 
 		void get_samples(std::size_t number_of_samples, std::int16_t *target) {
-			source_holder_.get_samples(number_of_samples, target);
+			// Mix in chunks no larger than the scratch buffer; the first audible source writes directly
+			// to the target, all others go via the scratch buffer and are added in.
+			while(number_of_samples) {
+				const std::size_t chunk_size = std::min(number_of_samples, scratch_buffer_.size());
+				source_holder_.get_samples(chunk_size, target, scratch_buffer_.data(), true);
+				target += chunk_size;
+				number_of_samples -= chunk_size;
+			}
 		}
 
 		void skip_samples(const std::size_t number_of_samples) {
 			source_holder_.skip_samples(number_of_samples);
 		}
 
+		bool is_zero_level() {
+			return source_holder_.is_zero_level();
+		}
+
 		void set_sample_volume_range(int16_t range) {
 			volume_range_ = range;
 			push_volumes();
@@ -62,14 +82,47 @@ template <typename... T> class CompoundSource:
 			source_holder_.set_scaled_volume_range(volume_range_, volumes_.data());
 		}
 
+		/*!
+			Adds @c source to @c target, saturating at the limits of the int16_t range.
+		*/
+		static void accumulate(std::int16_t *target, const std::int16_t *source, std::size_t number_of_samples) {
+#if defined(__SSE2__)
+			while(number_of_samples >= 8) {
+				const __m128i sum = _mm_adds_epi16(
+					_mm_loadu_si128(reinterpret_cast<const __m128i *>(target)),
+					_mm_loadu_si128(reinterpret_cast<const __m128i *>(source)));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(target), sum);
+				target += 8;
+				source += 8;
+				number_of_samples -= 8;
+			}
+#elif defined(__ARM_NEON)
+			while(number_of_samples >= 8) {
+				vst1q_s16(target, vqaddq_s16(vld1q_s16(target), vld1q_s16(source)));
+				target += 8;
+				source += 8;
+				number_of_samples -= 8;
+			}
+#endif
+			while(number_of_samples--) {
+				*target = static_cast<std::int16_t>(std::min(std::max(*target + *source, -32768), 32767));
+				++target;
+				++source;
+			}
+		}
+
 		template <typename... S> class CompoundSourceHolder: public Outputs::Speaker::SampleSource {
 			public:
-				void get_samples(std::size_t number_of_samples, std::int16_t *target) {
-					std::memset(target, 0, sizeof(std::int16_t) * number_of_samples);
+				void get_samples(std::size_t number_of_samples, std::int16_t *target, std::int16_t *, bool target_is_empty) {
+					if(target_is_empty) std::memset(target, 0, sizeof(std::int16_t) * number_of_samples);
 				}
 
 				void set_scaled_volume_range(int16_t range, float *volumes) {}
 
+				bool is_zero_level() {
+					return true;
+				}
+
 				std::size_t size() {
 					return 0;
 				}
@@ -79,18 +132,22 @@ template <typename... T> class CompoundSource:
 			public:
 				CompoundSourceHolder(S &source, R &...next) : source_(source), next_source_(next...) {}
 
-				void get_samples(std::size_t number_of_samples, std::int16_t *target) {
+				/*!
+					Adds this source's output to @c target, or writes it directly if @c target_is_empty,
+					using @c scratch_buffer as intermediate storage if required; then does likewise for
+					all subsequent sources.
+				*/
+				void get_samples(std::size_t number_of_samples, std::int16_t *target, std::int16_t *scratch_buffer, bool target_is_empty) {
 					if(source_.is_zero_level()) {
 						source_.skip_samples(number_of_samples);
-						next_source_.get_samples(number_of_samples, target);
-					} else {
-						int16_t next_samples[number_of_samples];
-						next_source_.get_samples(number_of_samples, next_samples);
+					} else if(target_is_empty) {
 						source_.get_samples(number_of_samples, target);
-						while(number_of_samples--) {
-							target[number_of_samples] += next_samples[number_of_samples];
-						}
+						target_is_empty = false;
+					} else {
+						source_.get_samples(number_of_samples, scratch_buffer);
+						accumulate(target, scratch_buffer, number_of_samples);
 					}
+					next_source_.get_samples(number_of_samples, target, scratch_buffer, target_is_empty);
 				}
 
 				void skip_samples(const std::size_t number_of_samples) {
@@ -98,6 +155,10 @@ template <typename... T> class CompoundSource:
 					next_source_.skip_samples(number_of_samples);
 				}
 
+				bool is_zero_level() {
+					return source_.is_zero_level() && next_source_.is_zero_level();
+				}
+
 				void set_scaled_volume_range(int16_t range, float *volumes) {
 					source_.set_sample_volume_range(static_cast<int16_t>(static_cast<float>(range * volumes[0])));
 					next_source_.set_scaled_volume_range(range, &volumes[1]);
@@ -113,6 +174,7 @@ template <typename... T> class CompoundSource:
 		};
 
 		CompoundSourceHolder<T...> source_holder_;
+		std::array<std::int16_t, 2048> scratch_buffer_;
 		std::vector<float> volumes_;
 		int16_t volume_range_ = 0;
 };
@@ -15,6 +15,7 @@
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 #include "../../../Concurrency/AsyncTaskQueue.hpp"
 
+#include <algorithm>
 #include <mutex>
 #include <cstring>
 #include <cmath>
@@ -128,7 +129,7 @@ template <typename T> class LowpassSpeaker: public Speaker {
 				while(cycles_remaining) {
 					const auto cycles_to_read = std::min(output_buffer_.size() - output_buffer_pointer_, cycles_remaining);
 
-					sample_source_.get_samples(cycles_to_read, &output_buffer_[output_buffer_pointer_]);
+					get_samples(cycles_to_read, &output_buffer_[output_buffer_pointer_]);
 					output_buffer_pointer_ += cycles_to_read;
 
 					// announce to delegate if full
@@ -148,12 +149,14 @@ template <typename T> class LowpassSpeaker: public Speaker {
 				(filter_parameters.input_cycles_per_second == filter_parameters.output_cycles_per_second && filter_parameters.high_frequency_cutoff >= 0.0)) {
 				while(cycles_remaining) {
 					const auto cycles_to_read = std::min(cycles_remaining, input_buffer_.size() - input_buffer_depth_);
-					sample_source_.get_samples(cycles_to_read, &input_buffer_[input_buffer_depth_]);
+					get_samples(cycles_to_read, &input_buffer_[input_buffer_depth_]);
 					cycles_remaining -= cycles_to_read;
 					input_buffer_depth_ += cycles_to_read;
 
 					if(input_buffer_depth_ == input_buffer_.size()) {
-						output_buffer_[output_buffer_pointer_] = filter_->apply(input_buffer_.data());
+						// A filter window entirely of silence produces silence, so there's no need to apply the filter.
+						output_buffer_[output_buffer_pointer_] =
+							(trailing_zeroes_ >= input_buffer_depth_) ? 0 : filter_->apply(input_buffer_.data());
 						output_buffer_pointer_++;
 
 						// Announce to delegate if full.
@@ -177,6 +180,7 @@ template <typename T> class LowpassSpeaker: public Speaker {
 								sample_source_.skip_samples(steps - input_buffer_.size());
 							input_buffer_depth_ = 0;
 						}
+						trailing_zeroes_ = std::min(trailing_zeroes_, input_buffer_depth_);
 					}
 				}
 
@@ -186,10 +190,26 @@ template <typename T> class LowpassSpeaker: public Speaker {
 			// TODO: input rate is less than output rate
 		}
 
+		/*!
+			Obtains @c number_of_samples from the sample source, or merely advances it and
+			writes silence if it is trivially at the zero level.
+		*/
+		void get_samples(std::size_t number_of_samples, int16_t *target) {
+			if(sample_source_.is_zero_level()) {
+				sample_source_.skip_samples(number_of_samples);
+				std::fill(target, target + number_of_samples, 0);
+				trailing_zeroes_ += number_of_samples;
+			} else {
+				sample_source_.get_samples(number_of_samples, target);
+				trailing_zeroes_ = 0;
+			}
+		}
+
 		T &sample_source_;
 
 		std::size_t output_buffer_pointer_ = 0;
 		std::size_t input_buffer_depth_ = 0;
+		std::size_t trailing_zeroes_ = 0;
 		std::vector<int16_t> input_buffer_;
 		std::vector<int16_t> output_buffer_;
 
@@ -0,0 +1,48 @@
+//
+//  TransitionSource.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef TransitionSource_hpp
+#define TransitionSource_hpp
+
+#include "SampleSource.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Outputs {
+namespace Speaker {
+
+/*!
+	A transition source is a sample source whose output holds at a constant level between
+	discrete changes. In addition to supplying individual samples it can report just those
+	changes, allowing a BLEPSpeaker to do work in proportion to the number of changes rather
+	than the number of input cycles.
+
+	This optional base class provides the interface expected by BLEPSpeaker.
+*/
+class TransitionSource: public SampleSource {
+	public:
+		struct Receiver {
+			/*!
+				Indicates that output is at @c level from @c offset cycles into the current call to
+				get_transitions onwards. Offsets are supplied in ascending order; it is valid to
+				supply the same level more than once.
+			*/
+			virtual void set_level(std::size_t offset, std::int16_t level) = 0;
+		};
+
+		/*!
+			Should advance by @c number_of_cycles, reporting all changes in output level to @c receiver.
+			The level in effect at the start of the call should also be reported, at offset 0.
+		*/
+		void get_transitions(std::size_t number_of_cycles, Receiver &receiver) {}
+};
+
+}
+}
+
+#endif /* TransitionSource_hpp */
@@ -9,6 +9,7 @@
 #ifndef MOS6502_cpp
 #define MOS6502_cpp
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <cstdint>
@@ -85,6 +86,21 @@ enum BusOperation {
 */
 extern const uint8_t JamOpcode;
 
+/*!
+	Describes an idle loop, as offered to a bus handler via perform_idle_loop.
+*/
+struct IdleLoop {
+	/// The addresses of the first and last instructions in the loop.
+	uint16_t start, end;
+	/// The lowest and highest addresses read or written by the loop other than its own instructions; if the
+	/// loop performs no such accesses then @c lowest_data_address will be greater than @c highest_data_address.
+	uint16_t lowest_data_address, highest_data_address;
+	/// The length of a single iteration of the loop.
+	Cycles iteration_length;
+	/// The maximum number of iterations the bus handler may advance across.
+	int maximum_iterations;
+};
+
 /*!
 	A class providing empty implementations of the methods a 6502 uses to access the bus. To wire the 6502 to a bus,
 	machines should subclass BusHandler and then declare a realisation of the 6502 template, suplying their bus
@@ -112,6 +128,22 @@ class BusHandler {
 			return Cycles(1);
 		}
 
+		/*!
+			Announces that the 6502 is in an idle loop, and offers the bus handler the opportunity to advance
+			across some number of its iterations at once. Called only if idle loop detection has been enabled,
+			see ProcessorBase::set_idle_loop_detection, and while no interrupt is pending or signalled.
+
+			The loop has just completed an iteration that exactly repeated its predecessor. So, unless an interrupt
+			is signalled or some value read by the loop changes, it will continue to repeat indefinitely.
+
+			@returns The number of cycles that the bus handler advanced, which should be a whole number of
+			iterations and no more than @c loop.maximum_iterations of them. The default of Cycles(0) declines,
+			causing the loop to be executed as usual.
+		*/
+		Cycles perform_idle_loop(const IdleLoop &loop) {
+			return Cycles(0);
+		}
+
 		/*!
 			Announces completion of all the cycles supplied to a .run_for request on the 6502. Intended to allow
 			bus handlers to perform any deferred output work.
@@ -196,6 +228,13 @@ class ProcessorBase: public ProcessorStorage {
 			@returns @c true if the 6502 is jammed; @c false otherwise.
 		*/
 		bool is_jammed();
+
+		/*!
+			Enables or disables recognition of idle loops: loops of no more than @c maximum_length bytes
+			that are proven to repeat exactly. When one is found it is offered to the bus handler via
+			perform_idle_loop. A @c maximum_length of 0 disables recognition, which is the default.
+		*/
+		void set_idle_loop_detection(uint16_t maximum_length);
 };
 
 /*!
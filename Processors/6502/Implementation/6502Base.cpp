@@ -42,3 +42,8 @@ void ProcessorBase::set_value_of_register(Register r, uint16_t value) {
 bool ProcessorBase::is_jammed() {
 	return is_jammed_;
 }
+
+void ProcessorBase::set_idle_loop_detection(uint16_t maximum_length) {
+	idle_loop_.maximum_length = maximum_length;
+	idle_loop_.is_tracking = false;
+}
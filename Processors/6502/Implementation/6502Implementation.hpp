@@ -54,6 +54,7 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 #define bus_access() \
 	interrupt_requests_ = (interrupt_requests_ & ~InterruptRequestFlags::IRQ) | irq_request_history_;	\
 	irq_request_history_ = irq_line_ & inverse_interrupt_flag_;	\
+	if(idle_loop_.is_tracking) track_idle_loop_access(nextBusOperation, busAddress, busValue);	\
 	number_of_cycles -= bus_handler_.perform_bus_operation(nextBusOperation, busAddress, busValue);	\
 	nextBusOperation = BusOperation::None;	\
 	if(number_of_cycles <= Cycles(0)) break;
@@ -61,6 +62,9 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 	checkSchedule();
 	Cycles number_of_cycles = cycles + cycles_left_to_run_;
 
+	// Iteration lengths are measured relative to number_of_cycles, so can't be tracked across calls.
+	idle_loop_.is_tracking = false;
+
 	while(number_of_cycles > Cycles(0)) {
 
 		// Deal with a potential RDY state, if this 6502 has anything connected to ready.
@@ -109,6 +113,43 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 // MARK: - Fetch/Decode
 
 					case CycleFetchOperation: {
+						if(idle_loop_.maximum_length) {
+							// A short backward jump or branch either starts tracking a potential idle loop or, if it
+							// is the one already being tracked, completes an iteration of it.
+							if(pc_.full < last_operation_pc_.full && last_operation_pc_.full - pc_.full < idle_loop_.maximum_length) {
+								if(idle_loop_.is_tracking && idle_loop_.start == pc_.full && idle_loop_.end == last_operation_pc_.full) {
+									// Don't offer the loop if an interrupt is pending or unmasked on the IRQ line, as it'll be
+									// interrupted momentarily; and always leave at least one cycle for the fetch that follows,
+									// so that no time is run beyond that requested.
+									if(
+										!interrupt_requests_ && !(irq_line_ & inverse_interrupt_flag_) &&
+										idle_loop_did_repeat() && idle_loop_.cycles_at_iteration_start > number_of_cycles
+									) {
+										IdleLoop loop;
+										loop.start = idle_loop_.start;
+										loop.end = idle_loop_.end;
+										loop.lowest_data_address = idle_loop_.lowest_data_address;
+										loop.highest_data_address = idle_loop_.highest_data_address;
+										loop.iteration_length = idle_loop_.cycles_at_iteration_start - number_of_cycles;
+										loop.maximum_iterations = ((number_of_cycles - Cycles(1)) / loop.iteration_length).as_int();
+										if(loop.maximum_iterations > 0) {
+											number_of_cycles -= bus_handler_.perform_idle_loop(loop);
+										}
+									}
+								} else {
+									idle_loop_.is_tracking = true;
+									idle_loop_.start = pc_.full;
+									idle_loop_.end = last_operation_pc_.full;
+									idle_loop_.write_count = 0;
+									idle_loop_.lowest_data_address = 0xffff;
+									idle_loop_.highest_data_address = 0x0000;
+								}
+								begin_idle_loop_iteration(number_of_cycles);
+							} else if(idle_loop_.is_tracking && (pc_.full < idle_loop_.start || pc_.full > idle_loop_.end)) {
+								idle_loop_.is_tracking = false;
+							}
+						}
+
 						last_operation_pc_ = pc_;
 						pc_.full++;
 						read_op(operation_, last_operation_pc_.full);
@@ -780,6 +821,63 @@ inline const ProcessorStorage::MicroOp *ProcessorStorage::get_nmi_program() {
 	return reset;
 }
 
+void ProcessorStorage::track_idle_loop_access(BusOperation operation, uint16_t address, const uint8_t *value) {
+	// Accesses to the loop's own instructions don't count, allowing up to three bytes for the final one.
+	if(address >= idle_loop_.start && address <= idle_loop_.end + 2) return;
+
+	switch(operation) {
+		default: return;
+
+		case BusOperation::Write:
+			if(idle_loop_.write_count == IdleLoopState::MaximumWrites) {
+				// Too many writes to track; this isn't an idle loop.
+				idle_loop_.is_tracking = false;
+				return;
+			}
+			idle_loop_.writes[idle_loop_.write_count].address = address;
+			idle_loop_.writes[idle_loop_.write_count].value = *value;
+			++idle_loop_.write_count;
+		break;
+
+		case BusOperation::Read:
+		case BusOperation::ReadOpcode:
+		break;
+	}
+
+	idle_loop_.lowest_data_address = std::min(idle_loop_.lowest_data_address, address);
+	idle_loop_.highest_data_address = std::max(idle_loop_.highest_data_address, address);
+}
+
+void ProcessorStorage::begin_idle_loop_iteration(Cycles cycles_remaining) {
+	idle_loop_.cycles_at_iteration_start = cycles_remaining;
+
+	idle_loop_.registers[0] = a_;
+	idle_loop_.registers[1] = x_;
+	idle_loop_.registers[2] = y_;
+	idle_loop_.registers[3] = s_;
+	idle_loop_.registers[4] = get_flags();
+
+	std::copy(idle_loop_.writes, idle_loop_.writes + idle_loop_.write_count, idle_loop_.previous_writes);
+	idle_loop_.previous_write_count = idle_loop_.write_count;
+	idle_loop_.write_count = 0;
+}
+
+bool ProcessorStorage::idle_loop_did_repeat() {
+	// All registers must be as they were at the start of the iteration.
+	if(	idle_loop_.registers[0] != a_ || idle_loop_.registers[1] != x_ || idle_loop_.registers[2] != y_ ||
+		idle_loop_.registers[3] != s_ || idle_loop_.registers[4] != get_flags()) return false;
+
+	// Memory must also be as it was at the start of the iteration, which is definitely true if
+	// nothing was written, or if exactly the same writes were made by the iteration before.
+	if(!idle_loop_.write_count) return true;
+	if(idle_loop_.write_count != idle_loop_.previous_write_count) return false;
+	for(int c = 0; c < idle_loop_.write_count; ++c) {
+		if(	idle_loop_.writes[c].address != idle_loop_.previous_writes[c].address ||
+			idle_loop_.writes[c].value != idle_loop_.previous_writes[c].value) return false;
+	}
+	return true;
+}
+
 uint8_t ProcessorStorage::get_flags() {
 	return carry_flag_ | overflow_flag_ | (inverse_interrupt_flag_ ^ Flag::Interrupt) | (negative_result_ & 0x80) | (zero_result_ ? 0 : Flag::Zero) | Flag::Always | decimal_flag_;
 }
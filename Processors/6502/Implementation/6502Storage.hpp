@@ -261,6 +261,35 @@ class ProcessorStorage {
 		uint8_t irq_line_ = 0, irq_request_history_ = 0;
 		bool nmi_line_is_enabled_ = false, set_overflow_line_is_enabled_ = false;
 
+		/*
+			State for the recognition of idle loops; see ProcessorBase::set_idle_loop_detection.
+
+			A loop is tracked from the first backward jump or branch of no more than maximum_length bytes,
+			and is considered idle once an iteration leaves all registers unchanged and either performs no
+			writes or performs exactly the same writes as the iteration before it.
+		*/
+		struct IdleLoopState {
+			uint16_t maximum_length = 0;
+			bool is_tracking = false;
+			uint16_t start = 0, end = 0;
+
+			Cycles cycles_at_iteration_start;
+			uint8_t registers[5];
+			uint16_t lowest_data_address = 0xffff, highest_data_address = 0x0000;
+
+			struct Write {
+				uint16_t address;
+				uint8_t value;
+			};
+			static const int MaximumWrites = 4;
+			Write writes[MaximumWrites], previous_writes[MaximumWrites];
+			int write_count = 0, previous_write_count = 0;
+		} idle_loop_;
+
+		inline void track_idle_loop_access(BusOperation operation, uint16_t address, const uint8_t *value);
+		inline void begin_idle_loop_iteration(Cycles cycles_remaining);
+		inline bool idle_loop_did_repeat();
+
 		/*!
 			Gets the program representing an RST response.
 
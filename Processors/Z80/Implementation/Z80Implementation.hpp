@@ -87,6 +87,17 @@ template <	class T,
 				break;
 				case MicroOp::MoveToNextProgram:
 					advance_operation();
+
+					// If halted with nothing pending, offer the bus handler the chance to perform
+					// as many of the repeating NOP fetches as fit in one go.
+					if(!halt_mask_ && !request_status_ && !(uses_wait_line && wait_line_) && !(uses_bus_request && bus_request_line_)) {
+						int fetches = number_of_cycles_.as_int() >> 3;
+						if(fetches > 0) {
+							number_of_cycles_ -= bus_handler_.perform_halted_fetches(fetches, number_of_cycles_);
+							number_of_cycles_ -= HalfCycles(fetches * 8);
+							ir_.halves.low = static_cast<uint8_t>((ir_.halves.low & 0x80) | ((ir_.halves.low + fetches) & 0x7f));
+						}
+					}
 				break;
 				case MicroOp::DecodeOperation:
 					refresh_addr_ = ir_;
@@ -149,6 +149,26 @@ class BusHandler {
 			return HalfCycles(0);
 		}
 
+		/*!
+			Offers the bus handler the opportunity to perform up to @c count of the opcode fetches that a halted Z80
+			repeats, in bulk. Each such fetch is a ReadOpcodeStart, ReadOpcode and Refresh, totalling HalfCycles(8),
+			none of which would otherwise be announced via perform_machine_cycle.
+
+			This is offered only while the Z80 is halted with no interrupt pending and neither the wait nor bus request
+			lines active; it is the bus handler's responsibility not to perform any fetch during which it would change
+			any of those things.
+
+			@param count On entry, the maximum number of fetches that may be performed; on exit, the number performed.
+			@param time_available The time remaining in the current run; the fetches performed, plus any additional
+			time returned, should total no more than this.
+			@returns The number of additional HalfCycles that passed in objective time while those fetches were ongoing,
+			as per perform_machine_cycle.
+		*/
+		HalfCycles perform_halted_fetches(int &count, HalfCycles time_available) {
+			count = 0;
+			return HalfCycles(0);
+		}
+
 		/*!
 			Announces completion of all the cycles supplied to a .run_for request on the Z80. Intended to allow
 			bus handlers to perform any deferred output work.
@@ -75,6 +75,16 @@ void Controller::digital_phase_locked_loop_output_bit(int value) {
 	if(is_reading_) process_input_bit(value);
 }
 
+void Controller::digital_phase_locked_loop_output_bits(uint64_t bits, int count) {
+	if(is_reading_) process_input_bits(bits, count);
+}
+
+void Controller::process_input_bits(uint64_t bits, int count) {
+	while(count-- && is_reading_) {
+		process_input_bit(int((bits >> count) & 1));
+	}
+}
+
 void Controller::set_drive(std::shared_ptr<Drive> drive) {
 	if(drive_ != drive) {
 		ClockingHint::Preference former_prefernece = preferred_clocking();
@@ -59,6 +59,14 @@ class Controller:
 		*/
 		virtual void process_input_bit(int value) = 0;
 
+		/*!
+			Communicates @c count bits that the PLL recognised together, in the least significant @c count bits
+			of @c bits with the oldest in the most significant position. The default implementation passes
+			each to @c process_input_bit for as long as the controller remains in read mode; subclasses
+			that can process several bits at once may override it.
+		*/
+		virtual void process_input_bits(uint64_t bits, int count);
+
 		/*!
 			Should be implemented by subclasses; communicates that the index hole has been reached.
 		*/
@@ -125,6 +133,7 @@ class Controller:
 
 		// to satisfy DigitalPhaseLockedLoop::Delegate
 		void digital_phase_locked_loop_output_bit(int value) override;
+		void digital_phase_locked_loop_output_bits(uint64_t bits, int count) override;
 };
 
 }
@@ -49,13 +49,25 @@ MFMController::Token MFMController::get_latest_token() {
 }
 
 CRC::CCITT &MFMController::get_crc_generator() {
-	return crc_generator_;
+	return shifter_.get_crc_generator();
 }
 
 void MFMController::process_input_bit(int value) {
 	if(data_mode_ == DataMode::Writing) return;
 
 	shifter_.add_input_bit(value);
+	post_token();
+}
+
+void MFMController::process_input_bits(uint64_t bits, int count) {
+	// Posting a token may end reading, or begin writing, in which case the remaining bits go unseen.
+	while(count && is_reading() && data_mode_ != DataMode::Writing) {
+		count -= shifter_.add_input_bits(bits, count);
+		post_token();
+	}
+}
+
+void MFMController::post_token() {
 	switch(shifter_.get_token()) {
 		case Encodings::MFM::Shifter::Token::None:
 		return;
@@ -96,7 +108,7 @@ void MFMController::write_bit(int bit) {
 
 void MFMController::write_byte(uint8_t byte) {
 	for(int c = 0; c < 8; c++) write_bit((byte << c)&0x80);
-	crc_generator_.add(byte);
+	get_crc_generator().add(byte);
 }
 
 void MFMController::write_raw_short(uint16_t value) {
@@ -148,9 +148,13 @@ class MFMController: public Controller {
 	private:
 		// Storage::Disk::Controller
 		virtual void process_input_bit(int value);
+		void process_input_bits(uint64_t bits, int count) override;
 		virtual void process_index_hole();
 		virtual void process_write_completed();
 
+		// Posts the shifter's most recent token, if it has one.
+		void post_token();
+
 		// Reading state.
 		Token latest_token_;
 		Encodings::MFM::Shifter shifter_;
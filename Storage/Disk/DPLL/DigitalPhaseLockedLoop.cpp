@@ -13,21 +13,38 @@
 using namespace Storage;
 
 DigitalPhaseLockedLoop::DigitalPhaseLockedLoop(int clocks_per_bit, std::size_t length_of_history) :
-		offset_history_(length_of_history, 0),
+		offset_history_(length_of_history),
 		window_length_(clocks_per_bit),
 		clocks_per_bit_(clocks_per_bit) {}
 
 void DigitalPhaseLockedLoop::run_for(const Cycles cycles) {
-	offset_ += cycles.as_int();
-	phase_ += cycles.as_int();
+	advance(cycles.as_int());
+	flush_bits();
+}
+
+void DigitalPhaseLockedLoop::add_pulse() {
+	pulse();
+	flush_bits();
+}
+
+void DigitalPhaseLockedLoop::add_pulses(const int *intervals, std::size_t count) {
+	for(std::size_t c = 0; c < count; ++c) {
+		advance(intervals[c]);
+		pulse();
+	}
+	flush_bits();
+}
+
+void DigitalPhaseLockedLoop::advance(int cycles) {
+	offset_ += cycles;
+	phase_ += cycles;
 	if(phase_ >= window_length_) {
 		int windows_crossed = phase_ / window_length_;
 
 		// check whether this triggers any 0s, if anybody cares
 		if(delegate_) {
 			if(window_was_filled_) windows_crossed--;
-			for(int c = 0; c < windows_crossed; c++)
-				delegate_->digital_phase_locked_loop_output_bit(0);
+			push_zeros(windows_crossed);
 		}
 
 		window_was_filled_ = false;
@@ -35,31 +52,57 @@ void DigitalPhaseLockedLoop::run_for(const Cycles cycles) {
 	}
 }
 
-void DigitalPhaseLockedLoop::add_pulse() {
+void DigitalPhaseLockedLoop::pulse() {
 	if(!window_was_filled_) {
-		if(delegate_) delegate_->digital_phase_locked_loop_output_bit(1);
+		if(delegate_) push_one();
 		window_was_filled_ = true;
 		post_phase_offset(phase_, offset_);
 		offset_ = 0;
 	}
 }
 
+void DigitalPhaseLockedLoop::push_zeros(int count) {
+	while(count) {
+		const int run = std::min(count, 64 - output_bit_count_);
+		if(output_bit_count_) output_bits_ <<= run;
+		output_bit_count_ += run;
+		count -= run;
+		if(output_bit_count_ == 64) flush_bits();
+	}
+}
+
+void DigitalPhaseLockedLoop::push_one() {
+	output_bits_ = (output_bits_ << 1) | 1;
+	++output_bit_count_;
+	if(output_bit_count_ == 64) flush_bits();
+}
+
+void DigitalPhaseLockedLoop::flush_bits() {
+	if(output_bit_count_ && delegate_) {
+		if(output_bit_count_ == 1) {
+			delegate_->digital_phase_locked_loop_output_bit(int(output_bits_));
+		} else {
+			delegate_->digital_phase_locked_loop_output_bits(output_bits_, output_bit_count_);
+		}
+	}
+	output_bits_ = 0;
+	output_bit_count_ = 0;
+}
+
 void DigitalPhaseLockedLoop::post_phase_offset(int new_phase, int new_offset) {
-	offset_history_[offset_history_pointer_] = new_offset;
+	// use an unweighted average of the stored offsets to compute current window size,
+	// bucketing them by rounding to the nearest multiple of the base clocks per bit;
+	// totals are maintained incrementally as offsets enter and leave the history
+	const int multiple = (new_offset + (clocks_per_bit_ >> 1)) / clocks_per_bit_;
+	OffsetRecord &record = offset_history_[offset_history_pointer_];
+	total_spacing_ += (multiple ? new_offset : 0) - (record.multiple ? record.offset : 0);
+	total_divisor_ += multiple - record.multiple;
+	record.offset = new_offset;
+	record.multiple = multiple;
 	offset_history_pointer_ = (offset_history_pointer_ + 1) % offset_history_.size();
 
-	// use an unweighted average of the stored offsets to compute current window size,
-	// bucketing them by rounding to the nearest multiple of the base clocks per bit
-	int total_spacing = 0;
-	int total_divisor = 0;
-	for(int offset : offset_history_) {
-		int multiple = (offset + (clocks_per_bit_ >> 1)) / clocks_per_bit_;
-		if(!multiple) continue;
-		total_divisor += multiple;
-		total_spacing += offset;
-	}
-	if(total_divisor) {
-		window_length_ = total_spacing / total_divisor;
+	if(total_divisor_) {
+		window_length_ = total_spacing_ / total_divisor_;
 	}
 
 	int error = new_phase - (window_length_ >> 1);
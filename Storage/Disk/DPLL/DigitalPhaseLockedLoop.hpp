@@ -9,6 +9,7 @@
 #ifndef DigitalPhaseLockedLoop_hpp
 #define DigitalPhaseLockedLoop_hpp
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -38,12 +39,32 @@ class DigitalPhaseLockedLoop {
 		*/
 		void add_pulse();
 
+		/*!
+			Runs the loop through a sequence of pulses; equivalent to calling run_for with each of the
+			@c count @c intervals in turn, followed each time by add_pulse, but supplying output to the
+			delegate in batches of up to 64 bits.
+		*/
+		void add_pulses(const int *intervals, std::size_t count);
+
 		/*!
 			A receiver for PCM output data; called upon every recognised bit.
 		*/
 		class Delegate {
 			public:
 				virtual void digital_phase_locked_loop_output_bit(int value) = 0;
+
+				/*!
+					Receives @c count recognised bits at once, in the least significant @c count bits of @c bits,
+					with the oldest in the most significant position. Bits are batched only within a single
+					call to the loop, so all arrive at the time that they would have individually.
+
+					The default implementation passes each to @c digital_phase_locked_loop_output_bit.
+				*/
+				virtual void digital_phase_locked_loop_output_bits(uint64_t bits, int count) {
+					while(count--) {
+						digital_phase_locked_loop_output_bit(int((bits >> count) & 1));
+					}
+				}
 		};
 		void set_delegate(Delegate *delegate) {
 			delegate_ = delegate;
@@ -54,8 +75,24 @@ class DigitalPhaseLockedLoop {
 
 		void post_phase_offset(int phase, int offset);
 
-		std::vector<int> offset_history_;
+		void advance(int cycles);
+		void pulse();
+
+		// Output is collected here until the end of each call into the loop, or until 64 bits are pending.
+		uint64_t output_bits_ = 0;
+		int output_bit_count_ = 0;
+		void push_zeros(int count);
+		void push_one();
+		void flush_bits();
+
+		struct OffsetRecord {
+			int offset = 0;
+			int multiple = 0;
+		};
+		std::vector<OffsetRecord> offset_history_;
 		std::size_t offset_history_pointer_ = 0;
+		int total_spacing_ = 0;
+		int total_divisor_ = 0;
 		int offset_ = 0;
 
 		int phase_ = 0;
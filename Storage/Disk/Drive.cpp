@@ -22,6 +22,7 @@ Drive::Drive(int input_clock_rate, int revolutions_per_minute, int number_of_hea
 	Storage::TimedEventLoop(input_clock_rate),
 	rotational_multiplier_(60.0f / float(revolutions_per_minute)),
 	available_heads_(number_of_heads) {
+	set_rotation_speed(float(revolutions_per_minute));
 
 	const auto seed = static_cast<std::default_random_engine::result_type>(std::chrono::system_clock::now().time_since_epoch().count());
 	std::default_random_engine randomiser(seed);
@@ -9,6 +9,8 @@
 #include "SegmentParser.hpp"
 #include "Shifter.hpp"
 
+#include <algorithm>
+
 using namespace Storage::Encodings::MFM;
 
 std::map<std::size_t, Storage::Encodings::MFM::Sector> Storage::Encodings::MFM::sectors_from_segment(const Storage::Disk::PCMSegment &&segment, bool is_double_density) {
@@ -23,61 +25,72 @@ std::map<std::size_t, Storage::Encodings::MFM::Sector> Storage::Encodings::MFM::
 	std::size_t size = 0;
 	std::size_t start_location = 0;
 
+	const std::size_t length = segment.data.size();
 	std::size_t bit_cursor = 0;
-	for(const auto bit: segment.data) {
-		shifter.add_input_bit(bit ? 1 : 0);
-		++bit_cursor;
+	while(bit_cursor < length) {
+		// Supply bits to the shifter up to 64 at a time; it'll stop after each token.
+		int count = static_cast<int>(std::min(length - bit_cursor, std::size_t(64)));
+		uint64_t bits = 0;
+		for(int c = 0; c < count; ++c) {
+			bits = (bits << 1) | (segment.data[bit_cursor + std::size_t(c)] ? 1 : 0);
+		}
 
-		switch(shifter.get_token()) {
-			case Shifter::Token::None:
-			case Shifter::Token::Sync:
-			case Shifter::Token::Index:
-			break;
+		while(count) {
+			const int consumed = shifter.add_input_bits(bits, count);
+			count -= consumed;
+			bit_cursor += std::size_t(consumed);
 
-			case Shifter::Token::ID:
-				new_sector.reset(new Storage::Encodings::MFM::Sector);
-				is_reading = true;
-				start_location = bit_cursor;
-				position = 0;
-				shifter.set_should_obey_syncs(false);
-			break;
+			switch(shifter.get_token()) {
+				case Shifter::Token::None:
+				case Shifter::Token::Sync:
+				case Shifter::Token::Index:
+				break;
 
-			case Shifter::Token::Data:
-			case Shifter::Token::DeletedData:
-				if(new_sector) {
+				case Shifter::Token::ID:
+					new_sector.reset(new Storage::Encodings::MFM::Sector);
 					is_reading = true;
+					start_location = bit_cursor;
+					position = 0;
 					shifter.set_should_obey_syncs(false);
-					new_sector->is_deleted = (shifter.get_token() == Shifter::Token::DeletedData);
-				}
-			break;
+				break;
+
+				case Shifter::Token::Data:
+				case Shifter::Token::DeletedData:
+					if(new_sector) {
+						is_reading = true;
+						shifter.set_should_obey_syncs(false);
+						new_sector->is_deleted = (shifter.get_token() == Shifter::Token::DeletedData);
+					}
+				break;
 
-			case Shifter::Token::Byte:
-				if(is_reading) {
-					switch(position) {
-						case 0:	new_sector->address.track = shifter.get_byte(); ++position; break;
-						case 1:	new_sector->address.side = shifter.get_byte(); ++position; break;
-						case 2:	new_sector->address.sector = shifter.get_byte(); ++position; break;
-						case 3:
-							new_sector->size = shifter.get_byte();
-							size = static_cast<std::size_t>(128 << (new_sector->size&7));
-							++position;
-							is_reading = false;
-							shifter.set_should_obey_syncs(true);
-						break;
-						default:
-							if(new_sector->samples.empty()) new_sector->samples.emplace_back();
-							new_sector->samples[0].push_back(shifter.get_byte());
-							++position;
-							if(position == size + 4) {
-								result.insert(std::make_pair(start_location, std::move(*new_sector)));
+				case Shifter::Token::Byte:
+					if(is_reading) {
+						switch(position) {
+							case 0:	new_sector->address.track = shifter.get_byte(); ++position; break;
+							case 1:	new_sector->address.side = shifter.get_byte(); ++position; break;
+							case 2:	new_sector->address.sector = shifter.get_byte(); ++position; break;
+							case 3:
+								new_sector->size = shifter.get_byte();
+								size = static_cast<std::size_t>(128 << (new_sector->size&7));
+								++position;
 								is_reading = false;
 								shifter.set_should_obey_syncs(true);
-								new_sector.reset();
-							}
-						break;
+							break;
+							default:
+								if(new_sector->samples.empty()) new_sector->samples.emplace_back();
+								new_sector->samples[0].push_back(shifter.get_byte());
+								++position;
+								if(position == size + 4) {
+									result.insert(std::make_pair(start_location, std::move(*new_sector)));
+									is_reading = false;
+									shifter.set_should_obey_syncs(true);
+									new_sector.reset();
+								}
+							break;
+						}
 					}
-				}
-			break;
+				break;
+			}
 		}
 	}
 
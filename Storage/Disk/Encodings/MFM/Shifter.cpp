@@ -9,6 +9,8 @@
 #include "Shifter.hpp"
 #include "Constants.hpp"
 
+#include <algorithm>
+
 using namespace Storage::Encodings::MFM;
 
 Shifter::Shifter() : owned_crc_generator_(new CRC::CCITT()), crc_generator_(owned_crc_generator_.get()) {}
@@ -24,60 +26,68 @@ void Shifter::set_should_obey_syncs(bool should_obey_syncs) {
 }
 
 void Shifter::add_input_bit(int value) {
-	shift_register_ = (shift_register_ << 1) | static_cast<unsigned int>(value);
-	bits_since_token_++;
+	add_input_bits(uint64_t(value), 1);
+}
+
+Shifter::Token Shifter::mark_for_window(unsigned int window) const {
+	if(!is_double_density_) {
+		switch(window) {
+			case Storage::Encodings::MFM::FMIndexAddressMark:		return Token::Index;
+			case Storage::Encodings::MFM::FMIDAddressMark:			return Token::ID;
+			case Storage::Encodings::MFM::FMDataAddressMark:		return Token::Data;
+			case Storage::Encodings::MFM::FMDeletedDataAddressMark:	return Token::DeletedData;
+			default:												return Token::None;
+		}
+	} else {
+		switch(window) {
+			case Storage::Encodings::MFM::MFMIndexSync:
+			case Storage::Encodings::MFM::MFMSync:					return Token::Sync;
+			default:												return Token::None;
+		}
+	}
+}
 
+int Shifter::add_input_bits(uint64_t bits, int count) {
 	token_ = Token::None;
+	if(!count) return 0;
+
+	// Nothing other than a mark can be found before the next byte is complete, so take in bits up to that point
+	// at once, stopping early only if obeying syncs and a mark is found.
+	const int run = std::min(count, 16 - bits_since_token_);
+	const unsigned int input = static_cast<unsigned int>(bits >> (count - run)) & ((1u << run) - 1);
+	int consumed = run;
 	if(should_obey_syncs_) {
-		if(!is_double_density_) {
-			switch(shift_register_ & 0xffff) {
-				case Storage::Encodings::MFM::FMIndexAddressMark:
-					token_ = Token::Index;
-					crc_generator_->reset();
-					crc_generator_->add(Storage::Encodings::MFM::IndexAddressByte);
-				break;
-				case Storage::Encodings::MFM::FMIDAddressMark:
-					token_ = Token::ID;
-					crc_generator_->reset();
-					crc_generator_->add(Storage::Encodings::MFM::IDAddressByte);
-				break;
-				case Storage::Encodings::MFM::FMDataAddressMark:
-					token_ = Token::Data;
-					crc_generator_->reset();
-					crc_generator_->add(Storage::Encodings::MFM::DataAddressByte);
-				break;
-				case Storage::Encodings::MFM::FMDeletedDataAddressMark:
-					token_ = Token::DeletedData;
-					crc_generator_->reset();
-					crc_generator_->add(Storage::Encodings::MFM::DeletedDataAddressByte);
-				break;
-				default:
+		for(int c = 1; c <= run; ++c) {
+			token_ = mark_for_window(((shift_register_ << c) | (input >> (run - c))) & 0xffff);
+			if(token_ != Token::None) {
+				consumed = c;
 				break;
 			}
-		} else {
-			switch(shift_register_ & 0xffff) {
-				case Storage::Encodings::MFM::MFMIndexSync:
-					bits_since_token_ = 0;
-					is_awaiting_marker_value_ = true;
+		}
+	}
 
-					token_ = Token::Sync;
-				break;
-				case Storage::Encodings::MFM::MFMSync:
-					bits_since_token_ = 0;
-					is_awaiting_marker_value_ = true;
-					crc_generator_->set_value(Storage::Encodings::MFM::MFMPostSyncCRCValue);
+	shift_register_ = (shift_register_ << consumed) | (input >> (run - consumed));
+	bits_since_token_ += consumed;
 
-					token_ = Token::Sync;
-				break;
-				default:
-				break;
+	switch(token_) {
+		case Token::None: break;
+
+		case Token::Sync:
+			is_awaiting_marker_value_ = true;
+			if((shift_register_ & 0xffff) == Storage::Encodings::MFM::MFMSync) {
+				// Anything pending is superseded.
+				pending_crc_byte_count_ = 0;
+				crc_generator_->set_value(Storage::Encodings::MFM::MFMPostSyncCRCValue);
 			}
-		}
+			bits_since_token_ = 0;
+		return consumed;
 
-		if(token_ != Token::None) {
+		default:
+			pending_crc_byte_count_ = 0;
+			crc_generator_->reset();
+			add_to_crc(get_byte());
 			bits_since_token_ = 0;
-			return;
-		}
+		return consumed;
 	}
 
 	if(bits_since_token_ == 16) {
@@ -103,18 +113,17 @@ void Shifter::add_input_bit(int value) {
 			}
 		}
 
-		crc_generator_->add(get_byte());
+		add_to_crc(get_byte());
 	}
+
+	return consumed;
 }
 
 uint8_t Shifter::get_byte() const {
-	return static_cast<uint8_t>(
-		((shift_register_ & 0x0001) >> 0) |
-		((shift_register_ & 0x0004) >> 1) |
-		((shift_register_ & 0x0010) >> 2) |
-		((shift_register_ & 0x0040) >> 3) |
-		((shift_register_ & 0x0100) >> 4) |
-		((shift_register_ & 0x0400) >> 5) |
-		((shift_register_ & 0x1000) >> 6) |
-		((shift_register_ & 0x4000) >> 7));
+	// Data bits are the even-numbered bits of the shift register; gather them together.
+	unsigned int byte = shift_register_ & 0x5555;
+	byte = (byte | (byte >> 1)) & 0x3333;
+	byte = (byte | (byte >> 2)) & 0x0f0f;
+	byte = (byte | (byte >> 4)) & 0x00ff;
+	return static_cast<uint8_t>(byte);
 }
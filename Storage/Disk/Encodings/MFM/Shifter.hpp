@@ -9,6 +9,7 @@
 #ifndef Shifter_hpp
 #define Shifter_hpp
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include "../../../../NumberTheory/CRC.hpp"
@@ -27,7 +28,8 @@ namespace MFM {
 	It will ordinarily honour sync patterns; that should be turned off when within
 	a sector because false syncs can occur. See @c set_should_obey_syncs.
 
-	Bits should be fed in with @c add_input_bit.
+	Bits should be fed in with @c add_input_bit or, more efficiently, several at a time with
+	@c add_input_bits.
 
 	The current output token can be read with @c get_token. It will usually be None but
 	may indicate that an index, ID, data or deleted data mark was found, that an
@@ -40,6 +42,8 @@ namespace MFM {
 	then check that the generator has a value of zero.
 
 	A specific instance of the CRC generator can be supplied at construction if preferred.
+	Decoded bytes are added to the generator eight at a time, or as soon as @c get_crc_generator
+	is called, so the generator should be accessed only via @c get_crc_generator.
 */
 class Shifter {
 	public:
@@ -50,6 +54,15 @@ class Shifter {
 		void set_should_obey_syncs(bool should_obey_syncs);
 		void add_input_bit(int bit);
 
+		/*!
+			Adds up to @c count bits, taken from the least significant @c count bits of @c bits with the oldest
+			in the most significant position, stopping early if a token is found.
+
+			@returns the number of bits consumed; if that is fewer than @c count then the remaining
+				bits can be supplied by calling again with the same @c bits and a reduced @c count.
+		*/
+		int add_input_bits(uint64_t bits, int count);
+
 		enum Token {
 			Index, ID, Data, DeletedData, Sync, Byte, None
 		};
@@ -58,6 +71,7 @@ class Shifter {
 			return token_;
 		}
 		CRC::CCITT &get_crc_generator() {
+			flush_crc();
 			return *crc_generator_;
 		}
 
@@ -72,8 +86,25 @@ class Shifter {
 		// input configuration
 		bool is_double_density_ = false;
 
+		Token mark_for_window(unsigned int window) const;
+
 		std::unique_ptr<CRC::CCITT> owned_crc_generator_;
 		CRC::CCITT *crc_generator_;
+
+		// Bytes yet to be added to the CRC generator; they're supplied in groups of eight
+		// so that it can use its slice-by-8 path.
+		uint8_t pending_crc_bytes_[8];
+		std::size_t pending_crc_byte_count_ = 0;
+
+		void add_to_crc(uint8_t byte) {
+			pending_crc_bytes_[pending_crc_byte_count_] = byte;
+			++pending_crc_byte_count_;
+			if(pending_crc_byte_count_ == sizeof(pending_crc_bytes_)) flush_crc();
+		}
+		void flush_crc() {
+			crc_generator_->add(pending_crc_bytes_, pending_crc_byte_count_);
+			pending_crc_byte_count_ = 0;
+		}
 };
 
 }
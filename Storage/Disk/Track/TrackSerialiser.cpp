@@ -9,11 +9,12 @@
 #include "TrackSerialiser.hpp"
 
 #include <memory>
+#include <vector>
 
 // TODO: if this is a PCMTrack with only one segment and that segment's bit rate is within tolerance,
 // just return a copy of that segment.
 Storage::Disk::PCMSegment Storage::Disk::track_serialisation(const Track &track, Time length_of_a_bit) {
-	unsigned int history_size = 16;
+	const std::size_t history_size = 16;
 	DigitalPhaseLockedLoop pll(100, history_size);
 	std::unique_ptr<Track> track_copy(track.clone());
 
@@ -21,9 +22,14 @@ Storage::Disk::PCMSegment Storage::Disk::track_serialisation(const Track &track,
 	// its PCMSegment.
 	struct ResultAccumulator: public DigitalPhaseLockedLoop::Delegate {
 		PCMSegment result;
-		void digital_phase_locked_loop_output_bit(int value) {
+		void digital_phase_locked_loop_output_bit(int value) override {
 			result.data.push_back(!!value);
 		}
+		void digital_phase_locked_loop_output_bits(uint64_t bits, int count) override {
+			while(count--) {
+				result.data.push_back((bits >> count) & 1);
+			}
+		}
 	} result_accumulator;
 	result_accumulator.result.length_of_a_bit = length_of_a_bit;
 
@@ -33,10 +39,10 @@ Storage::Disk::PCMSegment Storage::Disk::track_serialisation(const Track &track,
 	Time length_multiplier = Time(100*length_of_a_bit.clock_rate, length_of_a_bit.length);
 	length_multiplier.simplify();
 
-	// start at the index hole
+	// Collect the intervals between events from the index hole until the next, so that
+	// the PLL can be run over them in bulk; the final interval ends at the index hole.
+	std::vector<int> intervals;
 	track_copy->seek_to(Time(0));
-
-	// grab events until the next index hole
 	Time time_error = Time(0);
 	while(true) {
 		Track::Event next_event = track_copy->get_next_event();
@@ -44,21 +50,19 @@ Storage::Disk::PCMSegment Storage::Disk::track_serialisation(const Track &track,
 		Time extended_length = next_event.length * length_multiplier + time_error;
 		time_error.clock_rate = extended_length.clock_rate;
 		time_error.length = extended_length.length % extended_length.clock_rate;
-		pll.run_for(Cycles(static_cast<int>(extended_length.get<int64_t>())));
+		intervals.push_back(static_cast<int>(extended_length.get<int64_t>()));
 
 		if(next_event.type == Track::Event::IndexHole) break;
-		pll.add_pulse();
-
-		// If the PLL is now sufficiently primed, restart, and start recording bits this time.
-		if(history_size) {
-			history_size--;
-			if(!history_size) {
-				track_copy->seek_to(Time(0));
-				time_error.set_zero();
-				pll.set_delegate(&result_accumulator);
-			}
-		}
 	}
 
+	// Prime the PLL with the first few flux transitions, then restart from the index hole and record bits.
+	const std::size_t flux_transitions = intervals.size() - 1;
+	if(flux_transitions < history_size) return result_accumulator.result;
+
+	pll.add_pulses(intervals.data(), history_size);
+	pll.set_delegate(&result_accumulator);
+	pll.add_pulses(intervals.data(), flux_transitions);
+	pll.run_for(Cycles(intervals.back()));
+
 	return result_accumulator.result;
 }
@@ -0,0 +1,76 @@
+//
+//  RawImage.cpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#include "RawImage.hpp"
+
+#include "../../FileHolder.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Storage::MassStorage;
+
+namespace {
+const size_t BlockSize = 512;
+}
+
+RawImage::RawImage(const std::string &file_name) {
+	// Prefer to write changes back to the file; if that isn't possible then map
+	// privately so that the machine can still write, but to memory only.
+	bool is_writeable = true;
+	int file = open(file_name.c_str(), O_RDWR);
+	if(file < 0) {
+		is_writeable = false;
+		file = open(file_name.c_str(), O_RDONLY);
+		if(file < 0) throw Storage::FileHolder::Error::CantOpen;
+	}
+
+	struct stat file_stats;
+	if(fstat(file, &file_stats) < 0) {
+		close(file);
+		throw Storage::FileHolder::Error::CantOpen;
+	}
+
+	size_ = size_t(file_stats.st_size);
+	if(!size_ || size_ % BlockSize) {
+		close(file);
+		throw Error::InvalidFormat;
+	}
+
+	void *const mapping = mmap(nullptr, size_, PROT_READ | PROT_WRITE, is_writeable ? MAP_SHARED : MAP_PRIVATE, file, 0);
+
+	// The mapping holds its own reference to the file.
+	close(file);
+
+	if(mapping == MAP_FAILED) {
+		throw Storage::FileHolder::Error::CantOpen;
+	}
+	contents_ = static_cast<uint8_t *>(mapping);
+}
+
+RawImage::~RawImage() {
+	munmap(contents_, size_);
+}
+
+size_t RawImage::get_block_size() {
+	return BlockSize;
+}
+
+size_t RawImage::get_number_of_blocks() {
+	return size_ / BlockSize;
+}
+
+const uint8_t *RawImage::get_block(size_t address) {
+	return &contents_[address * BlockSize];
+}
+
+void RawImage::set_block(size_t address, const uint8_t *contents) {
+	memcpy(&contents_[address * BlockSize], contents, BlockSize);
+}
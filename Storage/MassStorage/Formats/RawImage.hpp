@@ -0,0 +1,51 @@
+//
+//  RawImage.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef MassStorage_RawImage_hpp
+#define MassStorage_RawImage_hpp
+
+#include "../MassStorageDevice.hpp"
+
+#include <string>
+
+namespace Storage {
+namespace MassStorage {
+
+/*!
+	Provides a @c MassStorageDevice backed by a raw, block-by-block image of an entire
+	device — e.g. a hard disk including its partition map and drivers.
+
+	The image is memory mapped, so blocks are served directly from the file.
+	If the file can be opened only for reading then changes are retained in
+	memory but not written back.
+*/
+class RawImage: public MassStorageDevice {
+	public:
+		/*!
+			Constructs a @c RawImage containing content from the file with name @c file_name.
+
+			@throws Storage::FileHolder::Error::CantOpen if the file cannot be opened or mapped.
+			@throws Error::InvalidFormat if the file is empty or isn't a whole number of blocks in size.
+		*/
+		RawImage(const std::string &file_name);
+		~RawImage();
+
+		// MassStorageDevice overrides.
+		size_t get_block_size() final;
+		size_t get_number_of_blocks() final;
+		const uint8_t *get_block(size_t address) final;
+		void set_block(size_t address, const uint8_t *contents) final;
+
+	private:
+		uint8_t *contents_ = nullptr;
+		size_t size_ = 0;
+};
+
+}
+}
+
+#endif /* MassStorage_RawImage_hpp */
@@ -0,0 +1,60 @@
+//
+//  MassStorageDevice.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef MassStorageDevice_hpp
+#define MassStorageDevice_hpp
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Storage {
+namespace MassStorage {
+
+enum class Error {
+	InvalidFormat = -2
+};
+
+/*!
+	A mass storage device is usually:
+
+		* large;
+		* fixed; and
+		* part of a class with a very wide range of potential storage sizes.
+
+	Within Clock Signal, mass storage devices are those which are addressed as a flat array
+	of fixed-size blocks, without any consideration of physical layout.
+*/
+class MassStorageDevice {
+	public:
+		virtual ~MassStorageDevice() {}
+
+		/*!
+			@returns The size of each individual block, in bytes.
+		*/
+		virtual size_t get_block_size() = 0;
+
+		/*!
+			@returns The total number of blocks on this device.
+		*/
+		virtual size_t get_number_of_blocks() = 0;
+
+		/*!
+			@returns A pointer to the contents of the block at @c address, which remains valid
+			for at least as long as this device exists and until @c set_block is next called.
+		*/
+		virtual const uint8_t *get_block(size_t address) = 0;
+
+		/*!
+			Sets the contents of the block at @c address, copying @c get_block_size() bytes from @c contents.
+		*/
+		virtual void set_block(size_t address, const uint8_t *contents) = 0;
+};
+
+}
+}
+
+#endif /* MassStorageDevice_hpp */
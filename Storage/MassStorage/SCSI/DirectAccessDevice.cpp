@@ -0,0 +1,357 @@
+//
+//  DirectAccessDevice.cpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#include "DirectAccessDevice.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace SCSI;
+
+namespace {
+
+enum Status: uint8_t {
+	Good = 0x00,
+	CheckCondition = 0x02,
+};
+
+enum SenseKey: uint8_t {
+	NoSense = 0x0,
+	NotReady = 0x2,
+	IllegalRequest = 0x5,
+};
+
+enum AdditionalSenseCode: uint8_t {
+	None = 0x00,
+	InvalidCommandOperationCode = 0x20,
+	LogicalBlockAddressOutOfRange = 0x21,
+};
+
+/// @returns The total length of a command descriptor block that begins with @c opcode.
+size_t command_length(uint8_t opcode) {
+	switch(opcode >> 5) {
+		case 1: case 2:	return 10;
+		case 5:			return 12;
+		default:		return 6;
+	}
+}
+
+}
+
+DirectAccessDevice::DirectAccessDevice(Bus &bus, int scsi_id) :
+	bus_(bus),
+	scsi_bus_device_id_(bus.add_device()),
+	scsi_id_mask_(BusState(1 << scsi_id)) {
+	bus.add_observer(this);
+}
+
+void DirectAccessDevice::set_storage(const std::shared_ptr<Storage::MassStorage::MassStorageDevice> &device) {
+	storage_ = device;
+	block_buffer_.resize(std::max(size_t(256), storage_ ? storage_->get_block_size() : 0));
+}
+
+// MARK: - Bus phases.
+
+void DirectAccessDevice::scsi_bus_did_change(Bus *, BusState new_state) {
+	if(new_state & Line::Reset) {
+		release();
+		return;
+	}
+
+	switch(state_) {
+		case State::Inactive:
+			// Respond to selection only if there's some storage to offer.
+			if(
+				storage_ &&
+				(new_state & (Line::SelectTarget | Line::Busy | scsi_id_mask_)) == (Line::SelectTarget | scsi_id_mask_)
+			) {
+				state_ = State::Selected;
+				set_output(Line::Busy);
+			}
+		break;
+
+		case State::Selected:
+			// Once the initiator releases SEL, proceed to the message phase if it
+			// has asserted ATN, or directly to the command otherwise.
+			if(!(new_state & Line::SelectTarget)) {
+				state_ = State::Transferring;
+				if(new_state & Line::Attention) {
+					receive_message();
+				} else {
+					receive_command();
+				}
+			}
+		break;
+
+		case State::Transferring:
+			switch(handshake_) {
+				case Handshake::AwaitingAcknowledge:
+					if(new_state & Line::Acknowledge) {
+						if(incoming_) {
+							*incoming_ = uint8_t(new_state & Line::Data);
+							++incoming_;
+						} else {
+							++outgoing_;
+						}
+						--transfer_length_;
+
+						handshake_ = Handshake::AwaitingRelease;
+						set_output(Line::Busy | phase_);
+					}
+				break;
+
+				case Handshake::AwaitingRelease:
+					if(!(new_state & Line::Acknowledge)) {
+						if(transfer_length_) {
+							request_next_byte();
+						} else {
+							// Move the continuation out of the way first, as it'll
+							// likely install a new one.
+							std::function<void()> continuation;
+							std::swap(continuation, continuation_);
+							continuation();
+						}
+					}
+				break;
+			}
+		break;
+	}
+}
+
+void DirectAccessDevice::set_output(BusState output) {
+	bus_.set_device_output(scsi_bus_device_id_, output);
+}
+
+void DirectAccessDevice::send(BusState phase, const uint8_t *data, size_t length, std::function<void()> continuation) {
+	phase_ = phase;
+	outgoing_ = data;
+	incoming_ = nullptr;
+	transfer_length_ = length;
+	continuation_ = std::move(continuation);
+
+	if(length) {
+		request_next_byte();
+	} else {
+		std::function<void()> next;
+		std::swap(next, continuation_);
+		next();
+	}
+}
+
+void DirectAccessDevice::receive(BusState phase, uint8_t *data, size_t length, std::function<void()> continuation) {
+	phase_ = phase;
+	outgoing_ = nullptr;
+	incoming_ = data;
+	transfer_length_ = length;
+	continuation_ = std::move(continuation);
+
+	if(length) {
+		request_next_byte();
+	} else {
+		std::function<void()> next;
+		std::swap(next, continuation_);
+		next();
+	}
+}
+
+void DirectAccessDevice::request_next_byte() {
+	handshake_ = Handshake::AwaitingAcknowledge;
+	set_output(Line::Busy | Line::Request | phase_ | (outgoing_ ? *outgoing_ : 0));
+}
+
+void DirectAccessDevice::release() {
+	state_ = State::Inactive;
+	continuation_ = nullptr;
+	set_output(DefaultBusState);
+}
+
+// MARK: - Commands.
+
+void DirectAccessDevice::receive_message() {
+	receive(Phase::MessageOut, &message_, 1, [this] {
+		// Only IDENTIFY messages are expected; take any further messages
+		// for as long as the initiator continues to assert ATN.
+		if(bus_.get_state() & Line::Attention) {
+			receive_message();
+		} else {
+			receive_command();
+		}
+	});
+}
+
+void DirectAccessDevice::receive_command() {
+	receive(Phase::Command, command_, 1, [this] {
+		receive(Phase::Command, &command_[1], command_length(command_[0]) - 1, [this] {
+			perform_command();
+		});
+	});
+}
+
+void DirectAccessDevice::perform_command() {
+	const size_t block_size = storage_->get_block_size();
+	const size_t number_of_blocks = storage_->get_number_of_blocks();
+
+	switch(command_[0]) {
+		default:
+			fail(SenseKey::IllegalRequest, AdditionalSenseCode::InvalidCommandOperationCode);
+		break;
+
+		case 0x00:	// TEST UNIT READY.
+		case 0x04:	// FORMAT UNIT.
+		case 0x1b:	// START/STOP UNIT.
+		case 0x1e:	// PREVENT/ALLOW MEDIUM REMOVAL.
+			complete(Status::Good);
+		break;
+
+		case 0x03: {	// REQUEST SENSE.
+			memset(response_, 0, 18);
+			response_[0] = 0x70;
+			response_[2] = sense_key_;
+			response_[7] = 10;
+			response_[12] = additional_sense_code_;
+			sense_key_ = SenseKey::NoSense;
+			additional_sense_code_ = AdditionalSenseCode::None;
+
+			// SCSI-1 hosts may use an allocation length of 0 to request four bytes.
+			send_response(18, command_[4] ? command_[4] : 4);
+		} break;
+
+		case 0x08:	// READ (6).
+		case 0x0a:	// WRITE (6).
+			block_address_ = size_t(((command_[1] & 0x1f) << 16) | (command_[2] << 8) | command_[3]);
+			block_count_ = command_[4] ? command_[4] : 256;
+
+			if(check_range(block_address_, block_count_)) {
+				if(command_[0] == 0x08) read_blocks(); else write_blocks();
+			}
+		break;
+
+		case 0x28:	// READ (10).
+		case 0x2a:	// WRITE (10).
+		case 0x2f:	// VERIFY (10).
+			block_address_ = size_t((command_[2] << 24) | (command_[3] << 16) | (command_[4] << 8) | command_[5]);
+			block_count_ = size_t((command_[7] << 8) | command_[8]);
+
+			if(check_range(block_address_, block_count_)) {
+				switch(command_[0]) {
+					case 0x28:	read_blocks();				break;
+					case 0x2a:	write_blocks();				break;
+					default:	complete(Status::Good);		break;
+				}
+			}
+		break;
+
+		case 0x12: {	// INQUIRY.
+			memset(response_, ' ', 36);
+			response_[0] = 0x00;	// Direct-access device.
+			response_[1] = 0x00;	// Not removable.
+			response_[2] = 0x01;	// SCSI-1.
+			response_[3] = 0x01;	// CCS response format.
+			response_[4] = 31;		// Additional length.
+			response_[5] = response_[6] = response_[7] = 0x00;
+			memcpy(&response_[8], "CLKSGNL", 7);
+			memcpy(&response_[16], "Hard Disk", 9);
+			memcpy(&response_[32], "1.0", 3);
+
+			send_response(36, command_[4]);
+		} break;
+
+		case 0x15:	// MODE SELECT (6); parameters are accepted but ignored.
+			receive(Phase::DataOut, block_buffer_.data(), command_[4], [this] {
+				complete(Status::Good);
+			});
+		break;
+
+		case 0x1a: {	// MODE SENSE (6); a header plus a single block descriptor is offered.
+			const size_t reported_blocks = std::min(number_of_blocks, size_t(0xffffff));
+			memset(response_, 0, 12);
+			response_[0] = 11;		// Mode data length.
+			response_[3] = 8;		// Block descriptor length.
+			response_[5] = uint8_t(reported_blocks >> 16);
+			response_[6] = uint8_t(reported_blocks >> 8);
+			response_[7] = uint8_t(reported_blocks);
+			response_[9] = uint8_t(block_size >> 16);
+			response_[10] = uint8_t(block_size >> 8);
+			response_[11] = uint8_t(block_size);
+
+			send_response(12, command_[4]);
+		} break;
+
+		case 0x25: {	// READ CAPACITY.
+			const size_t last_block = number_of_blocks - 1;
+			response_[0] = uint8_t(last_block >> 24);
+			response_[1] = uint8_t(last_block >> 16);
+			response_[2] = uint8_t(last_block >> 8);
+			response_[3] = uint8_t(last_block);
+			response_[4] = uint8_t(block_size >> 24);
+			response_[5] = uint8_t(block_size >> 16);
+			response_[6] = uint8_t(block_size >> 8);
+			response_[7] = uint8_t(block_size);
+
+			send_response(8, 8);
+		} break;
+	}
+}
+
+void DirectAccessDevice::send_response(size_t length, size_t allocation_length) {
+	send(Phase::DataIn, response_, std::min(length, allocation_length), [this] {
+		complete(Status::Good);
+	});
+}
+
+bool DirectAccessDevice::check_range(size_t address, size_t count) {
+	if(address + count > storage_->get_number_of_blocks()) {
+		fail(SenseKey::IllegalRequest, AdditionalSenseCode::LogicalBlockAddressOutOfRange);
+		return false;
+	}
+	return true;
+}
+
+void DirectAccessDevice::read_blocks() {
+	if(!block_count_) {
+		complete(Status::Good);
+		return;
+	}
+
+	// Blocks are sent directly from storage, one at a time.
+	const uint8_t *const block = storage_->get_block(block_address_);
+	++block_address_;
+	--block_count_;
+	send(Phase::DataIn, block, storage_->get_block_size(), [this] {
+		read_blocks();
+	});
+}
+
+void DirectAccessDevice::write_blocks() {
+	if(!block_count_) {
+		complete(Status::Good);
+		return;
+	}
+
+	receive(Phase::DataOut, block_buffer_.data(), storage_->get_block_size(), [this] {
+		storage_->set_block(block_address_, block_buffer_.data());
+		++block_address_;
+		--block_count_;
+		write_blocks();
+	});
+}
+
+void DirectAccessDevice::fail(uint8_t sense_key, uint8_t additional_sense_code) {
+	sense_key_ = sense_key;
+	additional_sense_code_ = additional_sense_code;
+	complete(Status::CheckCondition);
+}
+
+void DirectAccessDevice::complete(uint8_t status) {
+	status_ = status;
+	send(Phase::Status, &status_, 1, [this] {
+		completion_message_ = 0x00;	// COMMAND COMPLETE.
+		send(Phase::MessageIn, &completion_message_, 1, [this] {
+			release();
+		});
+	});
+}
@@ -0,0 +1,95 @@
+//
+//  DirectAccessDevice.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef SCSI_DirectAccessDevice_hpp
+#define SCSI_DirectAccessDevice_hpp
+
+#include "SCSI.hpp"
+#include "../MassStorageDevice.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace SCSI {
+
+/*!
+	Implements a SCSI target that presents a @c MassStorageDevice as a direct-access
+	device — i.e. a hard disk — implementing the commands that a typical host will use
+	to identify, boot from and otherwise use such a device.
+
+	Bus phases are entered and handshakes answered immediately, so transfers proceed
+	exactly as quickly as the initiator is able to request bytes.
+*/
+class DirectAccessDevice: public Bus::Observer {
+	public:
+		/*!
+			Attaches a new device to @c bus, which will respond to selection as @c scsi_id.
+		*/
+		DirectAccessDevice(Bus &bus, int scsi_id);
+
+		/*!
+			Supplies the storage that this device will present; until storage is provided
+			the device will not respond to selection.
+		*/
+		void set_storage(const std::shared_ptr<Storage::MassStorage::MassStorageDevice> &device);
+
+	private:
+		void scsi_bus_did_change(Bus *, BusState new_state) final;
+
+		// Bus phase management.
+		void set_output(BusState output);
+		void send(BusState phase, const uint8_t *data, size_t length, std::function<void()> continuation);
+		void receive(BusState phase, uint8_t *data, size_t length, std::function<void()> continuation);
+		void request_next_byte();
+		void release();
+
+		// Command processing.
+		void receive_message();
+		void receive_command();
+		void perform_command();
+		void complete(uint8_t status);
+		void fail(uint8_t sense_key, uint8_t additional_sense_code);
+		void send_response(size_t length, size_t allocation_length);
+		bool check_range(size_t address, size_t count);
+		void read_blocks();
+		void write_blocks();
+
+		Bus &bus_;
+		const size_t scsi_bus_device_id_;
+		const BusState scsi_id_mask_;
+		std::shared_ptr<Storage::MassStorage::MassStorageDevice> storage_;
+
+		enum class State {
+			Inactive, Selected, Transferring
+		} state_ = State::Inactive;
+
+		// The transfer currently in progress.
+		enum class Handshake {
+			AwaitingAcknowledge, AwaitingRelease
+		} handshake_ = Handshake::AwaitingAcknowledge;
+		BusState phase_ = DefaultBusState;
+		const uint8_t *outgoing_ = nullptr;
+		uint8_t *incoming_ = nullptr;
+		size_t transfer_length_ = 0;
+		std::function<void()> continuation_;
+
+		// Current command and its progress.
+		uint8_t message_ = 0;
+		uint8_t command_[12];
+		size_t block_address_ = 0, block_count_ = 0;
+		uint8_t status_ = 0, completion_message_ = 0;
+		uint8_t response_[36];
+		std::vector<uint8_t> block_buffer_;
+
+		// Sense data for the most recent command to have failed.
+		uint8_t sense_key_ = 0, additional_sense_code_ = 0;
+};
+
+}
+
+#endif /* SCSI_DirectAccessDevice_hpp */
@@ -0,0 +1,47 @@
+//
+//  SCSI.cpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#include "SCSI.hpp"
+
+using namespace SCSI;
+
+size_t Bus::add_device() {
+	const auto slot = device_states_.size();
+	device_states_.push_back(DefaultBusState);
+	return slot;
+}
+
+void Bus::add_observer(Observer *observer) {
+	observers_.push_back(observer);
+}
+
+void Bus::set_device_output(size_t device, BusState output) {
+	if(device_states_[device] == output) return;
+	device_states_[device] = output;
+
+	const auto previous_state = state_;
+	state_ = DefaultBusState;
+	for(const auto state: device_states_) {
+		state_ |= state;
+	}
+	if(state_ == previous_state) return;
+
+	// If this change was made by an observer in response to an earlier change,
+	// leave the outer loop below to announce it once every observer has heard
+	// about the earlier one.
+	if(is_dispatching_) return;
+
+	is_dispatching_ = true;
+	BusState dispatched_state;
+	do {
+		dispatched_state = state_;
+		for(auto observer: observers_) {
+			observer->scsi_bus_did_change(this, dispatched_state);
+		}
+	} while(state_ != dispatched_state);
+	is_dispatching_ = false;
+}
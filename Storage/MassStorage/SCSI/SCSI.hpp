@@ -0,0 +1,113 @@
+//
+//  SCSI.hpp
+//  Clock Signal
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef SCSI_hpp
+#define SCSI_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SCSI {
+
+typedef int BusState;
+
+static const BusState DefaultBusState = 0;
+
+/*!
+	SCSI bus state is encoded entirely within an int.
+	Bits correlate as indicated below; each is set if that line is asserted.
+	The real bus is active low; these are logical rather than electrical values.
+*/
+enum Line: BusState {
+	/// Provides the value currently on the data lines.
+	Data			= 0xff,
+	/// Parity of the data lines.
+	Parity			= 1 << 8,
+	/// Set if the SEL line is currently asserted.
+	SelectTarget	= 1 << 9,
+	/// Set if the ATN line is currently asserted.
+	Attention		= 1 << 10,
+	/// Set if the C/D line is currently asserted.
+	Control			= 1 << 11,
+	/// Set if the BSY line is currently asserted.
+	Busy			= 1 << 12,
+	/// Set if the ACK line is currently asserted.
+	Acknowledge		= 1 << 13,
+	/// Set if the RST line is currently asserted.
+	Reset			= 1 << 14,
+	/// Set if the I/O line is currently asserted.
+	Input			= 1 << 15,
+	/// Set if the MSG line is currently asserted.
+	Message			= 1 << 16,
+	/// Set if the REQ line is currently asserted.
+	Request			= 1 << 17,
+};
+
+/*!
+	Provides the mask of lines that identifies the current bus phase, and the value
+	they'll hold in each phase.
+*/
+namespace Phase {
+	static const BusState Mask			= Line::Message | Line::Control | Line::Input;
+
+	static const BusState DataOut		= 0;
+	static const BusState DataIn		= Line::Input;
+	static const BusState Command		= Line::Control;
+	static const BusState Status		= Line::Control | Line::Input;
+	static const BusState MessageOut	= Line::Message | Line::Control;
+	static const BusState MessageIn		= Line::Message | Line::Control | Line::Input;
+}
+
+/*!
+	Models a SCSI bus as the wired OR of the outputs of all attached devices.
+
+	No attempt is made to model bus timing; devices react to changes as soon as they're
+	posted, which is enough for handshaked transfers to proceed at whatever speed the
+	initiator can manage.
+*/
+class Bus {
+	public:
+		/*!
+			Adds a device to the bus, returning the index it should use
+			to refer to itself in subsequent calls to set_device_output.
+		*/
+		size_t add_device();
+
+		/*!
+			Sets the current output for @c device.
+		*/
+		void set_device_output(size_t device, BusState output);
+
+		/*!
+			@returns the current state of the bus.
+		*/
+		BusState get_state() const {
+			return state_;
+		}
+
+		struct Observer {
+			/// Announces that the bus is now in @c new_state. Observers may themselves change their
+			/// outputs from within this call; observers will then be informed of the further change
+			/// after all have been informed of this one.
+			virtual void scsi_bus_did_change(Bus *, BusState new_state) = 0;
+		};
+		/*!
+			Adds an observer.
+		*/
+		void add_observer(Observer *);
+
+	private:
+		std::vector<BusState> device_states_;
+		std::vector<Observer *> observers_;
+		BusState state_ = DefaultBusState;
+		bool is_dispatching_ = false;
+};
+
+}
+
+#endif /* SCSI_hpp */